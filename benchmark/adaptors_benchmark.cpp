@@ -0,0 +1,1267 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/*
+ * A table-driven benchmark of flux's adaptors and algorithms against
+ * hand-written loops and the standard library.
+ *
+ * Each numeric case is run for every element type and input size, and
+ * each text case for every input size. Every run is reported in a table
+ * of its own, in nanoseconds per input element, relative to the first
+ * implementation listed. The complete results can also be written out as
+ * JSON or CSV to compare compilers and commits:
+ *
+ *     benchmark-adaptors [--json FILE] [--csv FILE] [--sizes N,N,...] [FILTER]
+ *
+ * Only cases whose titles (for example "zip/int32/1000") contain FILTER are
+ * run. Where the standard library provides a view only from C++23, its
+ * implementation is only run if the view is available.
+ */
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include "ranges_concat.hpp"
+
+#if __cpp_lib_ranges_cartesian_product >= 202207L
+#include <ranges>
+#else
+#include "ranges_cartesian_product.hpp"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+namespace rv = std::views;
+
+namespace {
+
+template <typename T>
+using case_fn = void (*)(an::Bench&, std::vector<T> const&);
+
+// The element types of the numeric cases
+template <typename T>
+constexpr char const* type_name = nullptr;
+template <>
+constexpr char const* type_name<std::int32_t> = "int32";
+template <>
+constexpr char const* type_name<std::int64_t> = "int64";
+template <>
+constexpr char const* type_name<double> = "double";
+
+// A case run on vectors of each element type. The function is a
+// captureless generic lambda, which is instantiated for each type.
+struct numeric_case {
+    char const* name;
+    case_fn<std::int32_t> int32_fn;
+    case_fn<std::int64_t> int64_fn;
+    case_fn<double> double_fn;
+
+    template <typename Fn, typename T>
+    static auto call(an::Bench& bench, std::vector<T> const& input) -> void
+    {
+        Fn{}(bench, input);
+    }
+
+    template <typename Fn>
+    numeric_case(char const* n, Fn)
+        : name(n),
+          int32_fn(&call<Fn, std::int32_t>),
+          int64_fn(&call<Fn, std::int64_t>),
+          double_fn(&call<Fn, double>)
+    {}
+
+    template <typename T>
+    auto get() const -> case_fn<T>
+    {
+        if constexpr (std::same_as<T, std::int32_t>) {
+            return int32_fn;
+        } else if constexpr (std::same_as<T, std::int64_t>) {
+            return int64_fn;
+        } else {
+            return double_fn;
+        }
+    }
+};
+
+// A case run on a string of space-separated words
+struct text_case {
+    char const* name;
+    void (*fn)(an::Bench&, std::string const&);
+};
+
+// Values are kept small, so that sums and the like fit in an int32 for
+// every input size
+template <typename T>
+auto make_input(std::size_t n) -> std::vector<T>
+{
+    std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> dist{0, 99};
+    std::vector<T> vec(n);
+    std::ranges::generate(vec, [&] { return static_cast<T>(dist(gen)); });
+    return vec;
+}
+
+auto make_text(std::size_t n) -> std::string
+{
+    std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> word_len{1, 10};
+    std::string str;
+    str.reserve(n);
+    while (str.size() < n) {
+        str.append(static_cast<std::size_t>(word_len(gen)), 'x');
+        str.push_back(' ');
+    }
+    str.resize(n);
+    return str;
+}
+
+template <typename T>
+auto sorted(std::vector<T> vec) -> std::vector<T>
+{
+    std::ranges::sort(vec);
+    return vec;
+}
+
+// flux's orderings must be at least weak, so doubles are compared assuming
+// that there are no NaNs
+template <typename T>
+using ordering = std::conditional_t<
+    std::floating_point<T>,
+    std::remove_const_t<decltype(flux::cmp::compare_floating_point_unchecked)>,
+    std::compare_three_way>;
+
+constexpr auto is_small = [](auto x) { return x < decltype(x)(50); };
+constexpr auto twice = [](auto x) { return x + x; };
+
+std::vector<numeric_case> const numeric_cases = {
+    // Adaptors
+
+    {"adjacent_filter", [](an::Bench& b, auto const& in) {
+        b.run("handwritten", [&] {
+            std::size_t count = in.empty() ? 0 : 1;
+            for (std::size_t i = 1; i < in.size(); i++) {
+                count += in[i - 1] != in[i];
+            }
+            an::doNotOptimizeAway(count);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).dedup().count());
+        });
+    }},
+
+    {"cartesian_power", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // A base of about sqrt(n) elements, giving about n pairs
+        std::vector<T> const base(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(
+            std::sqrt(static_cast<double>(in.size()))));
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : base) {
+                for (T y : base) { sum += x + y; }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (auto [x, y] : rv::cartesian_product(base, base)) { sum += x + y; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(
+                flux::cartesian_power_map<2>(flux::ref(base), std::plus<>{}).sum());
+        });
+    }},
+
+    {"cartesian_product", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const m = static_cast<std::ptrdiff_t>(std::sqrt(static_cast<double>(in.size())));
+        std::vector<T> const xs(in.begin(), in.begin() + m);
+        std::vector<T> const ys(in.end() - m, in.end());
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : xs) {
+                for (T y : ys) { sum += x + y; }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (auto [x, y] : rv::cartesian_product(xs, ys)) { sum += x + y; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            T sum{};
+            flux::for_each(flux::cartesian_product(flux::ref(xs), flux::ref(ys)),
+                           flux::unpack([&](T x, T y) { sum += x + y; }));
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux_map", [&] {
+            an::doNotOptimizeAway(
+                flux::cartesian_product_map(std::plus<>{}, flux::ref(xs), flux::ref(ys)).sum());
+        });
+    }},
+
+    {"chain", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const mid = in.begin() + static_cast<std::ptrdiff_t>(in.size() / 2);
+        std::vector<T> const front(in.begin(), mid);
+        std::vector<T> const back(mid, in.end());
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : front) { sum += x; }
+            for (T x : back) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : rv::concat(front, back)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::chain(flux::ref(front), flux::ref(back)).sum());
+        });
+    }},
+
+    {"chunk", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // The sum of the largest element of each chunk of 16
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 0; i < in.size(); i += 16) {
+                auto const end = (std::min)(i + 16, in.size());
+                T max = in[i];
+                for (std::size_t j = i + 1; j < end; j++) { max = (std::max)(max, in[j]); }
+                sum += max;
+            }
+            an::doNotOptimizeAway(sum);
+        });
+#if __cpp_lib_ranges_chunk >= 202202L
+        b.run("std", [&] {
+            T sum{};
+            for (auto chunk : in | rv::chunk(16)) { sum += std::ranges::max(chunk); }
+            an::doNotOptimizeAway(sum);
+        });
+#endif
+        b.run("flux", [&] {
+            T sum{};
+            flux::for_each(flux::ref(in).chunk(16), [&](auto chunk) {
+                sum += flux::max(chunk, ordering<T>{}).value();
+            });
+            an::doNotOptimizeAway(sum);
+        });
+    }},
+
+    {"chunk_by", [](an::Bench& b, auto const& in) {
+        // The number of non-descending runs
+        b.run("handwritten", [&] {
+            std::size_t count = in.empty() ? 0 : 1;
+            for (std::size_t i = 1; i < in.size(); i++) {
+                count += in[i] < in[i - 1];
+            }
+            an::doNotOptimizeAway(count);
+        });
+#if __cpp_lib_ranges_chunk_by >= 202202L
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::distance(in | rv::chunk_by(std::less_equal{})));
+        });
+#endif
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).chunk_by(std::less_equal{}).count());
+        });
+    }},
+
+    {"cycle", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // A quarter of the input, four times over
+        std::vector<T> const quarter(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(in.size() / 4));
+        b.run("handwritten", [&] {
+            T sum{};
+            for (int i = 0; i < 4; i++) {
+                for (T x : quarter) { sum += x; }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : rv::iota(0, 4) | rv::transform([&](int) -> auto& { return quarter; })
+                           | rv::join) {
+                sum += x;
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(quarter).cycle(4).sum());
+        });
+    }},
+
+    {"distinct", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            std::unordered_set<T> seen;
+            std::size_t count = 0;
+            for (T x : in) { count += seen.insert(x).second; }
+            an::doNotOptimizeAway(count);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::distinct(flux::ref(in)).count());
+        });
+        b.run("flux_approx", [&] {
+            an::doNotOptimizeAway(flux::approx_distinct(flux::ref(in), 100).count());
+        });
+    }},
+
+    {"drop", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const n = in.size() / 2;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = n; i < in.size(); i++) { sum += in[i]; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::drop(n)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).drop(n).sum());
+        });
+    }},
+
+    {"drop_while", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // Nothing is dropped, but the predicate is tested once
+        auto const pred = [](T x) { return x < T(0); };
+        b.run("handwritten", [&] {
+            T sum{};
+            auto it = in.begin();
+            while (it != in.end() && pred(*it)) { ++it; }
+            for (; it != in.end(); ++it) { sum += *it; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::drop_while(pred)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).drop_while(pred).sum());
+        });
+    }},
+
+    {"filter", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : in) {
+                if (is_small(x)) { sum += x; }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::filter(is_small)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).filter(is_small).sum());
+        });
+    }},
+
+    {"filter_map", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : in) {
+                if (is_small(x)) { sum += twice(x); }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::filter(is_small) | rv::transform(twice)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).filter_map([](T x) {
+                return is_small(x) ? flux::optional<T>(twice(x)) : flux::nullopt;
+            }).sum());
+        });
+    }},
+
+    {"flatten", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // The input split into rows of 16
+        std::vector<std::vector<T>> rows;
+        for (std::size_t i = 0; i < in.size(); i += 16) {
+            rows.emplace_back(in.begin() + static_cast<std::ptrdiff_t>(i),
+                              in.begin() + static_cast<std::ptrdiff_t>((std::min)(i + 16, in.size())));
+        }
+        b.run("handwritten", [&] {
+            T sum{};
+            for (auto const& row : rows) {
+                for (T x : row) { sum += x; }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : rows | rv::join) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(rows).flatten().sum());
+        });
+    }},
+
+    {"flatten_with", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<std::vector<T>> rows;
+        for (std::size_t i = 0; i < in.size(); i += 16) {
+            rows.emplace_back(in.begin() + static_cast<std::ptrdiff_t>(i),
+                              in.begin() + static_cast<std::ptrdiff_t>((std::min)(i + 16, in.size())));
+        }
+        b.run("handwritten", [&] {
+            T sum{};
+            bool first = true;
+            for (auto const& row : rows) {
+                if (!first) { sum += T(1); }
+                first = false;
+                for (T x : row) { sum += x; }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+#if __cpp_lib_ranges_join_with >= 202202L
+        b.run("std", [&] {
+            T sum{};
+            for (T x : rows | rv::join_with(T(1))) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+#endif
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(rows).flatten_with(T(1)).sum());
+        });
+    }},
+
+    {"map", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : in) { sum += twice(x); }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::transform(twice)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).map(twice).sum());
+        });
+    }},
+
+    {"mask", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<char> bits;
+        for (T x : in) { bits.push_back(is_small(x)); }
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 0; i < in.size(); i++) {
+                if (bits[i]) { sum += in[i]; }
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::mask(flux::ref(in), flux::ref(bits)).sum());
+        });
+    }},
+
+    {"merge", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const mid = in.begin() + static_cast<std::ptrdiff_t>(in.size() / 2);
+        auto const xs = sorted(std::vector<T>(in.begin(), mid));
+        auto const ys = sorted(std::vector<T>(mid, in.end()));
+        std::vector<T> out(in.size());
+        b.run("std", [&] {
+            std::ranges::merge(xs, ys, out.begin());
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("flux", [&] {
+            flux::merge_all(std::array{flux::ref(xs), flux::ref(ys)}, ordering<T>{})
+                .output_to(out.begin());
+            an::doNotOptimizeAway(out.data());
+        });
+    }},
+
+    {"pairwise", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 1; i < in.size(); i++) { sum += in[i - 1] + in[i]; }
+            an::doNotOptimizeAway(sum);
+        });
+#if __cpp_lib_ranges_zip >= 202110L
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::pairwise_transform(std::plus<>{})) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+#endif
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).pairwise_map(std::plus<>{}).sum());
+        });
+        b.run("flux_adjacent", [&] {
+            T sum{};
+            flux::for_each(flux::ref(in).template adjacent<2>(),
+                           flux::unpack([&](T x, T y) { sum += x + y; }));
+            an::doNotOptimizeAway(sum);
+        });
+    }},
+
+    {"reverse", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = in.size(); i-- > 0; ) { sum += in[i]; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::reverse) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).reverse().sum());
+        });
+    }},
+
+    {"scan", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<T> out(in.size());
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 0; i < in.size(); i++) {
+                sum += in[i];
+                out[i] = sum;
+            }
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("std", [&] {
+            std::inclusive_scan(in.begin(), in.end(), out.begin());
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("flux", [&] {
+            flux::ref(in).scan(std::plus<>{}).output_to(out.begin());
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("flux_scan_first", [&] {
+            flux::ref(in).scan_first(std::plus<>{}).output_to(out.begin());
+            an::doNotOptimizeAway(out.data());
+        });
+    }},
+
+    {"set_difference", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const mid = in.begin() + static_cast<std::ptrdiff_t>(in.size() / 2);
+        auto const xs = sorted(std::vector<T>(in.begin(), mid));
+        auto const ys = sorted(std::vector<T>(mid, in.end()));
+        std::vector<T> out(in.size());
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::set_difference(xs, ys, out.begin()).out);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(
+                flux::set_difference(flux::ref(xs), flux::ref(ys), ordering<T>{})
+                    .output_to(out.begin()));
+        });
+    }},
+
+    {"set_intersection", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const mid = in.begin() + static_cast<std::ptrdiff_t>(in.size() / 2);
+        auto const xs = sorted(std::vector<T>(in.begin(), mid));
+        auto const ys = sorted(std::vector<T>(mid, in.end()));
+        std::vector<T> out(in.size());
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::set_intersection(xs, ys, out.begin()).out);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(
+                flux::set_intersection(flux::ref(xs), flux::ref(ys), ordering<T>{})
+                    .output_to(out.begin()));
+        });
+    }},
+
+    {"set_symmetric_difference", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const mid = in.begin() + static_cast<std::ptrdiff_t>(in.size() / 2);
+        auto const xs = sorted(std::vector<T>(in.begin(), mid));
+        auto const ys = sorted(std::vector<T>(mid, in.end()));
+        std::vector<T> out(in.size());
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::set_symmetric_difference(xs, ys, out.begin()).out);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(
+                flux::set_symmetric_difference(flux::ref(xs), flux::ref(ys), ordering<T>{})
+                    .output_to(out.begin()));
+        });
+    }},
+
+    {"set_union", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const mid = in.begin() + static_cast<std::ptrdiff_t>(in.size() / 2);
+        auto const xs = sorted(std::vector<T>(in.begin(), mid));
+        auto const ys = sorted(std::vector<T>(mid, in.end()));
+        std::vector<T> out(in.size());
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::set_union(xs, ys, out.begin()).out);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(
+                flux::set_union(flux::ref(xs), flux::ref(ys), ordering<T>{})
+                    .output_to(out.begin()));
+        });
+    }},
+
+    {"slide", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // The sum of the first element of each window of 4
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 0; i + 4 <= in.size(); i++) { sum += in[i]; }
+            an::doNotOptimizeAway(sum);
+        });
+#if __cpp_lib_ranges_slide >= 202202L
+        b.run("std", [&] {
+            T sum{};
+            for (auto win : in | rv::slide(4)) { sum += win.front(); }
+            an::doNotOptimizeAway(sum);
+        });
+#endif
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).slide(4).map([](auto win) {
+                return win.front().value();
+            }).sum());
+        });
+    }},
+
+    {"split", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // Values below 10 act as delimiters
+        auto const is_delim = [](T x) { return x < T(10); };
+        b.run("handwritten", [&] {
+            std::size_t count = 1;
+            for (T x : in) { count += is_delim(x); }
+            an::doNotOptimizeAway(count);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).split(is_delim).count());
+        });
+    }},
+
+    {"stride", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 0; i < in.size(); i += 3) { sum += in[i]; }
+            an::doNotOptimizeAway(sum);
+        });
+#if __cpp_lib_ranges_stride >= 202207L
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::stride(3)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+#endif
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).stride(3).sum());
+        });
+    }},
+
+    {"take", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const n = in.size() / 2;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 0; i < n; i++) { sum += in[i]; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::take(n)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).take(n).sum());
+        });
+    }},
+
+    {"take_while", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // Everything is taken, so the predicate is tested for every element
+        auto const pred = [](T x) { return x < T(100); };
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : in) {
+                if (!pred(x)) { break; }
+                sum += x;
+            }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            for (T x : in | rv::take_while(pred)) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::ref(in).take_while(pred).sum());
+        });
+    }},
+
+    {"zip", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<T> const other(in.rbegin(), in.rend());
+        b.run("handwritten", [&] {
+            T sum{};
+            for (std::size_t i = 0; i < in.size(); i++) { sum += (std::min)(in[i], other[i]); }
+            an::doNotOptimizeAway(sum);
+        });
+#if __cpp_lib_ranges_zip >= 202110L
+        b.run("std", [&] {
+            T sum{};
+            for (auto [x, y] : rv::zip(in, other)) { sum += (std::min)(x, y); }
+            an::doNotOptimizeAway(sum);
+        });
+#endif
+        b.run("flux", [&] {
+            T sum{};
+            flux::for_each(flux::zip(flux::ref(in), flux::ref(other)),
+                           flux::unpack([&](T x, T y) { sum += (std::min)(x, y); }));
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux_zip_map", [&] {
+            an::doNotOptimizeAway(flux::zip_map([](T x, T y) { return (std::min)(x, y); },
+                                                flux::ref(in), flux::ref(other)).sum());
+        });
+    }},
+
+    // Algorithms
+
+    {"all", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const pred = [](T x) { return x >= T(0); };
+        b.run("handwritten", [&] {
+            bool result = true;
+            for (T x : in) {
+                if (!pred(x)) { result = false; break; }
+            }
+            an::doNotOptimizeAway(result);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::all_of(in, pred));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::all(flux::ref(in), pred));
+        });
+    }},
+
+    {"compare", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<T> const other = in;
+        b.run("handwritten", [&] {
+            std::partial_ordering result = std::partial_ordering::equivalent;
+            for (std::size_t i = 0; i < in.size(); i++) {
+                if (auto r = in[i] <=> other[i]; r != 0) { result = r; break; }
+            }
+            an::doNotOptimizeAway(result);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::lexicographical_compare_three_way(
+                in.begin(), in.end(), other.begin(), other.end()));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::compare(flux::ref(in), flux::ref(other)));
+        });
+    }},
+
+    {"contains", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // A value which isn't there, so the whole input is searched
+        T const value(-1);
+        b.run("handwritten", [&] {
+            bool found = false;
+            for (T x : in) {
+                if (x == value) { found = true; break; }
+            }
+            an::doNotOptimizeAway(found);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::find(in, value) != in.end());
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::contains(flux::ref(in), value));
+        });
+    }},
+
+    {"count_if", [](an::Bench& b, auto const& in) {
+        b.run("handwritten", [&] {
+            std::size_t count = 0;
+            for (auto x : in) { count += is_small(x); }
+            an::doNotOptimizeAway(count);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::count_if(in, is_small));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::count_if(flux::ref(in), is_small));
+        });
+    }},
+
+    {"equal", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<T> const other = in;
+        b.run("handwritten", [&] {
+            bool result = in.size() == other.size();
+            for (std::size_t i = 0; result && i < in.size(); i++) { result = in[i] == other[i]; }
+            an::doNotOptimizeAway(result);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::equal(in, other));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::equal(flux::ref(in), flux::ref(other)));
+        });
+    }},
+
+    {"fill", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<T> out(in.size());
+        b.run("handwritten", [&] {
+            for (T& x : out) { x = T(1); }
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("std", [&] {
+            std::ranges::fill(out, T(1));
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("flux", [&] {
+            flux::fill(out, T(1));
+            an::doNotOptimizeAway(out.data());
+        });
+    }},
+
+    {"find_if", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // Nothing matches, so the whole input is searched
+        auto const pred = [](T x) { return x < T(0); };
+        b.run("handwritten", [&] {
+            std::size_t i = 0;
+            while (i < in.size() && !pred(in[i])) { ++i; }
+            an::doNotOptimizeAway(i);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::find_if(in, pred));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::find_if(flux::ref(in), pred));
+        });
+    }},
+
+    {"find_minmax", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            std::size_t min = 0, max = 0;
+            for (std::size_t i = 1; i < in.size(); i++) {
+                if (in[i] < in[min]) { min = i; }
+                if (!(in[i] < in[max])) { max = i; }
+            }
+            an::doNotOptimizeAway(min);
+            an::doNotOptimizeAway(max);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::minmax_element(in));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::find_minmax(flux::ref(in), ordering<T>{}));
+        });
+    }},
+
+    {"fold", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        auto const op = [](T acc, T x) { return (std::max)(acc, x); };
+        b.run("handwritten", [&] {
+            T acc{};
+            for (T x : in) { acc = op(acc, x); }
+            an::doNotOptimizeAway(acc);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::accumulate(in.begin(), in.end(), T{}, op));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::fold(flux::ref(in), op, T{}));
+        });
+    }},
+
+    {"for_each", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : in) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            T sum{};
+            std::ranges::for_each(in, [&](T x) { sum += x; });
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("flux", [&] {
+            T sum{};
+            flux::for_each(flux::ref(in), [&](T x) { sum += x; });
+            an::doNotOptimizeAway(sum);
+        });
+    }},
+
+    {"histogram", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            std::vector<std::uint64_t> counts(12);
+            for (T x : in) {
+                auto const slot = static_cast<std::ptrdiff_t>(x / T(10)) + 1;
+                ++counts[static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(slot, 0, 11))];
+            }
+            an::doNotOptimizeAway(counts.data());
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::histogram(in, flux::bins<T>{T(0), T(100), 10}));
+        });
+    }},
+
+    {"inplace_reverse", [](an::Bench& b, auto const& in) {
+        auto vec = in;
+        b.run("handwritten", [&] {
+            for (std::size_t i = 0, j = vec.size(); i + 1 < j; i++, j--) {
+                std::swap(vec[i], vec[j - 1]);
+            }
+            an::doNotOptimizeAway(vec.data());
+        });
+        b.run("std", [&] {
+            std::ranges::reverse(vec);
+            an::doNotOptimizeAway(vec.data());
+        });
+        b.run("flux", [&] {
+            flux::inplace_reverse(vec);
+            an::doNotOptimizeAway(vec.data());
+        });
+    }},
+
+    {"output_to", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<T> out(in.size());
+        b.run("handwritten", [&] {
+            for (std::size_t i = 0; i < in.size(); i++) { out[i] = in[i]; }
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("std", [&] {
+            std::ranges::copy(in, out.begin());
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("flux", [&] {
+            flux::output_to(flux::ref(in), out.begin());
+            an::doNotOptimizeAway(out.data());
+        });
+    }},
+
+    {"quantiles", [](an::Bench& b, auto const& in) {
+        // The median, exactly by partial sorting and approximately in
+        // bounded memory
+        auto vec = in;
+        b.run("std", [&] {
+            vec = in;
+            auto const mid = vec.begin() + static_cast<std::ptrdiff_t>(vec.size() / 2);
+            std::ranges::nth_element(vec, mid);
+            an::doNotOptimizeAway(*mid);
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::quantiles(flux::ref(in), 0.01).quantile(0.5));
+        });
+    }},
+
+    {"search", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // The last few elements, so that most of the input is searched
+        auto const len = (std::min)(in.size(), std::size_t{8});
+        std::vector<T> const needle(in.end() - static_cast<std::ptrdiff_t>(len), in.end());
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::search(in, needle));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::search(flux::ref(in), flux::ref(needle)));
+        });
+    }},
+
+    {"sort", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // Each implementation sorts a fresh copy of the input
+        auto vec = in;
+        b.run("std", [&] {
+            vec = in;
+            std::ranges::sort(vec);
+            an::doNotOptimizeAway(vec.data());
+        });
+        b.run("flux", [&] {
+            vec = in;
+            flux::sort(vec, ordering<T>{});
+            an::doNotOptimizeAway(vec.data());
+        });
+    }},
+
+    {"starts_with", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        // The whole input, so that every element is compared
+        std::vector<T> const prefix = in;
+        b.run("handwritten", [&] {
+            bool result = prefix.size() <= in.size();
+            for (std::size_t i = 0; result && i < prefix.size(); i++) { result = in[i] == prefix[i]; }
+            an::doNotOptimizeAway(result);
+        });
+#if __cpp_lib_ranges_starts_ends_with >= 202106L
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::ranges::starts_with(in, prefix));
+        });
+#endif
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::starts_with(flux::ref(in), flux::ref(prefix)));
+        });
+    }},
+
+    {"sum", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            T sum{};
+            for (T x : in) { sum += x; }
+            an::doNotOptimizeAway(sum);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::accumulate(in.begin(), in.end(), T{}));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::sum(flux::ref(in)));
+        });
+    }},
+
+    {"swap_elements", [](an::Bench& b, auto const& in) {
+        auto xs = in;
+        auto ys = in;
+        b.run("handwritten", [&] {
+            for (std::size_t i = 0; i < xs.size(); i++) { std::swap(xs[i], ys[i]); }
+            an::doNotOptimizeAway(xs.data());
+        });
+        b.run("std", [&] {
+            std::ranges::swap_ranges(xs, ys);
+            an::doNotOptimizeAway(xs.data());
+        });
+        b.run("flux", [&] {
+            flux::swap_elements(xs, ys);
+            an::doNotOptimizeAway(xs.data());
+        });
+    }},
+
+    {"to", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        b.run("handwritten", [&] {
+            std::vector<T> out;
+            out.reserve(in.size());
+            for (T x : in) { out.push_back(twice(x)); }
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("std", [&] {
+            auto r = in | rv::transform(twice);
+            std::vector<T> out(r.begin(), r.end());
+            an::doNotOptimizeAway(out.data());
+        });
+        b.run("flux", [&] {
+            auto out = flux::ref(in).map(twice).template to<std::vector<T>>();
+            an::doNotOptimizeAway(out.data());
+        });
+    }},
+
+    {"zip_fold", [](an::Bench& b, auto const& in) {
+        using T = std::ranges::range_value_t<decltype(in)>;
+        std::vector<T> const other(in.rbegin(), in.rend());
+        auto const op = [](T acc, T x, T y) { return acc + (std::min)(x, y); };
+        b.run("handwritten", [&] {
+            T acc{};
+            for (std::size_t i = 0; i < in.size(); i++) { acc = op(acc, in[i], other[i]); }
+            an::doNotOptimizeAway(acc);
+        });
+        b.run("std", [&] {
+            an::doNotOptimizeAway(std::inner_product(
+                in.begin(), in.end(), other.begin(), T{}, std::plus<>{},
+                [](T x, T y) { return (std::min)(x, y); }));
+        });
+        b.run("flux", [&] {
+            an::doNotOptimizeAway(flux::zip_fold(op, T{}, flux::ref(in), flux::ref(other)));
+        });
+    }},
+};
+
+std::vector<text_case> const text_cases = {
+    {"split_string", [](an::Bench& b, std::string const& text) {
+        std::string_view const sv = text;
+        b.run("handwritten", [&] {
+            std::size_t count = 0;
+            for (std::size_t pos = 0; pos <= sv.size(); ) {
+                auto const next = (std::min)(sv.find(' ', pos), sv.size());
+                count += next - pos;
+                pos = next + 1;
+            }
+            an::doNotOptimizeAway(count);
+        });
+        b.run("std", [&] {
+            std::size_t count = 0;
+            for (auto word : sv | rv::split(' ')) { count += std::ranges::size(word); }
+            an::doNotOptimizeAway(count);
+        });
+        b.run("flux", [&] {
+            std::size_t count = 0;
+            flux::for_each(flux::split_string(sv, ' '),
+                           [&](std::string_view word) { count += word.size(); });
+            an::doNotOptimizeAway(count);
+        });
+    }},
+};
+
+// Runs each selected case in a fresh Bench, so that each gets a table of
+// its own with the first implementation as the baseline, and collects the
+// results of all of them
+class suite {
+    std::string filter_;
+    std::vector<an::Result> results_;
+
+public:
+    explicit suite(std::string filter) : filter_(std::move(filter)) {}
+
+    template <typename Input, typename Fn>
+    auto run(std::string const& title, Input const& input, Fn fn) -> void
+    {
+        if (title.find(filter_) == std::string::npos) {
+            return;
+        }
+        an::Bench bench;
+        bench.title(title)
+             .unit("element")
+             .batch(input.size())
+             .complexityN(input.size())
+             .relative(true);
+        fn(bench, input);
+        results_.insert(results_.end(), bench.results().begin(), bench.results().end());
+    }
+
+    auto results() const -> std::vector<an::Result> const& { return results_; }
+};
+
+template <typename T>
+auto run_numeric_cases(suite& s, std::vector<std::size_t> const& sizes) -> void
+{
+    for (std::size_t n : sizes) {
+        auto const input = make_input<T>(n);
+        for (numeric_case const& c : numeric_cases) {
+            s.run(std::string(c.name) + "/" + type_name<T> + "/" + std::to_string(n),
+                  input, c.get<T>());
+        }
+    }
+}
+
+auto parse_sizes(std::string_view str) -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> sizes;
+    std::size_t pos = 0;
+    while (pos <= str.size()) {
+        auto const end = (std::min)(str.find(',', pos), str.size());
+        sizes.push_back(std::stoull(std::string(str.substr(pos, end - pos))));
+        pos = end + 1;
+    }
+    return sizes;
+}
+
+auto write_results(char const* path, char const* tmpl, std::vector<an::Result> const& results)
+    -> bool
+{
+    std::ofstream file(path);
+    an::render(tmpl, results, file);
+    if (!file) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    char const* json_path = nullptr;
+    char const* csv_path = nullptr;
+    std::vector<std::size_t> sizes = {1'000, 100'000, 1'000'000};
+    std::string filter;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view const arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--csv" && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            sizes = parse_sizes(argv[++i]);
+        } else if (arg.starts_with("--")) {
+            std::fprintf(stderr,
+                         "usage: %s [--json FILE] [--csv FILE] [--sizes N,N,...] [FILTER]\n",
+                         argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            filter = arg;
+        }
+    }
+
+    suite s(std::move(filter));
+
+    run_numeric_cases<std::int32_t>(s, sizes);
+    run_numeric_cases<std::int64_t>(s, sizes);
+    run_numeric_cases<double>(s, sizes);
+
+    for (std::size_t n : sizes) {
+        auto const text = make_text(n);
+        for (text_case const& c : text_cases) {
+            s.run(std::string(c.name) + "/char/" + std::to_string(n), text, c.fn);
+        }
+    }
+
+    bool ok = true;
+    if (json_path) {
+        ok &= write_results(json_path, an::templates::json(), s.results());
+    }
+    if (csv_path) {
+        ok &= write_results(csv_path, an::templates::csv(), s.results());
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
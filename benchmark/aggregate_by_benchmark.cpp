@@ -0,0 +1,104 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+struct row {
+    int key;
+    double value;
+};
+
+auto make_rows(std::size_t n_rows, int n_groups) -> std::vector<row>
+{
+    std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> keys{0, n_groups - 1};
+    std::uniform_real_distribution<double> values{0.0, 1.0};
+
+    std::vector<row> rows;
+    rows.reserve(n_rows);
+    for (std::size_t i = 0; i < n_rows; i++) {
+        rows.push_back(row{keys(gen), values(gen)});
+    }
+    return rows;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 20;
+    constexpr std::size_t n_rows = 1'000'000;
+
+    for (int n_groups : {16, 1'000, 100'000, 1'000'000}) {
+        auto const rows = make_rows(n_rows, n_groups);
+
+        char title[64];
+        std::snprintf(title, sizeof(title), "sum by key, %d groups", n_groups);
+
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title(title);
+
+        bench.run("std::unordered_map", [&] {
+            std::unordered_map<int, double> totals;
+            for (row const& r : rows) {
+                totals[r.key] += r.value;
+            }
+            an::doNotOptimizeAway(totals.size());
+        });
+
+        bench.run("std::unordered_map (reserved)", [&] {
+            std::unordered_map<int, double> totals;
+            totals.reserve(std::min(rows.size(), std::size_t{4096}));
+            for (row const& r : rows) {
+                totals[r.key] += r.value;
+            }
+            an::doNotOptimizeAway(totals.size());
+        });
+
+        bench.run("flux::aggregate_by", [&] {
+            auto totals = flux::aggregate_by(rows, &row::key, 0.0,
+                [](double acc, row const& r) { return acc + r.value; });
+            an::doNotOptimizeAway(totals.size());
+        });
+    }
+
+    {
+        std::vector<std::string> words;
+        std::mt19937 gen{5678};
+        std::uniform_int_distribution<int> dist{0, 9'999};
+        for (std::size_t i = 0; i < n_rows; i++) {
+            words.push_back("word" + std::to_string(dist(gen)));
+        }
+
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("count by string key, 10000 groups");
+
+        bench.run("std::unordered_map", [&] {
+            std::unordered_map<std::string, int> counts;
+            for (auto const& w : words) {
+                ++counts[w];
+            }
+            an::doNotOptimizeAway(counts.size());
+        });
+
+        bench.run("flux::aggregate_by", [&] {
+            auto counts = flux::aggregate_by(words, std::identity{}, 0,
+                                             [](int n, auto const&) { return n + 1; });
+            an::doNotOptimizeAway(counts.size());
+        });
+    }
+}
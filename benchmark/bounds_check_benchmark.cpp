@@ -0,0 +1,173 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/*
+ * Measures what bounds checking costs in pipelines using internal iteration.
+ *
+ * Each pipeline is run over a hand-written loop, over flux::ref() of the
+ * input, whose reads are bounds checked, and over flux::unchecked() of the
+ * input, whose reads are not. Adaptors which know that their cursors are in
+ * bounds read their bases unchecked during internal iteration, so the
+ * checked and unchecked versions should run at the same speed.
+ *
+ *     benchmark-bounds-checks [ITERATIONS]
+ */
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+constexpr std::size_t input_size = 100'000;
+constexpr std::size_t grid_size = 300;
+
+constexpr auto triple = [](int x) { return 3 * x; };
+
+auto make_input(std::size_t n) -> std::vector<int>
+{
+    std::vector<int> vec(n);
+    std::iota(vec.begin(), vec.end(), 0);
+    for (int& i : vec) {
+        i %= 100;
+    }
+    return vec;
+}
+
+// Runs the checked and unchecked versions of a flux pipeline, passing the
+// function a sequence of each input
+template <typename Loop, typename Pipeline>
+void run(int n_iters, char const* name, std::vector<int> const& a, std::vector<int> const& b,
+         Loop loop, Pipeline pipeline)
+{
+    auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+    bench.title(name);
+    bench.run("loop", [&] { an::doNotOptimizeAway(loop(a, b)); });
+    bench.run("checked", [&] {
+        an::doNotOptimizeAway(pipeline(flux::ref(a), flux::ref(b)));
+    });
+    bench.run("unchecked", [&] {
+        an::doNotOptimizeAway(
+            pipeline(flux::unchecked(flux::ref(a)), flux::unchecked(flux::ref(b))));
+    });
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 100;
+
+    auto const a = make_input(input_size);
+    auto const b = make_input(input_size);
+
+    run(n_iters, "stride(3).map(f).sum()", a, b,
+        [](auto const& a, auto const&) {
+            int sum = 0;
+            for (std::size_t i = 0; i < a.size(); i += 3) {
+                sum += triple(a[i]);
+            }
+            return sum;
+        },
+        [](auto a, auto) { return std::move(a).stride(3).map(triple).sum(); });
+
+    run(n_iters, "zip(a, b).map(mul).sum()", a, b,
+        [](auto const& a, auto const& b) {
+            int sum = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                sum += a[i] * b[i];
+            }
+            return sum;
+        },
+        [](auto a, auto b) {
+            return flux::zip(std::move(a), std::move(b))
+                .map(flux::unpack(std::multiplies{}))
+                .sum();
+        });
+
+    run(n_iters, "pairwise_map(minus).sum()", a, b,
+        [](auto const& a, auto const&) {
+            int sum = 0;
+            for (std::size_t i = 1; i < a.size(); ++i) {
+                sum += a[i] - a[i - 1];
+            }
+            return sum;
+        },
+        [](auto a, auto) { return std::move(a).pairwise_map(std::minus{}).sum(); });
+
+    run(n_iters, "adjacent<3>().map(sum).sum()", a, b,
+        [](auto const& a, auto const&) {
+            int sum = 0;
+            for (std::size_t i = 2; i < a.size(); ++i) {
+                sum += a[i - 2] + a[i - 1] + a[i];
+            }
+            return sum;
+        },
+        [](auto a, auto) {
+            return std::move(a)
+                .template adjacent<3>()
+                .map(flux::unpack([](int x, int y, int z) { return x + y + z; }))
+                .sum();
+        });
+
+    run(n_iters, "reverse().sum()", a, b,
+        [](auto const& a, auto const&) {
+            int sum = 0;
+            for (std::size_t i = a.size(); i > 0; --i) {
+                sum += a[i - 1];
+            }
+            return sum;
+        },
+        [](auto a, auto) { return std::move(a).reverse().sum(); });
+
+    run(n_iters, "cartesian_product_map(mul).sum()", a, b,
+        [](auto const& a, auto const& b) {
+            int sum = 0;
+            for (std::size_t i = 0; i < grid_size; ++i) {
+                for (std::size_t j = 0; j < grid_size; ++j) {
+                    sum += a[i] * b[j];
+                }
+            }
+            return sum;
+        },
+        [](auto a, auto b) {
+            return flux::cartesian_product_map(std::multiplies{}, std::move(a).take(grid_size),
+                                               std::move(b).take(grid_size))
+                .sum();
+        });
+
+    // The windows of chunk() and slide() are slices of the base, whose
+    // elements are read with the base's checks
+    run(n_iters, "chunk(4).map(sum).sum()", a, b,
+        [](auto const& a, auto const&) {
+            int sum = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                sum += a[i];
+            }
+            return sum;
+        },
+        [](auto a, auto) {
+            return std::move(a).chunk(4).map([](auto chunk) { return chunk.sum(); }).sum();
+        });
+
+    run(n_iters, "slide(4).map(sum).sum()", a, b,
+        [](auto const& a, auto const&) {
+            int sum = 0;
+            for (std::size_t i = 3; i < a.size(); ++i) {
+                sum += a[i - 3] + a[i - 2] + a[i - 1] + a[i];
+            }
+            return sum;
+        },
+        [](auto a, auto) {
+            return std::move(a).slide(4).map([](auto win) { return win.sum(); }).sum();
+        });
+}
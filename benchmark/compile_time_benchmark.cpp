@@ -0,0 +1,240 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of including each flux header on its own.
+//
+// Usage: benchmark-compile-time [--runs N] [--csv FILE] [--cxx COMPILER] [FILTER]
+//
+// For every header under include/flux whose path contains FILTER, a
+// translation unit including just that header is compiled, and we report
+//  - the number of lines after preprocessing,
+//  - the wall time to preprocess it (-E),
+//  - the wall time to compile it, and
+//  - the time the compiler spent instantiating templates, as reported by
+//    -ftime-trace with Clang, or -ftime-report with GCC, which doesn't
+//    support -ftime-trace.
+// Times are the minimum over N runs (default 3), in milliseconds.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct measurement {
+    std::string header;
+    long lines = 0;
+    double preprocess_ms = 0;
+    double compile_ms = 0;
+    double instantiate_ms = 0;
+};
+
+struct options {
+    int runs = 3;
+    std::string csv;
+    std::string cxx = FLUX_COMPILE_TIME_CXX;
+    std::string filter;
+};
+
+auto read_file(fs::path const& path) -> std::string
+{
+    std::ifstream file(path);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+// Runs a shell command, returning its wall time in milliseconds, or a
+// negative number if it failed
+auto timed_run(std::string const& cmd) -> double
+{
+    auto const start = std::chrono::steady_clock::now();
+    int const status = std::system(cmd.c_str());
+    auto const end = std::chrono::steady_clock::now();
+    if (status != 0) {
+        return -1.0;
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Sums the durations of the named totals in a Clang -ftime-trace file
+auto clang_instantiation_ms(std::string const& trace) -> double
+{
+    double total_us = 0;
+    for (std::string_view name : {"\"Total InstantiateClass\"",
+                                  "\"Total InstantiateFunction\""}) {
+        auto const pos = trace.find(name);
+        if (pos == std::string::npos) {
+            continue;
+        }
+        auto const event = trace.rfind('{', pos);
+        auto const dur = trace.find("\"dur\":", event);
+        if (event != std::string::npos && dur != std::string::npos && dur < pos + name.size() + 64) {
+            total_us += std::strtod(trace.c_str() + dur + 6, nullptr);
+        }
+    }
+    return total_us / 1000.0;
+}
+
+// Reads the wall time of the "template instantiation" line of a GCC
+// -ftime-report, which looks like
+//   template instantiation    :   0.64 ( 31%)   0.22 ( 24%)   0.83 ( 25%)   52M ( 29%)
+// with the usr, sys and wall times in seconds
+auto gcc_instantiation_ms(std::string const& report) -> double
+{
+    auto const pos = report.find("template instantiation");
+    if (pos == std::string::npos) {
+        return 0.0;
+    }
+    auto const colon = report.find(':', pos);
+    auto const eol = report.find('\n', pos);
+
+    // Drop the percentages in parentheses, leaving usr sys wall GGC
+    std::string fields;
+    bool in_parens = false;
+    for (char c : report.substr(colon + 1, eol - colon - 1)) {
+        if (c == '(') {
+            in_parens = true;
+        } else if (c == ')') {
+            in_parens = false;
+        } else if (!in_parens) {
+            fields += c;
+        }
+    }
+
+    double usr = 0, sys = 0, wall = 0;
+    std::istringstream(fields) >> usr >> sys >> wall;
+    return wall * 1000.0;
+}
+
+auto count_lines(fs::path const& path) -> long
+{
+    std::ifstream file(path);
+    return static_cast<long>(std::count(std::istreambuf_iterator<char>(file),
+                                        std::istreambuf_iterator<char>(), '\n'));
+}
+
+auto parse_args(int argc, char** argv, options& opts) -> bool
+{
+    for (int i = 1; i < argc; i++) {
+        std::string_view const arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc) {
+            opts.runs = std::atoi(argv[++i]);
+        } else if (arg == "--csv" && i + 1 < argc) {
+            opts.csv = argv[++i];
+        } else if (arg == "--cxx" && i + 1 < argc) {
+            opts.cxx = argv[++i];
+        } else if (arg.starts_with("--")) {
+            return false;
+        } else {
+            opts.filter = arg;
+        }
+    }
+    return opts.runs > 0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    options opts;
+    if (!parse_args(argc, argv, opts)) {
+        std::fprintf(stderr, "usage: %s [--runs N] [--csv FILE] [--cxx COMPILER] [FILTER]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    fs::path const include_dir = FLUX_COMPILE_TIME_INCLUDE_DIR;
+    fs::path const work_dir = fs::temp_directory_path() / "flux-compile-time";
+    fs::create_directories(work_dir);
+
+    fs::path const tu = work_dir / "tu.cpp";
+    fs::path const out = work_dir / "tu.o";
+    fs::path const pre = work_dir / "tu.ii";
+    fs::path const report = work_dir / "report.txt";
+    fs::path const trace = work_dir / "tu.json";
+
+    std::system((opts.cxx + " --version > " + report.string()).c_str());
+    bool const is_clang = read_file(report).find("clang") != std::string::npos;
+
+    std::string const base_cmd = opts.cxx + " -std=c++20 -I" + include_dir.string() + " ";
+    std::string const preprocess_cmd = base_cmd + "-E " + tu.string() + " -o " + pre.string();
+    std::string const compile_cmd = is_clang
+        ? base_cmd + "-ftime-trace -c " + tu.string() + " -o " + out.string()
+        : base_cmd + "-ftime-report -c " + tu.string() + " -o " + out.string() +
+              " 2> " + report.string();
+
+    std::vector<fs::path> headers;
+    for (auto const& entry : fs::recursive_directory_iterator(include_dir / "flux")) {
+        if (entry.path().extension() == ".hpp") {
+            auto rel = fs::relative(entry.path(), include_dir);
+            if (rel.generic_string().find(opts.filter) != std::string::npos) {
+                headers.push_back(std::move(rel));
+            }
+        }
+    }
+    std::ranges::sort(headers);
+
+    std::vector<measurement> results;
+    std::printf("%-45s %9s %14s %12s %16s\n", "header", "lines", "preprocess ms",
+                "compile ms", "instantiate ms");
+
+    for (auto const& header : headers) {
+        std::ofstream(tu) << "#include <" << header.generic_string() << ">\n";
+
+        measurement m{.header = header.generic_string()};
+        bool failed = false;
+        for (int i = 0; i < opts.runs && !failed; i++) {
+            double const pre_ms = timed_run(preprocess_cmd);
+            double const compile_ms = timed_run(compile_cmd);
+            if (pre_ms < 0 || compile_ms < 0) {
+                failed = true;
+                break;
+            }
+            double const inst_ms = is_clang ? clang_instantiation_ms(read_file(trace))
+                                            : gcc_instantiation_ms(read_file(report));
+            if (i == 0 || compile_ms < m.compile_ms) {
+                m.compile_ms = compile_ms;
+                m.instantiate_ms = inst_ms;
+            }
+            if (i == 0 || pre_ms < m.preprocess_ms) {
+                m.preprocess_ms = pre_ms;
+            }
+        }
+
+        if (failed) {
+            std::printf("%-45s failed to compile\n", m.header.c_str());
+            continue;
+        }
+
+        m.lines = count_lines(pre);
+        std::printf("%-45s %9ld %14.0f %12.0f %16.0f\n", m.header.c_str(), m.lines,
+                    m.preprocess_ms, m.compile_ms, m.instantiate_ms);
+        results.push_back(std::move(m));
+    }
+
+    fs::remove_all(work_dir);
+
+    if (!opts.csv.empty()) {
+        std::ofstream file(opts.csv);
+        file << "header,lines,preprocess_ms,compile_ms,instantiate_ms\n";
+        for (auto const& m : results) {
+            file << m.header << ',' << m.lines << ',' << m.preprocess_ms << ','
+                 << m.compile_ms << ',' << m.instantiate_ms << '\n';
+        }
+        if (!file) {
+            std::fprintf(stderr, "could not write %s\n", opts.csv.c_str());
+            return 2;
+        }
+    }
+}
@@ -0,0 +1,168 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <memory>
+
+namespace an = ankerl::nanobench;
+
+// GCC < 14 gives a false positive when a coroutine uses a templated
+// promise_type::operator new (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=109224)
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ < 14)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+
+auto ints(int from, int const to) -> flux::generator<int>
+{
+    while (from < to) {
+        co_yield from++;
+    }
+}
+
+// Using std::allocator bypasses the thread-local frame pool, so every
+// coroutine frame comes from global operator new
+auto ints_global_new(std::allocator_arg_t, std::allocator<std::byte>, int from, int const to)
+    -> flux::generator<int>
+{
+    while (from < to) {
+        co_yield from++;
+    }
+}
+
+auto ints_batched(int from, int const to) -> flux::batch_generator<int>
+{
+    while (from < to) {
+        co_yield from++;
+    }
+}
+
+// Fills a local buffer and hands the whole buffer to the consumer at once
+auto ints_batched_spans(int from, int const to) -> flux::batch_generator<int>
+{
+    std::array<int, 1024> buf;
+    while (from < to) {
+        int const n = std::min(int(buf.size()), to - from);
+        for (int i = 0; i < n; i++) {
+            buf[std::size_t(i)] = from + i;
+        }
+        from += n;
+        co_yield flux::slice(buf, 0, n);
+    }
+}
+
+auto countdown_nested(int n) -> flux::generator<int>
+{
+    if (n > 0) {
+        co_yield n;
+        co_yield flux::elements_of(countdown_nested(n - 1));
+    }
+}
+
+auto countdown_reyield(int n) -> flux::generator<int>
+{
+    if (n > 0) {
+        co_yield n;
+        for (int i : countdown_reyield(n - 1)) {
+            co_yield i;
+        }
+    }
+}
+
+auto ints_unfold(int from, int const to)
+{
+    return flux::unfold([](int i) { return i + 1; }, from).take(to - from);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    // Short generators created in a loop, where the cost of creating and
+    // destroying the coroutine frame dominates
+    for (int len : {1, 16, 256}) {
+        int const n_gens = 100'000 / len;
+
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("create + iterate, length " + std::to_string(len));
+
+        bench.run("generator (pooled frames)", [&] {
+            int res = 0;
+            for (int i = 0; i < n_gens; i++) {
+                res += flux::sum(ints(i, i + len));
+            }
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("generator (global new)", [&] {
+            int res = 0;
+            for (int i = 0; i < n_gens; i++) {
+                res += flux::sum(ints_global_new(std::allocator_arg, {}, i, i + len));
+            }
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("unfold", [&] {
+            int res = 0;
+            for (int i = 0; i < n_gens; i++) {
+                res += flux::sum(ints_unfold(i, i + len));
+            }
+            an::doNotOptimizeAway(res);
+        });
+    }
+
+    // Recursive generators, where each level yields one element and then
+    // the elements of the next level
+    for (int depth : {10, 100, 1000}) {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("nested generators, depth " + std::to_string(depth));
+
+        bench.run("elements_of", [&] {
+            int res = flux::sum(countdown_nested(depth));
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("re-yield in loop", [&] {
+            int res = flux::sum(countdown_reyield(depth));
+            an::doNotOptimizeAway(res);
+        });
+    }
+
+    // A single long generator, where the per-element resume cost dominates
+    {
+        int const len = 1'000'000;
+
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("iterate, length 1000000");
+
+        bench.run("generator", [&] {
+            int res = flux::sum(ints(0, len));
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("batch_generator", [&] {
+            int res = flux::sum(ints_batched(0, len));
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("batch_generator (yielding spans)", [&] {
+            int res = flux::sum(ints_batched_spans(0, len));
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("unfold", [&] {
+            int res = flux::sum(ints_unfold(0, len));
+            an::doNotOptimizeAway(res);
+        });
+    }
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+struct build_row {
+    std::uint32_t key;
+    std::uint32_t payload;
+};
+
+auto make_build(std::size_t n, std::uint64_t seed) -> std::vector<build_row>
+{
+    std::mt19937_64 gen(seed);
+    std::vector<build_row> rows;
+    rows.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        rows.push_back({static_cast<std::uint32_t>(gen()),
+                        static_cast<std::uint32_t>(i)});
+    }
+    return rows;
+}
+
+// Roughly half of the probe keys match a build row
+auto make_probe(std::vector<build_row> const& build, std::size_t n, std::uint64_t seed)
+    -> std::vector<std::uint32_t>
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<std::size_t> pick(0, build.size() - 1);
+    std::vector<std::uint32_t> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        keys.push_back(gen() % 2 == 0 ? build[pick(gen)].key
+                                      : static_cast<std::uint32_t>(gen()));
+    }
+    return keys;
+}
+
+void run_join(an::Bench& bench, char const* name, std::size_t n_build, std::size_t n_probe)
+{
+    auto const build = make_build(n_build, 1234);
+    auto const probe = make_probe(build, n_probe, 5678);
+
+    bench.run(std::string("std::unordered_multimap ") + name, [&] {
+        std::unordered_multimap<std::uint32_t, build_row> table;
+        table.reserve(build.size());
+        for (auto const& row : build) {
+            table.emplace(row.key, row);
+        }
+        std::uint64_t sum = 0;
+        for (auto key : probe) {
+            auto [first, last] = table.equal_range(key);
+            for (; first != last; ++first) {
+                sum += first->second.payload;
+            }
+        }
+        an::doNotOptimizeAway(sum);
+    });
+
+    bench.run(std::string("flux::hash_join ") + name, [&] {
+        std::uint64_t sum = 0;
+        flux::hash_join(build, flux::ref(probe), &build_row::key, std::identity{})
+            .for_each([&sum](auto const& p) { sum += p.first.payload; });
+        an::doNotOptimizeAway(sum);
+    });
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_probe = argc > 1 ? std::atoi(argv[1]) : 10'000'000;
+
+    an::Bench bench;
+    bench.relative(true).minEpochIterations(1);
+
+    // The build side fits in cache
+    run_join(bench, "(10k build rows)", 10'000, static_cast<std::size_t>(n_probe));
+
+    // The build side is larger than L2
+    run_join(bench, "(100k build rows)", 100'000, static_cast<std::size_t>(n_probe));
+    run_join(bench, "(4M build rows)", 4'000'000, static_cast<std::size_t>(n_probe));
+}
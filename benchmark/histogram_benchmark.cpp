@@ -0,0 +1,87 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+// Latency-like data: mostly clustered, with a long tail
+auto make_latencies(std::size_t n) -> std::vector<float>
+{
+    std::mt19937 gen{1234};
+    std::lognormal_distribution<float> dist{3.0f, 0.5f};
+    std::vector<float> vec(n);
+    std::ranges::generate(vec, [&] { return dist(gen); });
+    return vec;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 10;
+    constexpr std::size_t n_values = 4'000'000;
+
+    auto const values = make_latencies(n_values);
+    auto const bins = flux::bins{0.0f, 200.0f, 100};
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("histogram of 4M floats, 100 bins");
+
+        // As in example/histogram.cpp
+        bench.run("fold into std::map", [&] {
+            auto hist = flux::fold(flux::ref(values), [](std::map<int, int>&& m, float f) {
+                ++m[static_cast<int>(f / 2.0f)];
+                return std::move(m);
+            }, std::map<int, int>{});
+            an::doNotOptimizeAway(hist);
+        });
+
+        bench.run("histogram_counts::add", [&] {
+            flux::histogram_counts<float> hist(bins);
+            for (float f : values) {
+                hist.add(f);
+            }
+            an::doNotOptimizeAway(hist);
+        });
+
+        bench.run("flux::histogram", [&] {
+            auto hist = flux::histogram(flux::ref(values), bins);
+            an::doNotOptimizeAway(hist);
+        });
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("p50, p99 and p999 of 4M floats");
+
+        bench.run("copy and std::nth_element", [&] {
+            auto copy = values;
+            float result = 0;
+            for (double q : {0.5, 0.99, 0.999}) {
+                auto nth = copy.begin() + static_cast<std::ptrdiff_t>(q * (n_values - 1));
+                std::ranges::nth_element(copy, nth);
+                result += *nth;
+            }
+            an::doNotOptimizeAway(result);
+        });
+
+        bench.run("flux::quantiles, eps = 0.001", [&] {
+            auto sketch = flux::quantiles(flux::ref(values), 0.001);
+            an::doNotOptimizeAway(sketch.quantiles({0.5, 0.99, 0.999}));
+        });
+    }
+}
@@ -0,0 +1,152 @@
+// Based on https://github.com/brevzin/rivers/blob/main/bench/benchmark.cxx
+// Copyright (c) 2021 Barry Revzin
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_BENCHMARK_INTERNAL_ITERATION_PIPELINES_HPP_INCLUDED
+#define FLUX_BENCHMARK_INTERNAL_ITERATION_PIPELINES_HPP_INCLUDED
+
+#include <flux.hpp>
+
+#include "ranges_concat.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// The pipelines timed by benchmark-internal-iteration and checked by
+// benchmark-regression, each written by hand, with std::ranges and with flux
+namespace internal_iteration {
+
+struct input {
+    std::vector<int> ints;
+    std::vector<int> reversed;
+};
+
+inline auto make_input() -> input
+{
+    input in;
+    in.ints.resize(1'000'000);
+    std::iota(in.ints.begin(), in.ints.end(), 0);
+    in.reversed = in.ints;
+    std::reverse(in.reversed.begin(), in.reversed.end());
+    return in;
+}
+
+inline constexpr auto is_even = [](int x) { return x % 2 == 0; };
+inline constexpr auto triple = [](int x) { return 3 * x; };
+
+inline auto transform_filter_handwritten(input const& in) -> int
+{
+    int res = 0;
+    for (int i : in.ints) {
+        i = triple(i);
+        if (is_even(i)) { res += i; }
+    }
+    return res;
+}
+
+inline auto transform_filter_ranges(input const& in) -> int
+{
+    namespace rv = std::views;
+    auto r = in.ints | rv::transform(triple) | rv::filter(is_even);
+
+    int res = 0;
+    for (int i : r) { res += i; }
+    return res;
+}
+
+inline auto transform_filter_flux(input const& in) -> int
+{
+    return flux::ref(in.ints).map(triple).filter(is_even).sum();
+}
+
+inline auto concat_handwritten(input const& in) -> int
+{
+    int res = 0;
+    for (int i : in.ints) { res += i; }
+    for (int i : in.reversed) { res += i; }
+    return res;
+}
+
+inline auto concat_ranges(input const& in) -> int
+{
+    namespace rv = std::views;
+    auto r = rv::concat(in.ints, in.reversed);
+    int res = 0;
+    for (int i : r) { res += i; }
+    return res;
+}
+
+inline auto concat_flux(input const& in) -> int
+{
+    return flux::chain(flux::ref(in.ints), flux::ref(in.reversed)).sum();
+}
+
+inline auto concat_take_transform_filter_handwritten(input const& in) -> int
+{
+    int res = 0;
+    int take = 1'500'000;
+    for (int i : in.ints) {
+        if (take == 0) { break; }
+        --take;
+        i = triple(i);
+        if (is_even(i)) { res += i; }
+    }
+    for (int i : in.reversed) {
+        if (take == 0) { break; }
+        --take;
+        i = triple(i);
+        if (is_even(i)) { res += i; }
+    }
+    return res;
+}
+
+inline auto concat_take_transform_filter_ranges(input const& in) -> int
+{
+    namespace rv = std::views;
+    auto r = rv::concat(in.ints, in.reversed) |
+             rv::take(1'500'000) | rv::transform(triple) |
+             rv::filter(is_even);
+    int res = 0;
+    for (int i : r) { res += i; }
+    return res;
+}
+
+inline auto concat_take_transform_filter_flux(input const& in) -> int
+{
+    return flux::chain(flux::ref(in.ints), flux::ref(in.reversed))
+        .take(1'500'000)
+        .map(triple)
+        .filter(is_even)
+        .sum();
+}
+
+struct variant {
+    char const* name;
+    int (*fn)(input const&);
+};
+
+struct pipeline {
+    char const* name;
+    variant variants[3];
+};
+
+inline constexpr pipeline pipelines[] = {
+    {"transform_filter",
+     {{"handwritten", transform_filter_handwritten},
+      {"ranges", transform_filter_ranges},
+      {"flux", transform_filter_flux}}},
+    {"concat",
+     {{"handwritten", concat_handwritten},
+      {"ranges", concat_ranges},
+      {"flux", concat_flux}}},
+    {"concat_take_transform_filter",
+     {{"handwritten", concat_take_transform_filter_handwritten},
+      {"ranges", concat_take_transform_filter_ranges},
+      {"flux", concat_take_transform_filter_flux}}},
+};
+
+} // namespace internal_iteration
+
+#endif // FLUX_BENCHMARK_INTERNAL_ITERATION_PIPELINES_HPP_INCLUDED
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+auto make_shards(std::size_t n_shards, std::size_t n_total) -> std::vector<std::vector<int>>
+{
+    std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> dist;
+
+    std::vector<std::vector<int>> shards(n_shards);
+    for (auto& shard : shards) {
+        shard.resize(n_total / n_shards);
+        std::ranges::generate(shard, [&] { return dist(gen); });
+        std::ranges::sort(shard);
+    }
+    return shards;
+}
+
+// A k-way merge using a binary heap of (value, shard) pairs
+auto heap_merge(std::vector<std::vector<int>> const& shards, std::vector<int>& out) -> void
+{
+    using entry = std::pair<int, std::size_t>;
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> heap;
+    std::vector<std::size_t> pos(shards.size());
+
+    for (std::size_t i = 0; i < shards.size(); i++) {
+        if (!shards[i].empty()) {
+            heap.emplace(shards[i][0], i);
+        }
+    }
+    while (!heap.empty()) {
+        auto [val, i] = heap.top();
+        heap.pop();
+        out.push_back(val);
+        if (++pos[i] < shards[i].size()) {
+            heap.emplace(shards[i][pos[i]], i);
+        }
+    }
+}
+
+// Merges each shard into the result in turn, as repeated binary merges would
+auto cascade_merge(std::vector<std::vector<int>> const& shards, std::vector<int>& out) -> void
+{
+    std::vector<int> tmp;
+    for (auto const& shard : shards) {
+        tmp.clear();
+        std::ranges::merge(out, shard, std::back_inserter(tmp));
+        std::swap(out, tmp);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 10;
+    constexpr std::size_t n_total = 4'000'000;
+
+    for (std::size_t n_shards : {2, 8, 64, 512}) {
+        auto const shards = make_shards(n_shards, n_total);
+
+        char title[64];
+        std::snprintf(title, sizeof(title), "merge %zu shards", n_shards);
+
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title(title);
+
+        bench.run("repeated std::merge", [&] {
+            std::vector<int> out;
+            cascade_merge(shards, out);
+            an::doNotOptimizeAway(out.data());
+        });
+
+        bench.run("std::priority_queue", [&] {
+            std::vector<int> out;
+            out.reserve(n_total);
+            heap_merge(shards, out);
+            an::doNotOptimizeAway(out.data());
+        });
+
+        bench.run("flux::merge_all", [&] {
+            std::vector<int> out;
+            out.reserve(n_total);
+            flux::merge_all(flux::ref(shards)).output_to(std::back_inserter(out));
+            an::doNotOptimizeAway(out.data());
+        });
+    }
+}
@@ -0,0 +1,67 @@
+# Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Compares the time to build a typical flux user with the headers and with
+# the flux module.
+#
+# Usage: cmake -DBUILD_DIR=<dir> [-DRUNS=N] -P module_build_time.cmake
+#
+# BUILD_DIR must have been configured with FLUX_BUILD_BENCHMARKS and
+# FLUX_BUILD_MODULE. Each target is rebuilt RUNS times (default 5) by deleting
+# its object files, and the minimum wall time is reported. The module is
+# built first, so the consumer timings don't include it: its own build time is
+# a one-off cost, shared by every importer.
+
+cmake_minimum_required(VERSION 3.23)
+
+if (NOT BUILD_DIR)
+    message(FATAL_ERROR "BUILD_DIR must be set")
+endif()
+
+if (NOT RUNS)
+    set(RUNS 5)
+endif()
+
+# Returns the current time in milliseconds
+function(now_ms out_var)
+    string(TIMESTAMP micros "%s%f")
+    math(EXPR ms "${micros} / 1000")
+    set(${out_var} ${ms} PARENT_SCOPE)
+endfunction()
+
+function(build target)
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} --build ${BUILD_DIR} --target ${target}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+    )
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "failed to build ${target}")
+    endif()
+endfunction()
+
+# Rebuilds the objects of a target RUNS times, reporting the fastest
+function(time_target target)
+    build(${target})
+    set(best "")
+    foreach(run RANGE 1 ${RUNS})
+        file(GLOB_RECURSE objects "${BUILD_DIR}/*.o" "${BUILD_DIR}/*.obj")
+        list(FILTER objects INCLUDE REGEX "/${target}\\.dir/")
+        if (objects)
+            file(REMOVE ${objects})
+        endif()
+        now_ms(start)
+        build(${target})
+        now_ms(end)
+        math(EXPR elapsed "${end} - ${start}")
+        if (best STREQUAL "" OR elapsed LESS best)
+            set(best ${elapsed})
+        endif()
+    endforeach()
+    message("${target}: ${best} ms")
+endfunction()
+
+time_target(flux-mod)
+time_target(benchmark-module-consumer-header)
+time_target(benchmark-module-consumer-module)
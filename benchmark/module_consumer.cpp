@@ -0,0 +1,50 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// A typical user of flux, whose build time is measured by
+// module_build_time.cmake. It is compiled twice: once including <flux.hpp>,
+// and once with USE_MODULES defined, importing the flux module instead.
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef USE_MODULES
+#include <flux.hpp>
+#else
+import flux;
+#endif
+
+auto sort_all(std::vector<int>& ints, std::vector<double>& doubles,
+              std::vector<std::string>& strings) -> void
+{
+    flux::sort(ints);
+    flux::sort(doubles, flux::cmp::compare_floating_point_unchecked);
+    flux::sort(strings);
+}
+
+auto find_newline(std::string_view text) -> flux::index_t
+{
+    return flux::find(text, '\n');
+}
+
+auto total(std::vector<int> const& ints) -> int
+{
+    return flux::sum(ints);
+}
+
+auto total_positive(std::span<int const> ints) -> int
+{
+    return flux::ref(ints).filter(flux::pred::positive).sum();
+}
+
+int main()
+{
+    std::vector<int> ints{3, 1, 2};
+    std::vector<double> doubles{3.0, 1.0, 2.0};
+    std::vector<std::string> strings{"c", "a", "b"};
+    sort_all(ints, doubles, strings);
+    return static_cast<int>(find_newline("a\nb")) + total(ints) + total_positive(ints);
+}
@@ -24,6 +24,10 @@ extern void memset_2d_flux_cartesian_product_iota(double* A, flux::distance_t N,
 extern void memset_diagonal_2d_reference(double* A, flux::distance_t N, flux::distance_t M);
 extern void memset_diagonal_2d_std_cartesian_product_iota_filter(double* A, flux::distance_t N, flux::distance_t M);
 extern void memset_diagonal_2d_flux_cartesian_product_iota_filter(double* A, flux::distance_t N, flux::distance_t M);
+extern void transpose_2d_reference(double* B, double const* A, flux::distance_t N, flux::distance_t M);
+extern void transpose_2d_blocked_reference(double* B, double const* A, flux::distance_t N, flux::distance_t M);
+extern void transpose_2d_flux_cartesian_product_iota(double* B, double const* A, flux::distance_t N, flux::distance_t M);
+extern void transpose_2d_flux_tiled_product_iota(double* B, double const* A, flux::distance_t N, flux::distance_t M);
 
 int main(int argc, char** argv)
 {
@@ -90,4 +94,32 @@ int main(int argc, char** argv)
         run_diagonal_2d_benchmark(memset_diagonal_2d_std_cartesian_product_iota_filter);
         run_diagonal_2d_benchmark(memset_diagonal_2d_flux_cartesian_product_iota_filter);
     }
+
+    {
+        std::vector<double> B(N * M);
+
+        const auto check_transpose_2d = [&] (auto& A, auto N, auto M) {
+            for (auto i : std::views::iota(0, N))
+                for (auto j : std::views::iota(0, M))
+                    if (B[j * N + i] != A[i * M + j]) throw false;
+        };
+
+        auto bench = an::Bench()
+            .minEpochIterations(n_iters)
+            .relative(true)
+            .performanceCounters(false);
+
+        const auto run_transpose_2d_benchmark_impl = [&] (auto name, auto func) {
+            run_benchmark(bench, A, N, M, name,
+                          [&] (double const* A, auto N, auto M) { func(B.data(), A, N, M); },
+                          check_transpose_2d);
+        };
+
+        #define run_transpose_2d_benchmark(func) run_transpose_2d_benchmark_impl(#func, func)
+
+        run_transpose_2d_benchmark(transpose_2d_reference);
+        run_transpose_2d_benchmark(transpose_2d_blocked_reference);
+        run_transpose_2d_benchmark(transpose_2d_flux_cartesian_product_iota);
+        run_transpose_2d_benchmark(transpose_2d_flux_tiled_product_iota);
+    }
 }
@@ -8,6 +8,7 @@
 #include <flux/sequence/iota.hpp>
 #include <flux/algorithm/for_each.hpp>
 #include <flux/adaptor/filter.hpp>
+#include <flux/adaptor/tiled_product.hpp>
 
 #if __cpp_lib_ranges_cartesian_product >= 202207L
 #include <ranges>
@@ -17,6 +18,7 @@
 
 #include <ranges>
 #include <algorithm>
+#include <array>
 
 void memset_2d_reference(double* A, flux::distance_t N, flux::distance_t M)
 {
@@ -70,3 +72,38 @@ void memset_diagonal_2d_flux_cartesian_product_iota_filter(double* A, flux::dist
         }));
 }
 
+
+void transpose_2d_reference(double* B, double const* A, flux::distance_t N, flux::distance_t M)
+{
+    for (flux::distance_t i = 0; i != N; ++i)
+        for (flux::distance_t j = 0; j != M; ++j)
+            B[j * N + i] = A[i * M + j];
+}
+
+void transpose_2d_blocked_reference(double* B, double const* A, flux::distance_t N, flux::distance_t M)
+{
+    constexpr flux::distance_t T = 32;
+    for (flux::distance_t ii = 0; ii < N; ii += T)
+        for (flux::distance_t jj = 0; jj < M; jj += T)
+            for (flux::distance_t i = ii; i < std::min(ii + T, N); ++i)
+                for (flux::distance_t j = jj; j < std::min(jj + T, M); ++j)
+                    B[j * N + i] = A[i * M + j];
+}
+
+void transpose_2d_flux_cartesian_product_iota(double* B, double const* A, flux::distance_t N, flux::distance_t M)
+{
+    flux::for_each(
+        flux::cartesian_product(flux::ints(0, N), flux::ints(0, M)),
+        flux::unpack([&] (auto i, auto j) {
+            B[j * N + i] = A[i * M + j];
+        }));
+}
+
+void transpose_2d_flux_tiled_product_iota(double* B, double const* A, flux::distance_t N, flux::distance_t M)
+{
+    flux::for_each(
+        flux::tiled_product(std::array{32, 32}, flux::ints(0, N), flux::ints(0, M)),
+        flux::unpack([&] (auto i, auto j) {
+            B[j * N + i] = A[i * M + j];
+        }));
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+// Same representation as flux::index_t. The values stored in this benchmark
+// are never negative, so a slot can promise that -1 is never stored and
+// use it as a niche, while a boxed value needs a separate engaged flag.
+struct slot {
+    flux::index_t value;
+};
+
+struct boxed {
+    flux::index_t value;
+};
+
+}
+
+template <>
+struct flux::optional_niche<slot> {
+    static constexpr auto null_value() noexcept -> slot { return slot{-1}; }
+    static constexpr auto is_null(slot const& i) noexcept -> bool { return i.value == -1; }
+};
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    std::printf("sizeof(optional<slot>) = %zu, sizeof(optional<boxed>) = %zu\n",
+                sizeof(flux::optional<slot>), sizeof(flux::optional<boxed>));
+    std::printf("sizeof(flatten cursor) = %zu\n",
+                sizeof(flux::cursor_t<decltype(flux::flatten(
+                    flux::ref(std::declval<std::vector<std::vector<int>>&>())))>));
+
+    std::vector<flux::index_t> ints(1'000'000);
+    std::iota(ints.begin(), ints.end(), flux::index_t{0});
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("filter_map");
+
+        bench.run("handwritten", [&] {
+            flux::index_t res = 0;
+            for (flux::index_t i : ints) {
+                if (i % 3 == 0) { res += i; }
+            }
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("optional<slot> (niche)", [&] {
+            auto seq = flux::ref(ints).filter_map([](flux::index_t i) {
+                return i % 3 == 0 ? flux::optional<slot>(slot{i}) : flux::nullopt;
+            });
+            flux::index_t res = 0;
+            FLUX_FOR(slot i, seq) { res += i.value; }
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("optional<boxed> (flag)", [&] {
+            auto seq = flux::ref(ints).filter_map([](flux::index_t i) {
+                return i % 3 == 0 ? flux::optional<boxed>(boxed{i}) : flux::nullopt;
+            });
+            flux::index_t res = 0;
+            FLUX_FOR(boxed b, seq) { res += b.value; }
+            an::doNotOptimizeAway(res);
+        });
+    }
+
+    // External iteration over flatten uses an optional inner cursor
+    std::vector<std::vector<int>> nested(10'000);
+    for (std::size_t i = 0; i < nested.size(); i++) {
+        nested[i].resize(i % 200);
+        std::iota(nested[i].begin(), nested[i].end(), 0);
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("flatten");
+
+        bench.run("handwritten", [&] {
+            int res = 0;
+            for (auto const& inner : nested) {
+                for (int i : inner) { res += i; }
+            }
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("flatten (external iteration)", [&] {
+            int res = 0;
+            FLUX_FOR(int i, flux::ref(nested).flatten()) { res += i; }
+            an::doNotOptimizeAway(res);
+        });
+
+        bench.run("flatten (internal iteration)", [&] {
+            int res = flux::ref(nested).flatten().sum();
+            an::doNotOptimizeAway(res);
+        });
+    }
+}
@@ -0,0 +1,124 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/*
+ * Measures how parallel_for_each() scales over cartesian products.
+ *
+ * Each workload is run with serial flux::for_each(), and with
+ * parallel_for_each() on 1, 2, 4, ... threads up to the number of hardware
+ * threads. The single-threaded run shows the cost of visiting the index
+ * space block by block rather than with the nested for_each_while().
+ *
+ *     benchmark-parallel-for-each [ITERATIONS]
+ */
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+#include <flux/parallel_for_each.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+constexpr flux::distance_t grid_size = 2000;
+constexpr flux::distance_t width = 2048;
+constexpr flux::distance_t height = 1024;
+
+// A function with a single minimum, at (1234, 567), which is just about
+// expensive enough for a brute-force search to be worth parallelising
+constexpr auto cost = [](flux::distance_t x, flux::distance_t y) {
+    auto dx = static_cast<double>(x - 1234);
+    auto dy = static_cast<double>(y - 567);
+    return dx * dx + 3.0 * dy * dy + 0.5 * dx * dy;
+};
+
+auto thread_counts() -> std::vector<std::size_t>
+{
+    std::size_t const max = (std::max)(std::thread::hardware_concurrency(), 1u);
+    std::vector<std::size_t> counts;
+    for (std::size_t n = 1; n < max; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max);
+    return counts;
+}
+
+// Lowers `best` to `value` if it is smaller
+void atomic_min(std::atomic<double>& best, double value)
+{
+    double cur = best.load(std::memory_order_relaxed);
+    while (value < cur && !best.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 10;
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("grid search: cartesian_product_map(cost, ints, ints)");
+
+        auto seq = flux::cartesian_product_map(cost, flux::ints(0, grid_size),
+                                               flux::ints(0, grid_size));
+
+        bench.run("for_each", [&] {
+            double best = std::numeric_limits<double>::max();
+            flux::for_each(seq, [&](double c) { best = (std::min)(best, c); });
+            an::doNotOptimizeAway(best);
+        });
+
+        for (std::size_t n : thread_counts()) {
+            bench.run("parallel_for_each, " + std::to_string(n) + " threads", [&] {
+                std::atomic<double> best{std::numeric_limits<double>::max()};
+                flux::parallel_for_each(seq, [&](double c) { atomic_min(best, c); }, n);
+                an::doNotOptimizeAway(best.load());
+            });
+        }
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("3x3 box blur: cartesian_product(ints, ints)");
+
+        std::vector<float> in(width * height);
+        std::vector<float> out(width * height);
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            in[i] = static_cast<float>(i % 251);
+        }
+
+        auto pixels = flux::cartesian_product(flux::ints(1, height - 1), flux::ints(1, width - 1));
+        auto blur = flux::unpack([&](auto i, auto j) {
+            float sum = 0.0f;
+            for (flux::distance_t di = -1; di <= 1; ++di) {
+                for (flux::distance_t dj = -1; dj <= 1; ++dj) {
+                    sum += in[static_cast<std::size_t>((i + di) * width + j + dj)];
+                }
+            }
+            out[static_cast<std::size_t>(i * width + j)] = sum / 9.0f;
+        });
+
+        bench.run("for_each", [&] {
+            flux::for_each(pixels, blur);
+            an::doNotOptimizeAway(out.data());
+        });
+
+        for (std::size_t n : thread_counts()) {
+            bench.run("parallel_for_each, " + std::to_string(n) + " threads", [&] {
+                flux::parallel_for_each(pixels, blur, n);
+                an::doNotOptimizeAway(out.data());
+            });
+        }
+    }
+}
@@ -0,0 +1,239 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Times the internal iteration pipelines and compares them against a
+// stored baseline.
+//
+// Usage: benchmark-regression [--runs N] [--iters N] [--threshold PCT]
+//                             [--save FILE] [--baseline FILE]
+//
+// Each variant is timed in N separate runs (default 5). Its result is the
+// median of the runs, and its noise is the largest relative deviation of any
+// run from that median. --save writes the results to FILE as CSV, which is
+// the format of the baseline files in benchmark/baselines.
+//
+// With --baseline, a variant has regressed if it is slower than the
+// baseline by more than twice the noise (the larger of the noise now and
+// when the baseline was recorded), or by more than the threshold (default
+// 5%) if that is larger. Every variant is reported, and the exit status is
+// 1 if any regressed.
+
+#include <nanobench.h>
+
+#include "internal_iteration_pipelines.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+struct measurement {
+    std::string name;
+    double median_ns;
+    double noise;
+};
+
+struct options {
+    int runs = 5;
+    int iters = 50;
+    double threshold = 0.05;
+    std::string save;
+    std::string baseline;
+};
+
+// How many times the noise a variant may slow down by before it counts as
+// a regression
+constexpr double noise_factor = 2.0;
+
+auto measure(std::string const& name, int runs, int iters, auto const& fn)
+    -> measurement
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto bench = an::Bench().output(nullptr).minEpochIterations(iters);
+        bench.run(name, [&] { an::doNotOptimizeAway(fn()); });
+        times.push_back(bench.results().front().median(an::Result::Measure::elapsed) * 1e9);
+    }
+
+    std::ranges::sort(times);
+    double const median = times.size() % 2 == 1
+        ? times[times.size() / 2]
+        : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2.0;
+    double const noise = (std::max)(median - times.front(), times.back() - median) / median;
+    return {name, median, noise};
+}
+
+auto write_csv(std::string const& path, options const& opts,
+               std::vector<measurement> const& results) -> bool
+{
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << "# benchmark-regression --runs " << opts.runs << " --iters " << opts.iters << '\n'
+         << "name,median_ns,noise\n";
+    for (auto const& m : results) {
+        file << m.name << ',' << m.median_ns << ',' << m.noise << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+auto read_csv(std::string const& path, std::map<std::string, measurement>& out) -> bool
+{
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line.front() == '#' || line.starts_with("name,")) {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string name, median, noise;
+        if (!std::getline(fields, name, ',') || !std::getline(fields, median, ',') ||
+            !std::getline(fields, noise)) {
+            std::fprintf(stderr, "%s: malformed line '%s'\n", path.c_str(), line.c_str());
+            return false;
+        }
+        out[name] = {name, std::stod(median), std::stod(noise)};
+    }
+    return true;
+}
+
+// Prints the result of each variant against its baseline, and returns the
+// number of regressions
+auto compare(std::vector<measurement> const& results,
+             std::map<std::string, measurement> const& baseline,
+             double threshold) -> int
+{
+    int regressions = 0;
+    std::printf("\n%-45s %12s %12s %8s %7s  %s\n", "benchmark", "baseline ns",
+                "current ns", "change", "limit", "status");
+    for (auto const& m : results) {
+        auto const it = baseline.find(m.name);
+        if (it == baseline.end()) {
+            std::printf("%-45s %12s %12.0f %8s %7s  new\n", m.name.c_str(), "-",
+                        m.median_ns, "-", "-");
+            continue;
+        }
+        auto const& base = it->second;
+        double const change = m.median_ns / base.median_ns - 1.0;
+        double const limit = (std::max)(threshold,
+                                        noise_factor * (std::max)(m.noise, base.noise));
+        char const* status = "ok";
+        if (change > limit) {
+            status = "REGRESSED";
+            ++regressions;
+        } else if (change < -limit) {
+            status = "improved";
+        }
+        std::printf("%-45s %12.0f %12.0f %+7.1f%% %6.1f%%  %s\n", m.name.c_str(),
+                    base.median_ns, m.median_ns, change * 100.0, limit * 100.0, status);
+    }
+    for (auto const& [name, base] : baseline) {
+        if (std::ranges::none_of(results, [&](auto const& m) { return m.name == name; })) {
+            std::printf("%-45s %12.0f %12s %8s %7s  missing\n", name.c_str(),
+                        base.median_ns, "-", "-", "-");
+        }
+    }
+    return regressions;
+}
+
+auto parse_args(int argc, char** argv, options& opts) -> bool
+{
+    for (int i = 1; i < argc; i++) {
+        std::string_view const arg = argv[i];
+        if (i + 1 == argc) {
+            return false;
+        }
+        char const* value = argv[++i];
+        if (arg == "--runs") {
+            opts.runs = std::atoi(value);
+        } else if (arg == "--iters") {
+            opts.iters = std::atoi(value);
+        } else if (arg == "--threshold") {
+            opts.threshold = std::atof(value) / 100.0;
+        } else if (arg == "--save") {
+            opts.save = value;
+        } else if (arg == "--baseline") {
+            opts.baseline = value;
+        } else {
+            return false;
+        }
+    }
+    return opts.runs > 0 && opts.iters > 0 && opts.threshold >= 0.0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    options opts;
+    if (!parse_args(argc, argv, opts)) {
+        std::fprintf(stderr, "usage: %s [--runs N] [--iters N] [--threshold PCT] "
+                             "[--save FILE] [--baseline FILE]\n", argv[0]);
+        return 2;
+    }
+
+    auto const in = internal_iteration::make_input();
+
+    std::vector<measurement> results;
+    bool mismatch = false;
+    std::printf("%-30s %16s %16s\n", "pipeline", "flux/handwritten", "flux/ranges");
+
+    for (auto const& p : internal_iteration::pipelines) {
+        // The variants must agree before their timings mean anything
+        int const expected = p.variants[0].fn(in);
+        std::map<std::string_view, double> times;
+
+        for (auto const& v : p.variants) {
+            if (v.fn(in) != expected) {
+                std::fprintf(stderr, "%s/%s computed a different result from %s/%s\n",
+                             p.name, v.name, p.name, p.variants[0].name);
+                mismatch = true;
+            }
+            auto m = measure(std::string(p.name) + "/" + v.name, opts.runs, opts.iters,
+                             [&] { return v.fn(in); });
+            times[v.name] = m.median_ns;
+            results.push_back(std::move(m));
+        }
+
+        std::printf("%-30s %15.2fx %15.2fx\n", p.name,
+                    times["flux"] / times["handwritten"], times["flux"] / times["ranges"]);
+    }
+
+    if (mismatch) {
+        return 1;
+    }
+
+    if (!opts.save.empty() && !write_csv(opts.save, opts, results)) {
+        std::fprintf(stderr, "could not write %s\n", opts.save.c_str());
+        return 2;
+    }
+
+    if (!opts.baseline.empty()) {
+        std::map<std::string, measurement> baseline;
+        if (!read_csv(opts.baseline, baseline)) {
+            std::fprintf(stderr, "could not read baseline %s\n", opts.baseline.c_str());
+            return 2;
+        }
+        int const regressions = compare(results, baseline, opts.threshold);
+        if (regressions > 0) {
+            std::printf("\n%d benchmark(s) regressed against %s\n", regressions,
+                        opts.baseline.c_str());
+            return 1;
+        }
+        std::printf("\nno regressions against %s\n", opts.baseline.c_str());
+    }
+}
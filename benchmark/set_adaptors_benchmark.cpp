@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    std::vector<int> big(10'000'000);
+    std::iota(big.begin(), big.end(), 0);
+
+    std::vector<int> small;
+    for (int i = 0; i < 1000; i++) {
+        small.push_back(i * 9973);
+    }
+
+    std::vector<int> evens, thirds;
+    for (int i = 0; i < 1'000'000; i++) {
+        evens.push_back(2 * i);
+        thirds.push_back(3 * i);
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("intersection, 1000 vs 10M elements");
+
+        bench.run("std::set_intersection", [&] {
+            std::vector<int> out;
+            std::ranges::set_intersection(small, big, std::back_inserter(out));
+            an::doNotOptimizeAway(out.size());
+        });
+
+        bench.run("flux::set_intersection", [&] {
+            auto n = flux::set_intersection(flux::ref(small), flux::ref(big)).count();
+            an::doNotOptimizeAway(n);
+        });
+
+        bench.run("flux::merge_join", [&] {
+            auto n = flux::merge_join(flux::ref(small), flux::ref(big),
+                                      std::identity{}, std::identity{}).count();
+            an::doNotOptimizeAway(n);
+        });
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("1M vs 1M elements");
+
+        bench.run("std::set_intersection", [&] {
+            std::vector<int> out;
+            std::ranges::set_intersection(evens, thirds, std::back_inserter(out));
+            an::doNotOptimizeAway(out.size());
+        });
+
+        bench.run("flux::set_intersection", [&] {
+            auto n = flux::set_intersection(flux::ref(evens), flux::ref(thirds)).count();
+            an::doNotOptimizeAway(n);
+        });
+
+        bench.run("flux::set_difference", [&] {
+            auto n = flux::set_difference(flux::ref(evens), flux::ref(thirds)).count();
+            an::doNotOptimizeAway(n);
+        });
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares each variant of the SIMD kernels which this CPU supports against
+// the standard algorithms.
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+namespace simd = flux::detail::simd;
+
+namespace {
+
+template <typename T>
+auto make_data(std::size_t n) -> std::vector<T>
+{
+    std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> dist(0, 100);
+    std::vector<T> vec(n);
+    std::ranges::generate(vec, [&] { return static_cast<T>(dist(gen)); });
+    return vec;
+}
+
+template <typename T>
+void run_benchmarks(char const* type_name, int n_iters)
+{
+    constexpr std::size_t n = 100'000;
+    auto const data = make_data<T>(n);
+    auto const absent = T{101};
+    auto const present = T{100};
+
+    struct kernels {
+        char const* name;
+        std::size_t (*find)(T const*, std::size_t, T);
+        std::size_t (*count)(T const*, std::size_t, T);
+        simd::extrema<T> (*minmax)(T const*, std::size_t);
+    };
+
+    std::vector<kernels> variants{
+        {"scalar", simd::find_scalar<T>, simd::count_scalar<T>, simd::minmax_scalar<T>}};
+#if FLUX_HAVE_SIMD_DISPATCH
+    auto const level = simd::detect_level();
+    variants.push_back({"sse2", simd::find_sse2<T const*, std::size_t, T>,
+                        simd::count_sse2<T const*, std::size_t, T>,
+                        simd::minmax_sse2<T const*, std::size_t>});
+    if (level >= flux::simd_level::avx2) {
+        variants.push_back({"avx2", simd::find_avx2<T const*, std::size_t, T>,
+                            simd::count_avx2<T const*, std::size_t, T>,
+                            simd::minmax_avx2<T const*, std::size_t>});
+    }
+    if (level >= flux::simd_level::avx512) {
+        variants.push_back({"avx512", simd::find_avx512<T const*, std::size_t, T>,
+                            simd::count_avx512<T const*, std::size_t, T>,
+                            simd::minmax_avx512<T const*, std::size_t>});
+    }
+#endif
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title(std::string("find absent value in 100k ") + type_name);
+        bench.run("std::find", [&] {
+            an::doNotOptimizeAway(std::find(data.begin(), data.end(), absent));
+        });
+        for (auto const& v : variants) {
+            bench.run(v.name, [&] { an::doNotOptimizeAway(v.find(data.data(), n, absent)); });
+        }
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title(std::string("count in 100k ") + type_name);
+        bench.run("std::count", [&] {
+            an::doNotOptimizeAway(std::count(data.begin(), data.end(), present));
+        });
+        for (auto const& v : variants) {
+            bench.run(v.name, [&] { an::doNotOptimizeAway(v.count(data.data(), n, present)); });
+        }
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title(std::string("minmax of 100k ") + type_name);
+        bench.run("std::minmax_element", [&] {
+            an::doNotOptimizeAway(std::minmax_element(data.begin(), data.end()));
+        });
+        for (auto const& v : variants) {
+            bench.run(v.name, [&] { an::doNotOptimizeAway(v.minmax(data.data(), n)); });
+        }
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 10;
+
+    run_benchmarks<unsigned char>("uint8", n_iters);
+    run_benchmarks<short>("int16", n_iters);
+    run_benchmarks<int>("int32", n_iters);
+    run_benchmarks<long long>("int64", n_iters);
+}
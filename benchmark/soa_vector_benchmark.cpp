@@ -0,0 +1,84 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+namespace {
+
+struct particle {
+    double x, y, z;
+    double vx, vy, vz;
+    float mass;
+    int id;
+};
+
+using particles_soa = flux::soa_vector<double, double, double, double, double, double, float, int>;
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 50;
+    constexpr std::size_t n_elems = 1'000'000;
+
+    std::mt19937 gen{1234};
+    std::uniform_real_distribution<double> dist{0.0, 100.0};
+    std::uniform_int_distribution<int> ids{0, 1'000'000};
+
+    std::vector<particle> aos;
+    particles_soa soa;
+    aos.reserve(n_elems);
+    soa.reserve(n_elems);
+    for (std::size_t i = 0; i < n_elems; i++) {
+        particle p{dist(gen), dist(gen), dist(gen), dist(gen), dist(gen), dist(gen),
+                   static_cast<float>(dist(gen)), ids(gen)};
+        aos.push_back(p);
+        soa.emplace_back(p.x, p.y, p.z, p.vx, p.vy, p.vz, p.mass, p.id);
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("sum of one field");
+
+        bench.run("AoS map(&particle::x)", [&] {
+            an::doNotOptimizeAway(flux::ref(aos).map(&particle::x).sum());
+        });
+
+        bench.run("SoA column<0>()", [&] {
+            an::doNotOptimizeAway(soa.column<0>().sum());
+        });
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(1).relative(true);
+        bench.title("sort by one field");
+
+        bench.run("AoS sort(proj(&particle::id))", [&] {
+            auto copy = aos;
+            flux::sort(copy, flux::proj(std::compare_three_way{}, &particle::id));
+            an::doNotOptimizeAway(copy.data());
+        });
+
+        bench.run("SoA sort (swaps rows)", [&] {
+            auto copy = soa;
+            flux::sort(copy, flux::proj(std::compare_three_way{},
+                                        [](auto const& row) -> int { return std::get<7>(row); }));
+            an::doNotOptimizeAway(copy.column<0>().data());
+        });
+
+        bench.run("SoA sort_by_column<7>()", [&] {
+            auto copy = soa;
+            copy.sort_by_column<7>();
+            an::doNotOptimizeAway(copy.column<0>().data());
+        });
+    }
+}
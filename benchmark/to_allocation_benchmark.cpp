@@ -0,0 +1,134 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <nanobench.h>
+
+#include <flux.hpp>
+#include <flux/arena.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace an = ankerl::nanobench;
+
+// Count every call to the global allocation functions made by this program
+namespace {
+std::size_t n_global_allocs = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++n_global_allocs;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    ++n_global_allocs;
+    auto const al = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(al, (size + al - 1) / al * al)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+// Runs func once and reports the number of global allocations it made
+template <typename Func>
+auto report_allocs(char const* name, Func func) -> void
+{
+    std::size_t const before = n_global_allocs;
+    func();
+    std::printf("%-40s %8zu allocations\n", name, n_global_allocs - before);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    int const n_iters = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    // Words long enough to defeat the small string optimisation
+    std::string text;
+    for (int i = 0; i < 2000; i++) {
+        text += "word_number_" + std::to_string(i) + "_of_the_input ";
+    }
+
+    std::vector<int> ints(100'000);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    flux::arena arena;
+
+    // GCC 12 crashes if split_string() is instantiated before chunk() here
+    auto chunk_default = [&] {
+        auto vec = flux::ref(ints).chunk(64).to<std::vector<std::vector<int>>>();
+        an::doNotOptimizeAway(vec);
+    };
+
+    auto chunk_arena = [&] {
+        arena.reset();
+        auto vec = flux::ref(ints).chunk(64)
+                       .to<std::pmr::vector<std::pmr::vector<int>>>(&arena);
+        an::doNotOptimizeAway(vec);
+    };
+
+    auto split_default = [&] {
+        auto vec = flux::split_string(std::string_view(text), ' ').to<std::vector<std::string>>();
+        an::doNotOptimizeAway(vec);
+    };
+
+    auto split_monotonic = [&] {
+        std::pmr::monotonic_buffer_resource res;
+        auto vec = flux::split_string(std::string_view(text), ' ')
+                       .to<std::pmr::vector<std::pmr::string>>(&res);
+        an::doNotOptimizeAway(vec);
+    };
+
+    auto split_arena = [&] {
+        arena.reset();
+        auto vec = flux::split_string(std::string_view(text), ' ')
+                       .to<std::pmr::vector<std::pmr::string>>(&arena);
+        an::doNotOptimizeAway(vec);
+    };
+
+    // Warm up the arena, so that the counts below show the steady state
+    split_arena();
+    chunk_arena();
+
+    report_allocs("split_string -> vector<string>", split_default);
+    report_allocs("split_string -> pmr (monotonic_buffer)", split_monotonic);
+    report_allocs("split_string -> pmr (flux::arena)", split_arena);
+    report_allocs("chunk -> vector<vector<int>>", chunk_default);
+    report_allocs("chunk -> pmr (flux::arena)", chunk_arena);
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("split_string to vector of strings");
+        bench.run("std::allocator", split_default);
+        bench.run("monotonic_buffer_resource", split_monotonic);
+        bench.run("flux::arena", split_arena);
+    }
+
+    {
+        auto bench = an::Bench().minEpochIterations(n_iters).relative(true);
+        bench.title("chunk to vector of vectors");
+        bench.run("std::allocator", chunk_default);
+        bench.run("flux::arena", chunk_arena);
+    }
+}
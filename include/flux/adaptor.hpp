@@ -19,14 +19,19 @@
 #include <flux/adaptor/chunk_by.hpp>
 #include <flux/adaptor/cursors.hpp>
 #include <flux/adaptor/cycle.hpp>
+#include <flux/adaptor/distinct.hpp>
 #include <flux/adaptor/drop.hpp>
 #include <flux/adaptor/drop_while.hpp>
 #include <flux/adaptor/filter.hpp>
 #include <flux/adaptor/filter_map.hpp>
 #include <flux/adaptor/flatten.hpp>
 #include <flux/adaptor/flatten_with.hpp>
+#include <flux/adaptor/hash_join.hpp>
+#include <flux/adaptor/instrument.hpp>
 #include <flux/adaptor/map.hpp>
 #include <flux/adaptor/mask.hpp>
+#include <flux/adaptor/merge.hpp>
+#include <flux/adaptor/merge_join.hpp>
 #include <flux/adaptor/read_only.hpp>
 #include <flux/adaptor/reverse.hpp>
 #include <flux/adaptor/scan.hpp>
@@ -38,6 +43,7 @@
 #include <flux/adaptor/stride.hpp>
 #include <flux/adaptor/take.hpp>
 #include <flux/adaptor/take_while.hpp>
+#include <flux/adaptor/tiled_product.hpp>
 #include <flux/adaptor/unchecked.hpp>
 #include <flux/adaptor/zip.hpp>
 
@@ -112,6 +112,13 @@ public:
         auto s = (flux::size(self.base_) - N) + 1;
         return (cmp::max)(s, distance_t{0});
     }
+
+    // The back cursor is checked against the end of the base, and the
+    // others trail behind it, so the windows can be read unchecked
+    static constexpr auto for_each_while(auto& self, auto&& pred) -> cursor_type
+    {
+        return for_each_while_unchecked(self, FLUX_FWD(pred));
+    }
 };
 
 template <typename Base, distance_t N>
@@ -199,6 +206,16 @@ public:
                 return std::invoke(self.func_, flux::read_at(self.base_, curs)...);
             }, cur.arr);
         }
+
+        template <typename Self>
+        static constexpr auto read_at_unchecked(Self& self, cursor_t<Self> const& cur)
+            -> decltype(auto)
+            requires repeated_invocable<decltype((self.func_)), element_t<decltype((self.base_))>, N>
+        {
+            return std::apply([&](auto const&... curs) {
+                return std::invoke(self.func_, flux::read_at_unchecked(self.base_, curs)...);
+            }, cur.arr);
+        }
     };
 };
 
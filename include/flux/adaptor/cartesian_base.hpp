@@ -61,6 +61,8 @@ struct cartesian_traits_types<Arity, cartesian_kind::product, read_kind::tuple,
 template <std::size_t Arity, cartesian_kind CartesianKind, read_kind ReadKind, typename... Bases>
 struct cartesian_traits_base_impl : default_sequence_traits {
 private:
+    template <typename From, typename To>
+    using const_like_t = std::conditional_t<std::is_const_v<From>, To const, To>;
 
     template<std::size_t I, typename Self>
     static constexpr auto& get_base(Self& self)
@@ -389,7 +391,45 @@ public:
     static constexpr auto for_each_while(Self& self, Function&& func) -> cursor_t<Self>
         requires (ReadKind == read_kind::map)
     {
-        return default_sequence_traits::for_each_while(self, FLUX_FWD(func));
+        return for_each_while_unchecked(self, FLUX_FWD(func));
+    }
+
+    // Visits the `count` elements starting at `cur`, as an outer loop over
+    // the rows of the innermost base and a tight inner loop along each row.
+    // Used by parallel_for_each() to iterate one block of the flattened
+    // index space.
+    template <typename Self, typename Pred>
+    static constexpr auto for_each_while_n(Self& self, cursor_t<Self> cur, distance_t count,
+                                           Pred&& pred) -> cursor_t<Self>
+        requires ((random_access_sequence<const_like_t<Self, Bases>> && ...) &&
+                  (sized_sequence<const_like_t<Self, Bases>> && ...))
+    {
+        FLUX_DEBUG_ASSERT(count <= flux::size(self) - flux::distance(self, flux::first(self), cur));
+
+        auto& inner = get_base<Arity - 1>(self);
+        auto& inner_cur = std::get<Arity - 1>(cur);
+        distance_t const inner_size = flux::size(inner);
+
+        while (count > 0) {
+            distance_t const pos = flux::distance(inner, flux::first(inner), inner_cur);
+            distance_t const run = (cmp::min)(count, inner_size - pos);
+
+            for (distance_t i = 0; i < run; ++i) {
+                if (!std::invoke(pred, read_at_unchecked(self, cur))) {
+                    return cur;
+                }
+                flux::inc(inner, inner_cur);
+            }
+            count -= run;
+
+            if constexpr (Arity > 1) {
+                if (flux::is_last(inner, inner_cur)) {
+                    inner_cur = flux::first(inner);
+                    inc_impl<Arity - 2>(self, cur);
+                }
+            }
+        }
+        return cur;
     }
 
 };
@@ -0,0 +1,196 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ADAPTOR_DISTINCT_HPP_INCLUDED
+#define FLUX_ADAPTOR_DISTINCT_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <flux/algorithm/detail/bloom_filter.hpp>
+#include <flux/algorithm/detail/flat_hash_table.hpp>
+
+#include <functional>
+#include <memory>
+
+namespace flux {
+
+namespace detail {
+
+// Remembers every distinct value seen so far, using a flat hash set
+template <typename Value, typename Hash, typename Eq, typename Alloc>
+struct exact_seen_set {
+    flat_hash_table<Value, std::identity, Hash, Eq, Alloc> table;
+
+    template <typename T>
+    constexpr auto insert(T const& item) -> bool
+    {
+        return table.find_or_emplace(item, [&item] { return Value(item); }).second;
+    }
+};
+
+template <typename Base, typename Seen>
+struct distinct_adaptor : inline_sequence_base<distinct_adaptor<Base, Seen>> {
+private:
+    FLUX_NO_UNIQUE_ADDRESS Base base_;
+    Seen seen_;
+
+public:
+    constexpr distinct_adaptor(decays_to<Base> auto&& base, Seen&& seen)
+        : base_(FLUX_FWD(base)),
+          seen_(std::move(seen))
+    {}
+
+    distinct_adaptor(distinct_adaptor&&) = default;
+    distinct_adaptor& operator=(distinct_adaptor&&) = default;
+
+    struct flux_sequence_traits : default_sequence_traits {
+    private:
+        // The cursor is move-only, because the set of elements seen so far
+        // is shared by the whole sequence: this makes distinct single-pass
+        struct cursor_type {
+            cursor_type(cursor_type&&) = default;
+            cursor_type& operator=(cursor_type&&) = default;
+
+        private:
+            friend struct flux_sequence_traits;
+
+            constexpr explicit cursor_type(cursor_t<Base>&& base_cur)
+                : base_cur(std::move(base_cur))
+            {}
+
+            cursor_t<Base> base_cur;
+        };
+
+        using self_t = distinct_adaptor;
+
+        // Advances `cur` to the next element which has not been seen before
+        static constexpr auto skip_seen(self_t& self, cursor_t<Base>& cur) -> void
+        {
+            while (!flux::is_last(self.base_, cur) &&
+                   !self.seen_.insert(flux::read_at(self.base_, cur))) {
+                flux::inc(self.base_, cur);
+            }
+        }
+
+    public:
+        using value_type = value_t<Base>;
+
+        static constexpr auto first(self_t& self) -> cursor_type
+        {
+            auto cur = flux::first(self.base_);
+            skip_seen(self, cur);
+            return cursor_type(std::move(cur));
+        }
+
+        static constexpr auto is_last(self_t& self, cursor_type const& cur) -> bool
+        {
+            return flux::is_last(self.base_, cur.base_cur);
+        }
+
+        static constexpr auto inc(self_t& self, cursor_type& cur) -> void
+        {
+            flux::inc(self.base_, cur.base_cur);
+            skip_seen(self, cur.base_cur);
+        }
+
+        static constexpr auto read_at(self_t& self, cursor_type const& cur)
+            -> decltype(flux::read_at(self.base_, cur.base_cur))
+        {
+            return flux::read_at(self.base_, cur.base_cur);
+        }
+
+        static constexpr auto move_at(self_t& self, cursor_type const& cur)
+            -> decltype(flux::move_at(self.base_, cur.base_cur))
+        {
+            return flux::move_at(self.base_, cur.base_cur);
+        }
+
+        static constexpr auto last(self_t& self) -> cursor_type
+            requires bounded_sequence<Base>
+        {
+            return cursor_type(flux::last(self.base_));
+        }
+
+        static constexpr auto for_each_while(self_t& self, auto&& pred) -> cursor_type
+        {
+            return cursor_type(flux::for_each_while(self.base_, [&](auto&& elem) {
+                if (self.seen_.insert(std::as_const(elem))) {
+                    return std::invoke(pred, FLUX_FWD(elem));
+                } else {
+                    return true;
+                }
+            }));
+        }
+    };
+};
+
+template <typename Seq, typename Hash, typename Eq>
+concept distinct_hashable =
+    std::constructible_from<value_t<Seq>, element_t<Seq>&> &&
+    std::invocable<Hash const&, element_t<Seq>&> &&
+    std::invocable<Hash const&, value_t<Seq> const&> &&
+    std::predicate<Eq const&, value_t<Seq> const&, element_t<Seq>&>;
+
+struct distinct_fn {
+    template <adaptable_sequence Seq, typename Hash = std::hash<value_t<Seq>>,
+              typename Eq = std::equal_to<>>
+        requires (!num::integral<Hash>) && distinct_hashable<Seq, Hash, Eq>
+    [[nodiscard]]
+    constexpr auto operator()(Seq&& seq, Hash hash = Hash{}, Eq eq = Eq{}) const
+        -> sequence auto
+    {
+        using seen_t = exact_seen_set<value_t<Seq>, Hash, Eq, std::allocator<value_t<Seq>>>;
+        return distinct_adaptor<std::decay_t<Seq>, seen_t>(
+            FLUX_FWD(seq), seen_t{{std::identity{}, std::move(hash), std::move(eq)}});
+    }
+
+    template <adaptable_sequence Seq, typename Hash = std::hash<value_t<Seq>>,
+              typename Eq = std::equal_to<>, typename Alloc = std::allocator<value_t<Seq>>>
+        requires distinct_hashable<Seq, Hash, Eq>
+    [[nodiscard]]
+    constexpr auto operator()(Seq&& seq, num::integral auto capacity_hint,
+                              Hash hash = Hash{}, Eq eq = Eq{},
+                              Alloc const& alloc = Alloc{}) const
+        -> sequence auto
+    {
+        using seen_t = exact_seen_set<value_t<Seq>, Hash, Eq, Alloc>;
+        seen_t seen{{std::identity{}, std::move(hash), std::move(eq), alloc}};
+        seen.table.reserve(num::checked_cast<std::size_t>(capacity_hint));
+        return distinct_adaptor<std::decay_t<Seq>, seen_t>(FLUX_FWD(seq), std::move(seen));
+    }
+};
+
+struct approx_distinct_fn {
+    template <adaptable_sequence Seq, typename Hash = std::hash<value_t<Seq>>>
+        requires std::invocable<Hash const&, element_t<Seq>&>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, num::integral auto expected_count,
+                    double false_positive_rate = 0.01, Hash hash = Hash{}) const
+        -> sequence auto
+    {
+        using seen_t = bloom_filter<Hash>;
+        return distinct_adaptor<std::decay_t<Seq>, seen_t>(
+            FLUX_FWD(seq),
+            seen_t(num::checked_cast<std::size_t>(expected_count), false_positive_rate,
+                   std::move(hash)));
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto distinct = detail::distinct_fn{};
+FLUX_EXPORT inline constexpr auto approx_distinct = detail::approx_distinct_fn{};
+
+template <typename Derived>
+template <typename D, typename Hash, typename Eq>
+    requires std::invocable<Hash const&, element_t<D>&> &&
+             std::predicate<Eq const&, value_t<D> const&, element_t<D>&>
+constexpr auto inline_sequence_base<Derived>::distinct(Hash hash, Eq eq) &&
+{
+    return flux::distinct(std::move(derived()), std::move(hash), std::move(eq));
+}
+
+} // namespace flux
+
+#endif // FLUX_ADAPTOR_DISTINCT_HPP_INCLUDED
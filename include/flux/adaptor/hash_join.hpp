@@ -0,0 +1,322 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ADAPTOR_HASH_JOIN_HPP_INCLUDED
+#define FLUX_ADAPTOR_HASH_JOIN_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <flux/adaptor/filter.hpp>
+#include <flux/algorithm/detail/flat_hash_table.hpp>
+#include <flux/algorithm/for_each.hpp>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+FLUX_EXPORT
+template <typename Seq, typename KeyFn>
+using join_key_t = std::decay_t<std::invoke_result_t<KeyFn&, value_t<Seq> const&>>;
+
+namespace detail {
+
+/*
+ * The materialised build side of a hash join.
+ *
+ * Build rows are copied out of the input and stored grouped by key, so that
+ * the matches for a probe key are a contiguous range of rows. The hash table
+ * maps each distinct key to its range.
+ */
+template <typename Value, typename Key, typename Hash, typename Eq>
+class join_table {
+    struct entry {
+        Key key;
+        distance_t begin;
+        distance_t end;
+    };
+
+    struct key_of_entry {
+        constexpr auto operator()(entry const& e) const -> Key const& { return e.key; }
+    };
+
+    flat_hash_table<entry, key_of_entry, Hash, Eq> table_;
+    std::vector<Value> rows_;
+
+public:
+    template <typename Seq, typename KeyFn>
+    constexpr join_table(Seq& build, KeyFn& key_fn, Hash hash, Eq eq)
+        : table_(key_of_entry{}, std::move(hash), std::move(eq))
+    {
+        std::vector<Value> input;
+        if constexpr (sized_sequence<Seq>) {
+            input.reserve(num::checked_cast<std::size_t>(flux::size(build)));
+        }
+        flux::for_each(build, [&input](auto&& elem) { input.emplace_back(FLUX_FWD(elem)); });
+
+        std::size_t const n_rows = input.size();
+
+        table_.reserve(n_rows);
+
+        // First pass: find the entry for each row, counting the rows per key
+        std::vector<std::size_t> row_entry(n_rows);
+        for (std::size_t i = 0; i < n_rows; i++) {
+            auto&& key = std::invoke(key_fn, std::as_const(input[i]));
+            auto& e = table_.find_or_emplace(key, [&] { return entry{Key(key), 0, 0}; }).first;
+            ++e.end;
+            row_entry[i] = static_cast<std::size_t>(&e - table_.entries().data());
+        }
+
+        // Turn the per-key counts into ranges of rows
+        distance_t offset = 0;
+        for (entry& e : table_.mutable_entries()) {
+            distance_t count = e.end;
+            e.begin = e.end = offset;
+            offset += count;
+        }
+
+        // Second pass: move each row into its position in the grouped order,
+        // preserving the input order within each key
+        std::vector<std::size_t> source(n_rows);
+        for (std::size_t i = 0; i < n_rows; i++) {
+            entry& e = table_.mutable_entries()[row_entry[i]];
+            source[static_cast<std::size_t>(e.end++)] = i;
+        }
+        rows_.reserve(n_rows);
+        for (std::size_t i : source) {
+            rows_.push_back(std::move(input[i]));
+        }
+    }
+
+    // Returns the range of row indices whose key is equal to `key`
+    template <typename K>
+    [[nodiscard]]
+    constexpr auto find(K const& key) const -> std::pair<distance_t, distance_t>
+    {
+        if (entry const* e = table_.find(key)) {
+            return {e->begin, e->end};
+        } else {
+            return {0, 0};
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto row(distance_t idx) const -> Value const&
+    {
+        return rows_[static_cast<std::size_t>(idx)];
+    }
+
+    [[nodiscard]]
+    constexpr auto num_rows() const -> distance_t
+    {
+        return num::cast<distance_t>(rows_.size());
+    }
+};
+
+template <typename Value, typename Table, typename Probe, typename ProbeKey>
+struct hash_join_adaptor
+    : inline_sequence_base<hash_join_adaptor<Value, Table, Probe, ProbeKey>> {
+private:
+    Table table_;
+    FLUX_NO_UNIQUE_ADDRESS Probe probe_;
+    FLUX_NO_UNIQUE_ADDRESS ProbeKey probe_key_;
+
+public:
+    constexpr hash_join_adaptor(Table&& table, decays_to<Probe> auto&& probe,
+                                ProbeKey&& probe_key)
+        : table_(std::move(table)),
+          probe_(FLUX_FWD(probe)),
+          probe_key_(std::move(probe_key))
+    {}
+
+    struct flux_sequence_traits : default_sequence_traits {
+    private:
+        struct cursor_type {
+            cursor_t<Probe> probe_cur;
+            distance_t row = 0;
+            distance_t row_end = 0;
+
+            friend auto operator==(cursor_type const&, cursor_type const&) -> bool
+                requires std::equality_comparable<cursor_t<Probe>>
+                = default;
+        };
+
+        template <typename Self>
+        using probe_element_t = decltype(flux::read_at(std::declval<Self&>().probe_,
+                                                       std::declval<cursor_t<Probe> const&>()));
+
+        template <typename Self>
+        using element_type = std::pair<Value const&, probe_element_t<Self>>;
+
+        // Advances `cur` to the first probe element at or after its current
+        // position which has at least one match
+        static constexpr auto find_match(auto& self, cursor_type& cur) -> void
+        {
+            while (!flux::is_last(self.probe_, cur.probe_cur)) {
+                auto [begin, end] = self.table_.find(
+                    std::invoke(self.probe_key_, flux::read_at(self.probe_, cur.probe_cur)));
+                if (begin != end) {
+                    cur.row = begin;
+                    cur.row_end = end;
+                    return;
+                }
+                flux::inc(self.probe_, cur.probe_cur);
+            }
+            cur.row = cur.row_end = 0;
+        }
+
+    public:
+        using value_type = std::pair<Value, value_t<Probe>>;
+
+        static constexpr bool disable_multipass = !multipass_sequence<Probe>;
+
+        static constexpr auto first(auto& self) -> cursor_type
+        {
+            cursor_type cur{flux::first(self.probe_)};
+            find_match(self, cur);
+            return cur;
+        }
+
+        static constexpr auto is_last(auto& self, cursor_type const& cur) -> bool
+        {
+            return flux::is_last(self.probe_, cur.probe_cur);
+        }
+
+        static constexpr auto inc(auto& self, cursor_type& cur) -> void
+        {
+            if (++cur.row == cur.row_end) {
+                flux::inc(self.probe_, cur.probe_cur);
+                find_match(self, cur);
+            }
+        }
+
+        template <typename Self>
+        static constexpr auto read_at(Self& self, cursor_type const& cur)
+            -> element_type<Self>
+        {
+            return element_type<Self>(self.table_.row(cur.row),
+                                      flux::read_at(self.probe_, cur.probe_cur));
+        }
+
+        static constexpr auto last(auto& self) -> cursor_type
+            requires bounded_sequence<Probe>
+        {
+            return cursor_type{flux::last(self.probe_)};
+        }
+
+        template <typename Self>
+        static constexpr auto for_each_while(Self& self, auto&& pred) -> cursor_type
+        {
+            using elem_t = probe_element_t<Self>;
+            // Each probe element may be paired with several build rows, so
+            // it must not be moved into the first of them
+            using pass_t = std::conditional_t<std::is_reference_v<elem_t>, elem_t, elem_t const&>;
+
+            distance_t stop_row = 0;
+            distance_t stop_end = 0;
+
+            auto probe_cur = flux::for_each_while(self.probe_, [&](auto&& elem) {
+                auto [begin, end] = self.table_.find(std::invoke(self.probe_key_, elem));
+                for (distance_t r = begin; r < end; r++) {
+                    if (!std::invoke(pred, element_type<Self>(self.table_.row(r),
+                                                              static_cast<pass_t>(elem)))) {
+                        stop_row = r;
+                        stop_end = end;
+                        return false;
+                    }
+                }
+                return true;
+            });
+
+            return cursor_type{std::move(probe_cur), stop_row, stop_end};
+        }
+    };
+};
+
+// The predicate used by semi_join and anti_join
+template <typename KeySet, typename ProbeKey, bool Anti>
+struct join_filter_pred {
+    KeySet keys;
+    FLUX_NO_UNIQUE_ADDRESS ProbeKey probe_key;
+
+    template <typename T>
+    constexpr auto operator()(T const& elem) const -> bool
+    {
+        return (keys.find(std::invoke(probe_key, elem)) != nullptr) != Anti;
+    }
+};
+
+template <typename Build, typename Probe, typename BuildKey, typename ProbeKey,
+          typename Hash, typename Eq>
+concept hash_joinable =
+    sequence<Build> &&
+    std::constructible_from<value_t<Build>, element_t<Build>> &&
+    std::invocable<BuildKey&, value_t<Build> const&> &&
+    std::invocable<ProbeKey const&, element_t<Probe>> &&
+    std::invocable<Hash const&, join_key_t<Build, BuildKey> const&> &&
+    std::invocable<Hash const&,
+                   std::invoke_result_t<ProbeKey const&, element_t<Probe>>> &&
+    std::predicate<Eq const&, join_key_t<Build, BuildKey> const&,
+                   std::invoke_result_t<ProbeKey const&, element_t<Probe>>>;
+
+struct hash_join_fn {
+    template <sequence Build, adaptable_sequence Probe, typename BuildKey, typename ProbeKey,
+              typename Key = join_key_t<Build, BuildKey>,
+              typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+        requires hash_joinable<Build, Probe, BuildKey, ProbeKey, Hash, Eq>
+    [[nodiscard]]
+    constexpr auto operator()(Build&& build, Probe&& probe, BuildKey build_key,
+                              ProbeKey probe_key, Hash hash = Hash{}, Eq eq = Eq{}) const
+        -> sequence auto
+    {
+        using value_type = value_t<Build>;
+        using table_t = join_table<value_type, Key, Hash, Eq>;
+
+        return hash_join_adaptor<value_type, table_t, std::decay_t<Probe>, ProbeKey>(
+            table_t(build, build_key, std::move(hash), std::move(eq)),
+            FLUX_FWD(probe), std::move(probe_key));
+    }
+};
+
+template <bool Anti>
+struct semi_join_fn {
+    template <sequence Build, adaptable_sequence Probe, typename BuildKey, typename ProbeKey,
+              typename Key = std::decay_t<std::invoke_result_t<BuildKey&, element_t<Build>>>,
+              typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+        requires std::invocable<BuildKey&, element_t<Build>> &&
+                 std::invocable<ProbeKey const&, element_t<Probe>> &&
+                 std::invocable<Hash const&, Key const&> &&
+                 std::invocable<Hash const&,
+                                std::invoke_result_t<ProbeKey const&, element_t<Probe>>> &&
+                 std::predicate<Eq const&, Key const&,
+                                std::invoke_result_t<ProbeKey const&, element_t<Probe>>>
+    [[nodiscard]]
+    constexpr auto operator()(Build&& build, Probe&& probe, BuildKey build_key,
+                              ProbeKey probe_key, Hash hash = Hash{}, Eq eq = Eq{}) const
+        -> sequence auto
+    {
+        using set_t = flat_hash_table<Key, std::identity, Hash, Eq>;
+
+        set_t keys(std::identity{}, std::move(hash), std::move(eq));
+        flux::for_each(build, [&](auto&& elem) {
+            auto&& key = std::invoke(build_key, FLUX_FWD(elem));
+            (void) keys.find_or_emplace(key, [&key] { return Key(FLUX_FWD(key)); });
+        });
+
+        return flux::filter(FLUX_FWD(probe),
+                            join_filter_pred<set_t, ProbeKey, Anti>{std::move(keys),
+                                                                    std::move(probe_key)});
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto hash_join = detail::hash_join_fn{};
+FLUX_EXPORT inline constexpr auto semi_join = detail::semi_join_fn<false>{};
+FLUX_EXPORT inline constexpr auto anti_join = detail::semi_join_fn<true>{};
+
+} // namespace flux
+
+#endif // FLUX_ADAPTOR_HASH_JOIN_HPP_INCLUDED
@@ -0,0 +1,336 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ADAPTOR_INSTRUMENT_HPP_INCLUDED
+#define FLUX_ADAPTOR_INSTRUMENT_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#if FLUX_ENABLE_INSTRUMENTATION
+#include <chrono>
+#endif
+
+namespace flux {
+
+/*
+ * Counts of the sequence operations received by one stage of a pipeline,
+ * filled in by the instrument() adaptor
+ */
+FLUX_EXPORT
+struct instrument_counters {
+    // A label for the stage in reports
+    char const* name = "";
+    // Whether to measure the time spent in the stage, which costs two clock
+    // reads per operation
+    bool timed = false;
+
+    std::uint64_t first = 0;
+    std::uint64_t is_last = 0;
+    // Includes read_at_unchecked()
+    std::uint64_t read_at = 0;
+    // Includes move_at_unchecked()
+    std::uint64_t move_at = 0;
+    std::uint64_t inc = 0;
+    std::uint64_t inc_by = 0;
+    std::uint64_t dec = 0;
+    std::uint64_t distance = 0;
+    std::uint64_t size = 0;
+    std::uint64_t last = 0;
+    std::uint64_t for_each_while = 0;
+
+    // The number of elements which passed through the stage, either read
+    // through a cursor or passed to a for_each_while() callback
+    std::uint64_t elements = 0;
+
+    // The time spent in this stage and those upstream of it, not including
+    // the time spent downstream in for_each_while() callbacks
+    std::uint64_t elapsed_ns = 0;
+
+    constexpr auto reset() -> void
+    {
+        *this = instrument_counters{.name = name, .timed = timed};
+    }
+};
+
+namespace detail {
+
+#if FLUX_ENABLE_INSTRUMENTATION
+
+// Adds the time until it is destroyed to counters->elapsed_ns, if the
+// counters are timed
+struct instrument_timer {
+    using clock = std::chrono::steady_clock;
+
+    instrument_counters* counters;
+    clock::time_point start{};
+
+    constexpr explicit instrument_timer(instrument_counters* c) : counters(c)
+    {
+        if (!std::is_constant_evaluated() && counters->timed) {
+            start = clock::now();
+        }
+    }
+
+    instrument_timer(instrument_timer&&) = delete;
+
+    constexpr ~instrument_timer()
+    {
+        if (!std::is_constant_evaluated() && counters->timed) {
+            auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - start).count();
+            counters->elapsed_ns += static_cast<std::uint64_t>(ns);
+        }
+    }
+};
+
+template <sequence Base>
+struct instrument_adaptor : inline_sequence_base<instrument_adaptor<Base>> {
+private:
+    FLUX_NO_UNIQUE_ADDRESS Base base_;
+    instrument_counters* counters_;
+
+public:
+    constexpr instrument_adaptor(decays_to<Base> auto&& base, instrument_counters& counters)
+        : base_(FLUX_FWD(base)),
+          counters_(std::addressof(counters))
+    {}
+
+    constexpr auto base() & -> Base& { return base_; }
+    constexpr auto base() const& -> Base const& { return base_; }
+
+    struct flux_sequence_traits : passthrough_traits_base {
+    private:
+        // Counts a call to the given operation, and times it if requested
+        static constexpr auto record(auto& self, std::uint64_t instrument_counters::* op)
+            -> instrument_timer
+        {
+            ++(self.counters_->*op);
+            return instrument_timer(self.counters_);
+        }
+
+    public:
+        using value_type = value_t<Base>;
+        static constexpr bool disable_multipass = !multipass_sequence<Base>;
+        static constexpr bool is_infinite = infinite_sequence<Base>;
+        // The SIMD kernels would read the elements without being counted
+        static constexpr bool disable_simd = true;
+
+        static constexpr auto first(auto& self)
+            -> decltype(flux::first(self.base_))
+        {
+            auto _ = record(self, &instrument_counters::first);
+            return flux::first(self.base_);
+        }
+
+        static constexpr auto is_last(auto& self, auto const& cur)
+            -> decltype(flux::is_last(self.base_, cur))
+        {
+            auto _ = record(self, &instrument_counters::is_last);
+            return flux::is_last(self.base_, cur);
+        }
+
+        static constexpr auto read_at(auto& self, auto const& cur)
+            -> decltype(flux::read_at(self.base_, cur))
+        {
+            auto _ = record(self, &instrument_counters::read_at);
+            ++self.counters_->elements;
+            return flux::read_at(self.base_, cur);
+        }
+
+        static constexpr auto read_at_unchecked(auto& self, auto const& cur)
+            -> decltype(flux::read_at_unchecked(self.base_, cur))
+        {
+            auto _ = record(self, &instrument_counters::read_at);
+            ++self.counters_->elements;
+            return flux::read_at_unchecked(self.base_, cur);
+        }
+
+        static constexpr auto move_at(auto& self, auto const& cur)
+            -> decltype(flux::move_at(self.base_, cur))
+        {
+            auto _ = record(self, &instrument_counters::move_at);
+            ++self.counters_->elements;
+            return flux::move_at(self.base_, cur);
+        }
+
+        static constexpr auto move_at_unchecked(auto& self, auto const& cur)
+            -> decltype(flux::move_at_unchecked(self.base_, cur))
+        {
+            auto _ = record(self, &instrument_counters::move_at);
+            ++self.counters_->elements;
+            return flux::move_at_unchecked(self.base_, cur);
+        }
+
+        static constexpr auto inc(auto& self, auto& cur)
+            -> decltype(flux::inc(self.base_, cur))
+        {
+            auto _ = record(self, &instrument_counters::inc);
+            return flux::inc(self.base_, cur);
+        }
+
+        static constexpr auto inc(auto& self, auto& cur, distance_t offset)
+            -> decltype(flux::inc(self.base_, cur, offset))
+        {
+            auto _ = record(self, &instrument_counters::inc_by);
+            return flux::inc(self.base_, cur, offset);
+        }
+
+        static constexpr auto dec(auto& self, auto& cur)
+            -> decltype(flux::dec(self.base_, cur))
+        {
+            auto _ = record(self, &instrument_counters::dec);
+            return flux::dec(self.base_, cur);
+        }
+
+        static constexpr auto distance(auto& self, auto const& from, auto const& to)
+            -> decltype(flux::distance(self.base_, from, to))
+            requires random_access_sequence<decltype((self.base_))>
+        {
+            auto _ = record(self, &instrument_counters::distance);
+            return flux::distance(self.base_, from, to);
+        }
+
+        static constexpr auto size(auto& self)
+            -> decltype(flux::size(self.base_))
+        {
+            auto _ = record(self, &instrument_counters::size);
+            return flux::size(self.base_);
+        }
+
+        static constexpr auto last(auto& self)
+            -> decltype(flux::last(self.base_))
+        {
+            auto _ = record(self, &instrument_counters::last);
+            return flux::last(self.base_);
+        }
+
+        static constexpr auto for_each_while(auto& self, auto&& pred)
+            -> decltype(flux::for_each_while(self.base_, FLUX_FWD(pred)))
+        {
+            auto* counters = self.counters_;
+            ++counters->for_each_while;
+
+            if (std::is_constant_evaluated() || !counters->timed) {
+                return flux::for_each_while(self.base_, [&](auto&& elem) {
+                    ++counters->elements;
+                    return std::invoke(pred, FLUX_FWD(elem));
+                });
+            }
+
+            // Time the whole loop, and then take off the time spent
+            // downstream in the callback
+            std::uint64_t downstream_ns = 0;
+            auto cur = [&] {
+                auto timer = instrument_timer(counters);
+                return flux::for_each_while(self.base_, [&](auto&& elem) {
+                    ++counters->elements;
+                    auto const before = counters->elapsed_ns;
+                    bool res;
+                    {
+                        auto timer = instrument_timer(counters);
+                        res = std::invoke(pred, FLUX_FWD(elem));
+                    }
+                    downstream_ns += counters->elapsed_ns - before;
+                    counters->elapsed_ns = before;
+                    return res;
+                });
+            }();
+            counters->elapsed_ns -= downstream_ns;
+            return cur;
+        }
+    };
+};
+
+#endif // FLUX_ENABLE_INSTRUMENTATION
+
+struct instrument_fn {
+    template <adaptable_sequence Seq>
+    [[nodiscard]]
+    constexpr auto operator()(Seq&& seq, instrument_counters& counters) const
+    {
+#if FLUX_ENABLE_INSTRUMENTATION
+        return instrument_adaptor<std::decay_t<Seq>>(FLUX_FWD(seq), counters);
+#else
+        (void) counters;
+        return std::decay_t<Seq>(FLUX_FWD(seq));
+#endif
+    }
+};
+
+// Right-aligns str in a column of the given width
+inline auto instrument_report_cell(std::string str, std::size_t width) -> std::string
+{
+    if (str.size() < width) {
+        str.insert(0, width - str.size(), ' ');
+    }
+    return str;
+}
+
+struct instrument_report_fn {
+    template <std::same_as<instrument_counters>... Counters>
+    [[nodiscard]]
+    auto operator()(Counters const&... stages) const -> std::string
+    {
+        constexpr std::size_t name_width = 16;
+        constexpr std::size_t width = 16;
+
+        std::string out = std::string("stage").append(name_width - 5, ' ');
+        for (char const* heading : {"elements", "% of prev", "first", "is_last", "inc",
+                                    "read_at", "for_each_while", "time (us)"}) {
+            out += instrument_report_cell(heading, width);
+        }
+        out += '\n';
+
+        std::uint64_t prev = 0;
+        bool have_prev = false;
+        auto const add_row = [&](instrument_counters const& c) {
+            std::string name = c.name;
+            name.resize((std::max)(name.size(), name_width), ' ');
+            out += name;
+            out += instrument_report_cell(std::to_string(c.elements), width);
+
+            // The proportion of the previous stage's elements which made
+            // it through to this one, to one decimal place
+            std::string pct = "-";
+            if (have_prev && prev > 0) {
+                auto const tenths = (c.elements * 1000 + prev / 2) / prev;
+                pct = std::to_string(tenths / 10) + "." + std::to_string(tenths % 10) + "%";
+            }
+            out += instrument_report_cell(std::move(pct), width);
+
+            for (std::uint64_t n : {c.first, c.is_last, c.inc + c.inc_by,
+                                    c.read_at + c.move_at, c.for_each_while}) {
+                out += instrument_report_cell(std::to_string(n), width);
+            }
+            out += instrument_report_cell(c.timed ? std::to_string(c.elapsed_ns / 1000) : "-",
+                                          width);
+            out += '\n';
+
+            prev = c.elements;
+            have_prev = true;
+        };
+        (add_row(stages), ...);
+
+        return out;
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto instrument = detail::instrument_fn{};
+FLUX_EXPORT inline constexpr auto instrument_report = detail::instrument_report_fn{};
+
+template <typename D>
+constexpr auto inline_sequence_base<D>::instrument(instrument_counters& counters) &&
+{
+    return flux::instrument(std::move(derived()), counters);
+}
+
+} // namespace flux
+
+#endif // FLUX_ADAPTOR_INSTRUMENT_HPP_INCLUDED
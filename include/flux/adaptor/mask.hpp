@@ -78,12 +78,15 @@ public:
             requires maybe_const_iterable<Self>
         static constexpr auto inc(Self& self, cursor_type& cur) -> void
         {
-            while (!flux::is_last(self.base_, flux::inc(self.base_, cur.base_cur)) &&
-                   !flux::is_last(self.mask_, flux::inc(self.mask_, cur.mask_cur))) {
-                if (static_cast<bool>(flux::read_at(self.mask_, cur.mask_cur))) {
-                    break;
-                }
-            }
+            // Always advance both cursors, so that when the sequences have
+            // the same length they reach their ends together and the
+            // cursor compares equal to last()
+            do {
+                flux::inc(self.base_, cur.base_cur);
+                flux::inc(self.mask_, cur.mask_cur);
+            } while (!flux::is_last(self.base_, cur.base_cur) &&
+                     !flux::is_last(self.mask_, cur.mask_cur) &&
+                     !static_cast<bool>(flux::read_at(self.mask_, cur.mask_cur)));
         }
 
         template <typename Self>
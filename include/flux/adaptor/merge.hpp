@@ -0,0 +1,359 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ADAPTOR_MERGE_HPP_INCLUDED
+#define FLUX_ADAPTOR_MERGE_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <flux/adaptor/chain.hpp>
+#include <flux/algorithm/detail/loser_tree.hpp>
+#include <flux/algorithm/for_each.hpp>
+
+#include <array>
+#include <compare>
+#include <functional>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace flux {
+
+namespace detail {
+
+/*
+ * The sources of a merge adaptor provide access to k sorted sequences, and a
+ * cursor into each of them, by runtime index. The cursors are (re)created by
+ * start(), which returns k.
+ */
+
+// The sources of flux::merge(seqs...): a fixed number of sequences, whose
+// types may differ
+template <typename... Bases>
+struct tuple_merge_sources {
+    static constexpr std::size_t extent = sizeof...(Bases);
+
+    using value_type = std::common_type_t<value_t<Bases>...>;
+    using element_type = std::common_reference_t<element_t<Bases>...>;
+    using rvalue_element_type = std::common_reference_t<rvalue_element_t<Bases>...>;
+
+    std::tuple<Bases...> bases;
+    flux::optional<std::tuple<cursor_t<Bases>...>> cursors{};
+
+    constexpr explicit tuple_merge_sources(decays_to<Bases> auto&&... seqs)
+        : bases(FLUX_FWD(seqs)...)
+    {}
+
+    // Calls func(std::integral_constant<std::size_t, idx>{})
+    template <typename R, std::size_t I = 0>
+    static constexpr auto with_index(std::size_t idx, auto&& func) -> R
+    {
+        if constexpr (I + 1 == extent) {
+            return func(std::integral_constant<std::size_t, I>{});
+        } else {
+            if (idx == I) {
+                return func(std::integral_constant<std::size_t, I>{});
+            }
+            return with_index<R, I + 1>(idx, func);
+        }
+    }
+
+    constexpr auto start() -> std::size_t
+    {
+        cursors = std::apply([](auto&... seqs) {
+            return flux::optional<std::tuple<cursor_t<Bases>...>>(
+                std::tuple<cursor_t<Bases>...>(flux::first(seqs)...));
+        }, bases);
+        return extent;
+    }
+
+    constexpr auto is_last(std::size_t idx) -> bool
+    {
+        return with_index<bool>(idx, [this](auto i) {
+            return flux::is_last(std::get<i>(bases), std::get<i>(*cursors));
+        });
+    }
+
+    constexpr auto inc(std::size_t idx) -> void
+    {
+        return with_index<void>(idx, [this](auto i) {
+            flux::inc(std::get<i>(bases), std::get<i>(*cursors));
+        });
+    }
+
+    constexpr auto read_at(std::size_t idx) -> element_type
+    {
+        return with_index<element_type>(idx, [this](auto i) -> element_type {
+            return flux::read_at(std::get<i>(bases), std::get<i>(*cursors));
+        });
+    }
+
+    constexpr auto move_at(std::size_t idx) -> rvalue_element_type
+    {
+        return with_index<rvalue_element_type>(idx, [this](auto i) -> rvalue_element_type {
+            return flux::move_at(std::get<i>(bases), std::get<i>(*cursors));
+        });
+    }
+};
+
+// If the elements of a sequence of sequences are lvalues, refer to them;
+// otherwise, take ownership of them
+template <typename Outer>
+using merge_inner_t =
+    std::conditional_t<std::is_lvalue_reference_v<element_t<Outer>>,
+                       ref_adaptor<std::remove_reference_t<element_t<Outer>>>,
+                       std::remove_cvref_t<element_t<Outer>>>;
+
+// The sources of flux::merge_all(seqs): the elements of a sequence of
+// sequences, which are collected when iteration starts
+template <typename Outer>
+struct vector_merge_sources {
+    using inner_t = merge_inner_t<Outer>;
+
+    static constexpr std::size_t extent = std::dynamic_extent;
+
+    using value_type = value_t<inner_t>;
+    using element_type = element_t<inner_t>;
+    using rvalue_element_type = rvalue_element_t<inner_t>;
+
+    struct source {
+        inner_t seq;
+        cursor_t<inner_t> cur;
+
+        constexpr explicit source(inner_t&& s)
+            : seq(std::move(s)),
+              cur(flux::first(seq))
+        {}
+    };
+
+    Outer outer;
+    std::vector<source> sources{};
+
+    constexpr explicit vector_merge_sources(decays_to<Outer> auto&& seqs)
+        : outer(FLUX_FWD(seqs))
+    {}
+
+    constexpr auto start() -> std::size_t
+    {
+        sources.clear();
+        if constexpr (sized_sequence<Outer>) {
+            sources.reserve(num::checked_cast<std::size_t>(flux::size(outer)));
+        }
+        flux::for_each(outer, [this](auto&& inner) {
+            sources.emplace_back(inner_t(FLUX_FWD(inner)));
+        });
+        return sources.size();
+    }
+
+    constexpr auto is_last(std::size_t idx) -> bool
+    {
+        return flux::is_last(sources[idx].seq, sources[idx].cur);
+    }
+
+    constexpr auto inc(std::size_t idx) -> void
+    {
+        flux::inc(sources[idx].seq, sources[idx].cur);
+    }
+
+    constexpr auto read_at(std::size_t idx) -> element_type
+    {
+        return flux::read_at(sources[idx].seq, sources[idx].cur);
+    }
+
+    constexpr auto move_at(std::size_t idx) -> rvalue_element_type
+    {
+        return flux::move_at(sources[idx].seq, sources[idx].cur);
+    }
+};
+
+/*
+ * Merges k sorted sources using a loser tree, so that each element costs
+ * about log2(k) comparisons. Elements which compare equal are yielded in
+ * the order of their sources, so the merge is stable.
+ *
+ * The loser tree and the cursors into each source are stored in the adaptor
+ * itself, so the merged sequence is single-pass.
+ */
+template <typename Sources, typename Cmp>
+struct merge_adaptor : inline_sequence_base<merge_adaptor<Sources, Cmp>> {
+private:
+    using element_type = typename Sources::element_type;
+
+    // When the elements of the sources are lvalues, we keep a pointer to the
+    // current element of each source (or null once it is exhausted), so that
+    // each comparison is two loads rather than a trip through both sources
+    static constexpr bool cache_heads = std::is_lvalue_reference_v<element_type>;
+
+    using head_ptr = std::add_pointer_t<element_type>;
+    struct no_heads {};
+    using heads_t = std::conditional_t<
+        !cache_heads, no_heads,
+        std::conditional_t<Sources::extent == std::dynamic_extent,
+                           std::vector<head_ptr>,
+                           std::array<head_ptr, Sources::extent>>>;
+
+    Sources sources_;
+    FLUX_NO_UNIQUE_ADDRESS Cmp cmp_;
+    loser_tree<Sources::extent> tree_{};
+    FLUX_NO_UNIQUE_ADDRESS heads_t heads_{};
+    std::size_t num_sources_ = 0;
+
+    constexpr auto update_head(std::size_t idx) -> void
+    {
+        if constexpr (cache_heads) {
+            heads_[idx] = sources_.is_last(idx) ? nullptr
+                                                : std::addressof(sources_.read_at(idx));
+        }
+    }
+
+    // Returns true if source a should be selected before source b
+    constexpr auto beats(std::size_t a, std::size_t b) -> bool
+    {
+        if constexpr (cache_heads) {
+            head_ptr pa = heads_[a];
+            head_ptr pb = heads_[b];
+            if (pa == nullptr) {
+                return false;
+            } else if (pb == nullptr) {
+                return true;
+            }
+            std::weak_ordering r = std::invoke(cmp_, *pa, *pb);
+            return r < 0 || (r == 0 && a < b);
+        } else {
+            if (sources_.is_last(a)) {
+                return false;
+            } else if (sources_.is_last(b)) {
+                return true;
+            }
+            std::weak_ordering r = std::invoke(cmp_, sources_.read_at(a), sources_.read_at(b));
+            return r < 0 || (r == 0 && a < b);
+        }
+    }
+
+public:
+    constexpr merge_adaptor(Sources&& sources, Cmp cmp)
+        : sources_(std::move(sources)),
+          cmp_(std::move(cmp))
+    {}
+
+    merge_adaptor(merge_adaptor&&) = default;
+    merge_adaptor& operator=(merge_adaptor&&) = default;
+
+    struct flux_sequence_traits : default_sequence_traits {
+    private:
+        struct cursor_type {
+            cursor_type(cursor_type&&) = default;
+            cursor_type& operator=(cursor_type&&) = default;
+
+        private:
+            friend struct flux_sequence_traits;
+            constexpr cursor_type() = default;
+        };
+
+        using self_t = merge_adaptor;
+
+        static constexpr auto beats_fn(self_t& self)
+        {
+            return [&self](std::size_t a, std::size_t b) { return self.beats(a, b); };
+        }
+
+    public:
+        using value_type = typename Sources::value_type;
+
+        static constexpr auto first(self_t& self) -> cursor_type
+        {
+            self.num_sources_ = self.sources_.start();
+            if constexpr (Sources::extent == std::dynamic_extent) {
+                self.tree_ = loser_tree<>(self.num_sources_);
+                if constexpr (cache_heads) {
+                    self.heads_.resize(self.num_sources_);
+                }
+            }
+            for (std::size_t i = 0; i < self.num_sources_; i++) {
+                self.update_head(i);
+            }
+            self.tree_.build(beats_fn(self));
+            return cursor_type{};
+        }
+
+        static constexpr auto is_last(self_t& self, cursor_type const&) -> bool
+        {
+            if constexpr (cache_heads) {
+                return self.num_sources_ == 0 || self.heads_[self.tree_.winner()] == nullptr;
+            } else {
+                return self.num_sources_ == 0 || self.sources_.is_last(self.tree_.winner());
+            }
+        }
+
+        static constexpr auto inc(self_t& self, cursor_type&) -> void
+        {
+            std::size_t const w = self.tree_.winner();
+            self.sources_.inc(w);
+            self.update_head(w);
+            self.tree_.replay(beats_fn(self));
+        }
+
+        static constexpr auto read_at(self_t& self, cursor_type const&)
+            -> typename Sources::element_type
+        {
+            if constexpr (cache_heads) {
+                return *self.heads_[self.tree_.winner()];
+            } else {
+                return self.sources_.read_at(self.tree_.winner());
+            }
+        }
+
+        static constexpr auto move_at(self_t& self, cursor_type const&)
+            -> typename Sources::rvalue_element_type
+        {
+            return self.sources_.move_at(self.tree_.winner());
+        }
+    };
+};
+
+struct merge_fn {
+    template <adaptable_sequence... Seqs>
+        requires (sizeof...(Seqs) >= 1) &&
+                 chainable<Seqs...> &&
+                 ordering_invocable<std::compare_three_way&,
+                                    std::common_reference_t<element_t<Seqs>...>,
+                                    std::common_reference_t<element_t<Seqs>...>,
+                                    std::weak_ordering>
+    [[nodiscard]]
+    constexpr auto operator()(Seqs&&... seqs) const -> sequence auto
+    {
+        if constexpr (sizeof...(Seqs) == 1) {
+            return std::forward<Seqs...>(seqs...);
+        } else {
+            using sources_t = tuple_merge_sources<std::decay_t<Seqs>...>;
+            return merge_adaptor<sources_t, std::compare_three_way>(
+                sources_t(FLUX_FWD(seqs)...), std::compare_three_way{});
+        }
+    }
+};
+
+struct merge_all_fn {
+    template <adaptable_sequence Seqs, typename Cmp = std::compare_three_way>
+        requires sequence<merge_inner_t<Seqs>> &&
+                 std::constructible_from<merge_inner_t<Seqs>, element_t<Seqs>> &&
+                 ordering_invocable<Cmp&, element_t<merge_inner_t<Seqs>>,
+                                    element_t<merge_inner_t<Seqs>>, std::weak_ordering>
+    [[nodiscard]]
+    constexpr auto operator()(Seqs&& seqs, Cmp cmp = Cmp{}) const -> sequence auto
+    {
+        using sources_t = vector_merge_sources<std::decay_t<Seqs>>;
+        return merge_adaptor<sources_t, Cmp>(sources_t(FLUX_FWD(seqs)), std::move(cmp));
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto merge = detail::merge_fn{};
+FLUX_EXPORT inline constexpr auto merge_all = detail::merge_all_fn{};
+
+} // namespace flux
+
+#endif // FLUX_ADAPTOR_MERGE_HPP_INCLUDED
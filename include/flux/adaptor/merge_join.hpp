@@ -0,0 +1,206 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ADAPTOR_MERGE_JOIN_HPP_INCLUDED
+#define FLUX_ADAPTOR_MERGE_JOIN_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <flux/algorithm/detail/gallop.hpp>
+
+#include <compare>
+#include <functional>
+#include <utility>
+
+namespace flux {
+
+namespace detail {
+
+/*
+ * Yields every pair of elements from two sequences sorted by key whose keys
+ * are equivalent. When a run of equal keys appears on both sides, the output
+ * is the cross product of the two runs: for each element of the run in Base1,
+ * the run in Base2 is replayed from its start, which is why Base2 must be
+ * multipass.
+ */
+template <typename Base1, typename Base2, typename Key1, typename Key2, typename Cmp>
+struct merge_join_adaptor
+    : inline_sequence_base<merge_join_adaptor<Base1, Base2, Key1, Key2, Cmp>> {
+private:
+    FLUX_NO_UNIQUE_ADDRESS Base1 base1_;
+    FLUX_NO_UNIQUE_ADDRESS Base2 base2_;
+    FLUX_NO_UNIQUE_ADDRESS Key1 key1_;
+    FLUX_NO_UNIQUE_ADDRESS Key2 key2_;
+    FLUX_NO_UNIQUE_ADDRESS Cmp cmp_;
+
+public:
+    constexpr merge_join_adaptor(decays_to<Base1> auto&& base1, decays_to<Base2> auto&& base2,
+                                 Key1 key1, Key2 key2, Cmp cmp)
+        : base1_(FLUX_FWD(base1)),
+          base2_(FLUX_FWD(base2)),
+          key1_(std::move(key1)),
+          key2_(std::move(key2)),
+          cmp_(std::move(cmp))
+    {}
+
+    struct flux_sequence_traits : default_sequence_traits {
+    private:
+        struct cursor_type {
+            cursor_t<Base1> base1_cursor;
+            cursor_t<Base2> base2_cursor;
+            // The start of the run of elements in base2 matching base1_cursor
+            cursor_t<Base2> run_start;
+
+            friend auto operator==(cursor_type const&, cursor_type const&) -> bool
+                requires std::equality_comparable<cursor_t<Base1>>
+                = default;
+        };
+
+        template <typename Self>
+        static inline constexpr bool maybe_const_iterable
+            = std::is_const_v<Self> ? (flux::sequence<Base1 const> && flux::sequence<Base2 const>) : true;
+
+        template <typename Self>
+        static constexpr auto compare(Self& self, cursor_t<Base1> const& cur1,
+                                      cursor_t<Base2> const& cur2) -> std::weak_ordering
+        {
+            return std::invoke(self.cmp_,
+                               std::invoke(self.key1_, flux::read_at(self.base1_, cur1)),
+                               std::invoke(self.key2_, flux::read_at(self.base2_, cur2)));
+        }
+
+        // Advances both cursors to the next pair of elements with equivalent
+        // keys. If one input is much longer than the other, unmatched elements
+        // in the longer one are skipped using galloping search.
+        template <typename Self>
+        static constexpr void update(Self& self, cursor_type& cur) {
+            using B1 = std::remove_reference_t<decltype((self.base1_))>;
+            using B2 = std::remove_reference_t<decltype((self.base2_))>;
+
+            auto const side = choose_gallop_side(self.base1_, cur.base1_cursor,
+                                                 self.base2_, cur.base2_cursor);
+
+            while (!flux::is_last(self.base1_, cur.base1_cursor) &&
+                   !flux::is_last(self.base2_, cur.base2_cursor)) {
+                auto&& elem1 = flux::read_at(self.base1_, cur.base1_cursor);
+                auto&& elem2 = flux::read_at(self.base2_, cur.base2_cursor);
+                std::weak_ordering r = std::invoke(self.cmp_, std::invoke(self.key1_, elem1),
+                                                   std::invoke(self.key2_, elem2));
+
+                if (r == std::weak_ordering::less) {
+                    if constexpr (gallopable_sequence<B1> && gallopable_sequence<B2>) {
+                        if (side == gallop_side::first) {
+                            gallop(self.base1_, cur.base1_cursor, [&](auto&& e) {
+                                return std::invoke(self.cmp_, std::invoke(self.key1_, FLUX_FWD(e)),
+                                                   std::invoke(self.key2_, elem2)) ==
+                                       std::weak_ordering::less;
+                            });
+                            continue;
+                        }
+                    }
+                    flux::inc(self.base1_, cur.base1_cursor);
+                } else if (r == std::weak_ordering::greater) {
+                    if constexpr (gallopable_sequence<B1> && gallopable_sequence<B2>) {
+                        if (side == gallop_side::second) {
+                            gallop(self.base2_, cur.base2_cursor, [&](auto&& e) {
+                                return std::invoke(self.cmp_, std::invoke(self.key1_, elem1),
+                                                   std::invoke(self.key2_, FLUX_FWD(e))) ==
+                                       std::weak_ordering::greater;
+                            });
+                            continue;
+                        }
+                    }
+                    flux::inc(self.base2_, cur.base2_cursor);
+                } else {
+                    cur.run_start = cur.base2_cursor;
+                    return;
+                }
+            }
+        }
+
+    public:
+        using value_type = std::pair<value_t<Base1>, value_t<Base2>>;
+
+        static constexpr bool disable_multipass = !multipass_sequence<Base1>;
+
+        template <typename Self>
+            requires maybe_const_iterable<Self>
+        static constexpr auto first(Self& self) -> cursor_type
+        {
+            auto cur2 = flux::first(self.base2_);
+            auto cur = cursor_type{.base1_cursor = flux::first(self.base1_),
+                                   .base2_cursor = cur2,
+                                   .run_start = cur2};
+            update(self, cur);
+            return cur;
+        }
+
+        template <typename Self>
+            requires maybe_const_iterable<Self>
+        static constexpr auto is_last(Self& self, cursor_type const& cur) -> bool
+        {
+            return flux::is_last(self.base1_, cur.base1_cursor) ||
+                   flux::is_last(self.base2_, cur.base2_cursor);
+        }
+
+        template <typename Self>
+            requires maybe_const_iterable<Self>
+        static constexpr auto inc(Self& self, cursor_type& cur) -> void
+        {
+            // Move along the run in base2
+            flux::inc(self.base2_, cur.base2_cursor);
+            if (!flux::is_last(self.base2_, cur.base2_cursor) &&
+                compare(self, cur.base1_cursor, cur.base2_cursor) == std::weak_ordering::equivalent) {
+                return;
+            }
+
+            // Reached the end of the run: if the next element of base1 has
+            // the same key, replay the run for it
+            flux::inc(self.base1_, cur.base1_cursor);
+            if (!flux::is_last(self.base1_, cur.base1_cursor) &&
+                compare(self, cur.base1_cursor, cur.run_start) == std::weak_ordering::equivalent) {
+                cur.base2_cursor = cur.run_start;
+                return;
+            }
+
+            update(self, cur);
+        }
+
+        template <typename Self>
+            requires maybe_const_iterable<Self>
+        static constexpr auto read_at(Self& self, cursor_type const& cur)
+            -> std::pair<decltype(flux::read_at(self.base1_, cur.base1_cursor)),
+                         decltype(flux::read_at(self.base2_, cur.base2_cursor))>
+        {
+            return {flux::read_at(self.base1_, cur.base1_cursor),
+                    flux::read_at(self.base2_, cur.base2_cursor)};
+        }
+    };
+};
+
+struct merge_join_fn {
+    template <adaptable_sequence Seq1, adaptable_sequence Seq2,
+              typename Key1, typename Key2, typename Cmp = std::compare_three_way>
+        requires multipass_sequence<Seq2> &&
+                 std::regular_invocable<Key1&, element_t<Seq1>> &&
+                 std::regular_invocable<Key2&, element_t<Seq2>> &&
+                 ordering_invocable<Cmp&, std::invoke_result_t<Key1&, element_t<Seq1>>,
+                                    std::invoke_result_t<Key2&, element_t<Seq2>>,
+                                    std::weak_ordering>
+    [[nodiscard]]
+    constexpr auto operator()(Seq1&& seq1, Seq2&& seq2, Key1 key1, Key2 key2,
+                              Cmp cmp = {}) const -> sequence auto
+    {
+        return merge_join_adaptor<std::decay_t<Seq1>, std::decay_t<Seq2>, Key1, Key2, Cmp>(
+            FLUX_FWD(seq1), FLUX_FWD(seq2), std::move(key1), std::move(key2), std::move(cmp));
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto merge_join = detail::merge_join_fn{};
+
+} // namespace flux
+
+#endif // FLUX_ADAPTOR_MERGE_JOIN_HPP_INCLUDED
@@ -126,7 +126,7 @@ public:
 
             while (cur != end) {
                 flux::dec(self.base_, cur);
-                if (!std::invoke(pred, flux::read_at(self.base_, cur))) {
+                if (!std::invoke(pred, flux::read_at_unchecked(self.base_, cur))) {
                     flux::inc(self.base_, cur);
                     break;
                 }
@@ -8,6 +8,8 @@
 
 #include <flux/core.hpp>
 
+#include <flux/algorithm/detail/gallop.hpp>
+
 #include <utility>
 
 namespace flux::detail {
@@ -179,7 +181,22 @@ public:
             = std::is_const_v<Self> ? (flux::sequence<Base1 const> && flux::sequence<Base2 const>) : true;
 
         template <typename Self>
-        static constexpr void update(Self& self, cursor_type& cur) {
+        static constexpr auto gallop_side_for(Self& self, cursor_type const& cur) -> gallop_side
+        {
+            return choose_gallop_side(self.base1_, cur.base1_cursor,
+                                      self.base2_, cur.base2_cursor);
+        }
+
+        template <typename Self>
+        static constexpr void update(Self& self, cursor_type& cur, gallop_side side) {
+            // If seq2 is much longer than seq1, most of its elements will be
+            // skipped: use galloping search to skip them in bulk
+            if constexpr (gallopable_sequence<std::remove_reference_t<decltype((self.base2_))>>) {
+                if (side == gallop_side::second) {
+                    return update_galloping(self, cur);
+                }
+            }
+
             while(not flux::is_last(self.base1_, cur.base1_cursor))
             {
                 if(flux::is_last(self.base2_, cur.base2_cursor)) {
@@ -199,6 +216,31 @@ public:
             }
         }
 
+        template <typename Self>
+        static constexpr void update_galloping(Self& self, cursor_type& cur) {
+            while(not flux::is_last(self.base1_, cur.base1_cursor))
+            {
+                if(flux::is_last(self.base2_, cur.base2_cursor)) {
+                    return;
+                }
+
+                auto&& elem1 = flux::read_at(self.base1_, cur.base1_cursor);
+                auto r = std::invoke(self.cmp_, elem1, flux::read_at(self.base2_, cur.base2_cursor));
+
+                if (r == std::weak_ordering::less) {
+                    return;
+                } else if (r == std::weak_ordering::equivalent) {
+                    flux::inc(self.base1_, cur.base1_cursor);
+                    flux::inc(self.base2_, cur.base2_cursor);
+                } else {
+                    gallop(self.base2_, cur.base2_cursor, [&](auto&& elem2) {
+                        return std::invoke(self.cmp_, elem1, FLUX_FWD(elem2)) ==
+                               std::weak_ordering::greater;
+                    });
+                }
+            }
+        }
+
     public:
         using value_type = value_t<Base1>;
 
@@ -210,7 +252,7 @@ public:
         {
             auto cur = cursor_type{.base1_cursor = flux::first(self.base1_),
                                    .base2_cursor = flux::first(self.base2_)};
-            update(self, cur);
+            update(self, cur, gallop_side_for(self, cur));
             return cur;
         }
 
@@ -226,7 +268,26 @@ public:
         static constexpr auto inc(Self& self, cursor_type& cur) -> void
         {
             flux::inc(self.base1_, cur.base1_cursor);
-            update(self, cur);
+            update(self, cur, gallop_side_for(self, cur));
+        }
+
+        // Chooses whether to gallop once, rather than before every element
+        template <typename Self>
+            requires maybe_const_iterable<Self>
+        static constexpr auto for_each_while(Self& self, auto&& pred) -> cursor_type
+        {
+            auto cur = cursor_type{.base1_cursor = flux::first(self.base1_),
+                                   .base2_cursor = flux::first(self.base2_)};
+            auto const side = gallop_side_for(self, cur);
+            update(self, cur, side);
+            while (!flux::is_last(self.base1_, cur.base1_cursor)) {
+                if (!std::invoke(pred, flux::read_at(self.base1_, cur.base1_cursor))) {
+                    break;
+                }
+                flux::inc(self.base1_, cur.base1_cursor);
+                update(self, cur, side);
+            }
+            return cur;
         }
 
         template <typename Self>
@@ -432,7 +493,24 @@ public:
             = std::is_const_v<Self> ? (flux::sequence<Base1 const> && flux::sequence<Base2 const>) : true;
 
         template <typename Self>
-        static constexpr void update(Self& self, cursor_type& cur) {
+        static constexpr auto gallop_side_for(Self& self, cursor_type const& cur) -> gallop_side
+        {
+            return choose_gallop_side(self.base1_, cur.base1_cursor,
+                                      self.base2_, cur.base2_cursor);
+        }
+
+        template <typename Self>
+        static constexpr void update(Self& self, cursor_type& cur, gallop_side side) {
+            // If one sequence is much longer than the other, most of its
+            // elements will be skipped: use galloping search to skip them in
+            // bulk. The side is only ever chosen if both are gallopable.
+            if constexpr (gallopable_sequence<std::remove_reference_t<decltype((self.base1_))>> &&
+                          gallopable_sequence<std::remove_reference_t<decltype((self.base2_))>>) {
+                if (side != gallop_side::neither) {
+                    return update_galloping(self, cur, side);
+                }
+            }
+
             while(not flux::is_last(self.base1_, cur.base1_cursor) &&
                   not flux::is_last(self.base2_, cur.base2_cursor))
             {
@@ -449,6 +527,39 @@ public:
             }
         }
 
+        template <typename Self>
+        static constexpr void update_galloping(Self& self, cursor_type& cur, gallop_side side) {
+            while(not flux::is_last(self.base1_, cur.base1_cursor) &&
+                  not flux::is_last(self.base2_, cur.base2_cursor))
+            {
+                auto&& elem1 = flux::read_at(self.base1_, cur.base1_cursor);
+                auto&& elem2 = flux::read_at(self.base2_, cur.base2_cursor);
+                auto r = std::invoke(self.cmp_, elem1, elem2);
+
+                if (r == std::weak_ordering::less) {
+                    if (side == gallop_side::first) {
+                        gallop(self.base1_, cur.base1_cursor, [&](auto&& e) {
+                            return std::invoke(self.cmp_, FLUX_FWD(e), elem2) ==
+                                   std::weak_ordering::less;
+                        });
+                    } else {
+                        flux::inc(self.base1_, cur.base1_cursor);
+                    }
+                } else if (r == std::weak_ordering::greater) {
+                    if (side == gallop_side::second) {
+                        gallop(self.base2_, cur.base2_cursor, [&](auto&& e) {
+                            return std::invoke(self.cmp_, elem1, FLUX_FWD(e)) ==
+                                   std::weak_ordering::greater;
+                        });
+                    } else {
+                        flux::inc(self.base2_, cur.base2_cursor);
+                    }
+                } else {
+                    return;
+                }
+            }
+        }
+
     public:
         using value_type = value_t<Base1>;
 
@@ -460,7 +571,7 @@ public:
         {
             auto cur = cursor_type{.base1_cursor = flux::first(self.base1_),
                                    .base2_cursor = flux::first(self.base2_)};
-            update(self, cur);
+            update(self, cur, gallop_side_for(self, cur));
             return cur;
         }
 
@@ -478,7 +589,27 @@ public:
         {
             flux::inc(self.base1_, cur.base1_cursor);
             flux::inc(self.base2_, cur.base2_cursor);
-            update(self, cur);
+            update(self, cur, gallop_side_for(self, cur));
+        }
+
+        // Chooses whether to gallop once, rather than before every element
+        template <typename Self>
+            requires maybe_const_iterable<Self>
+        static constexpr auto for_each_while(Self& self, auto&& pred) -> cursor_type
+        {
+            auto cur = cursor_type{.base1_cursor = flux::first(self.base1_),
+                                   .base2_cursor = flux::first(self.base2_)};
+            auto const side = gallop_side_for(self, cur);
+            update(self, cur, side);
+            while (!is_last(self, cur)) {
+                if (!std::invoke(pred, flux::read_at(self.base1_, cur.base1_cursor))) {
+                    break;
+                }
+                flux::inc(self.base1_, cur.base1_cursor);
+                flux::inc(self.base2_, cur.base2_cursor);
+                update(self, cur, side);
+            }
+            return cur;
         }
 
         template <typename Self>
@@ -49,8 +49,7 @@ public:
         static constexpr bool is_infinite = infinite_sequence<Base>;
 
         static constexpr auto first(auto& self) -> cursor_type
-            requires sequence<decltype((self.base_))> &&
-                     splitter_for<decltype((self.splitter_)), decltype((self.base_))>
+            requires splitter_for<decltype((self.splitter_)), decltype((self.base_))>
         {
             auto fst = flux::first(self.base_);
             auto bounds = self.splitter_(flux::slice(self.base_, fst, flux::last));
@@ -237,16 +237,33 @@ public:
         static constexpr auto for_each_while(auto& self, auto&& pred) -> cursor_type
             requires sequence<decltype((self.base_))>
         {
-            distance_t n = self.stride_;
-            auto c = flux::for_each_while(self.base_, [&n, &pred, s = self.stride_](auto&& elem) {
-                if (++n < s) {
-                    return true;
-                } else {
-                    n = 0;
-                    return std::invoke(pred, FLUX_FWD(elem));
+            // With a random-access base we can jump straight to each element,
+            // rather than visiting the ones in between. Every cursor read is
+            // short of the end, so the reads don't need to be checked.
+            if constexpr (random_access_sequence<decltype((self.base_))> &&
+                          bounded_sequence<decltype((self.base_))> &&
+                          sized_sequence<decltype((self.base_))>) {
+                auto const first = flux::first(self.base_);
+                distance_t const n = size(self);
+                for (distance_t i = 0; i < n; ++i) {
+                    auto cur = flux::next(self.base_, first, i * self.stride_);
+                    if (!std::invoke(pred, flux::read_at_unchecked(self.base_, cur))) {
+                        return cursor_type{std::move(cur), 0};
+                    }
                 }
-            });
-            return cursor_type{std::move(c), (n + 1) % self.stride_};
+                return last(self);
+            } else {
+                distance_t n = self.stride_;
+                auto c = flux::for_each_while(self.base_, [&n, &pred, s = self.stride_](auto&& elem) {
+                    if (++n < s) {
+                        return true;
+                    } else {
+                        n = 0;
+                        return std::invoke(pred, FLUX_FWD(elem));
+                    }
+                });
+                return cursor_type{std::move(c), (n + 1) % self.stride_};
+            }
         }
     };
 };
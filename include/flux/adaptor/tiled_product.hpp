@@ -0,0 +1,245 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ADAPTOR_TILED_PRODUCT_HPP_INCLUDED
+#define FLUX_ADAPTOR_TILED_PRODUCT_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <array>
+#include <tuple>
+
+namespace flux {
+
+namespace detail {
+
+/*
+ * The cartesian product of some random-access sequences, visited one tile
+ * at a time: the tiles are visited in row-major order, and so are the
+ * points within each tile. The tiles at the far edge of each dimension are
+ * cut short if the tile size doesn't divide the size of that dimension.
+ *
+ * Cursors are the index of the current point in each dimension.
+ */
+template <sequence... Bases>
+struct tiled_product_adaptor : inline_sequence_base<tiled_product_adaptor<Bases...>> {
+private:
+    static constexpr std::size_t rank = sizeof...(Bases);
+
+    FLUX_NO_UNIQUE_ADDRESS std::tuple<Bases...> bases_;
+    std::array<distance_t, rank> tiles_;
+
+public:
+    constexpr tiled_product_adaptor(std::array<distance_t, rank> const& tiles,
+                                    decays_to<Bases> auto&&... bases)
+        : bases_(FLUX_FWD(bases)...),
+          tiles_(tiles)
+    {}
+
+    struct flux_sequence_traits : default_sequence_traits {
+    private:
+        using cursor_type = std::array<distance_t, rank>;
+
+        template <typename From, typename To>
+        using const_like_t = std::conditional_t<std::is_const_v<From>, To const, To>;
+
+        template <typename Self>
+        static constexpr bool usable = (random_access_sequence<const_like_t<Self, Bases>> && ...) &&
+                                       (sized_sequence<const_like_t<Self, Bases>> && ...);
+
+        static constexpr auto sizes(auto& self) -> cursor_type
+        {
+            return std::apply([](auto&... bases) {
+                return cursor_type{flux::size(bases)...};
+            }, self.bases_);
+        }
+
+        template <typename Self>
+        static constexpr auto read_(auto& fn, Self& self, cursor_type const& cur)
+        {
+            auto read1 = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) -> decltype(auto) {
+                auto& base = std::get<I>(self.bases_);
+                return fn(base, flux::next(base, flux::first(base), cur[I]));
+            };
+
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return std::tuple<decltype(read1(std::integral_constant<std::size_t, I>{}))...>(
+                    read1(std::integral_constant<std::size_t, I>{})...);
+            }(std::make_index_sequence<rank>{});
+        }
+
+        // Level I < rank loops over the tiles of dimension I, and level
+        // rank + I over the points of dimension I in the current tile
+        template <std::size_t Level, typename Self>
+        static constexpr auto for_each_while_impl(Self& self, cursor_type const& sz,
+                                                  cursor_type& tile_first, cursor_type& tile_end,
+                                                  cursor_type& cur, auto& pred) -> bool
+        {
+            if constexpr (Level < rank) {
+                distance_t const tile = self.tiles_[Level];
+                for (distance_t t = 0; t < sz[Level]; t += tile) {
+                    tile_first[Level] = t;
+                    tile_end[Level] = sz[Level] - t < tile ? sz[Level] : t + tile;
+                    if (!for_each_while_impl<Level + 1>(self, sz, tile_first, tile_end, cur, pred)) {
+                        return false;
+                    }
+                    if (sz[Level] - t <= tile) {
+                        break;
+                    }
+                }
+                return true;
+            } else if constexpr (Level < 2 * rank) {
+                constexpr std::size_t dim = Level - rank;
+                for (cur[dim] = tile_first[dim]; cur[dim] < tile_end[dim]; ++cur[dim]) {
+                    if (!for_each_while_impl<Level + 1>(self, sz, tile_first, tile_end, cur, pred)) {
+                        return false;
+                    }
+                }
+                return true;
+            } else {
+                return std::invoke(pred, read_(flux::read_at_unchecked, self, cur));
+            }
+        }
+
+    public:
+        using value_type = std::tuple<value_t<Bases>...>;
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto first(Self& self) -> cursor_type
+        {
+            auto const sz = sizes(self);
+            for (distance_t s : sz) {
+                if (s == 0) {
+                    return last(self);
+                }
+            }
+            return cursor_type{};
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto is_last(Self& self, cursor_type const& cur) -> bool
+        {
+            return cur[0] >= flux::size(std::get<0>(self.bases_));
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto inc(Self& self, cursor_type& cur) -> void
+        {
+            auto const sz = sizes(self);
+
+            // Move to the next point in the current tile...
+            for (std::size_t d = rank; d-- > 0;) {
+                distance_t const tile_first = cur[d] - cur[d] % self.tiles_[d];
+                distance_t const tile_end = sz[d] - tile_first < self.tiles_[d]
+                                                ? sz[d] : tile_first + self.tiles_[d];
+                if (++cur[d] < tile_end) {
+                    return;
+                }
+                cur[d] = tile_first;
+            }
+
+            // ...or to the first point of the next tile
+            for (std::size_t d = rank; d-- > 0;) {
+                if (sz[d] - cur[d] > self.tiles_[d]) {
+                    cur[d] += self.tiles_[d];
+                    return;
+                }
+                cur[d] = 0;
+            }
+
+            cur = last(self);
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto read_at(Self& self, cursor_type const& cur)
+        {
+            return read_(flux::read_at, self, cur);
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto move_at(Self& self, cursor_type const& cur)
+        {
+            return read_(flux::move_at, self, cur);
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto read_at_unchecked(Self& self, cursor_type const& cur)
+        {
+            return read_(flux::read_at_unchecked, self, cur);
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto move_at_unchecked(Self& self, cursor_type const& cur)
+        {
+            return read_(flux::move_at_unchecked, self, cur);
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto last(Self& self) -> cursor_type
+        {
+            cursor_type cur{};
+            cur[0] = flux::size(std::get<0>(self.bases_));
+            return cur;
+        }
+
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto size(Self& self) -> distance_t
+        {
+            distance_t res = 1;
+            for (distance_t s : sizes(self)) {
+                res = num::mul(res, s);
+            }
+            return res;
+        }
+
+        // A loop nest two levels deep per dimension, with the points of each
+        // tile visited by the innermost loops
+        template <typename Self>
+            requires usable<Self>
+        static constexpr auto for_each_while(Self& self, auto&& pred) -> cursor_type
+        {
+            auto const sz = sizes(self);
+            cursor_type tile_first{};
+            cursor_type tile_end{};
+            cursor_type cur{};
+            if (for_each_while_impl<0>(self, sz, tile_first, tile_end, cur, pred)) {
+                return last(self);
+            }
+            return cur;
+        }
+    };
+};
+
+struct tiled_product_fn {
+    template <num::integral Int, std::size_t N, adaptable_sequence... Seqs>
+        requires (N == sizeof...(Seqs) && N > 0) &&
+                 ((random_access_sequence<Seqs> && sized_sequence<Seqs>) && ...)
+    [[nodiscard]]
+    constexpr auto operator()(std::array<Int, N> const& tile_sizes, Seqs&&... seqs) const
+    {
+        std::array<distance_t, N> tiles{};
+        for (std::size_t i = 0; i < N; ++i) {
+            FLUX_ASSERT(tile_sizes[i] > 0);
+            tiles[i] = num::checked_cast<distance_t>(tile_sizes[i]);
+        }
+        return tiled_product_adaptor<std::decay_t<Seqs>...>(tiles, FLUX_FWD(seqs)...);
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto tiled_product = detail::tiled_product_fn{};
+
+} // namespace flux
+
+#endif // FLUX_ADAPTOR_TILED_PRODUCT_HPP_INCLUDED
@@ -129,6 +129,13 @@ public:
             return std::min({flux::size(args)...});
         }, self.bases_);
     }
+
+    template <typename Self>
+        requires (sequence<const_like_t<Self, Bases>> && ...)
+    static constexpr auto for_each_while(Self& self, auto&& pred) -> cursor_t<Self>
+    {
+        return detail::for_each_while_unchecked(self, FLUX_FWD(pred));
+    }
 };
 
 
@@ -6,6 +6,7 @@
 #ifndef FLUX_ALGORITHM_HPP_INCLUDED
 #define FLUX_ALGORITHM_HPP_INCLUDED
 
+#include <flux/algorithm/aggregate_by.hpp>
 #include <flux/algorithm/all_any_none.hpp>
 #include <flux/algorithm/compare.hpp>
 #include <flux/algorithm/contains.hpp>
@@ -17,9 +18,11 @@
 #include <flux/algorithm/find_min_max.hpp>
 #include <flux/algorithm/fold.hpp>
 #include <flux/algorithm/for_each.hpp>
+#include <flux/algorithm/histogram.hpp>
 #include <flux/algorithm/inplace_reverse.hpp>
 #include <flux/algorithm/minmax.hpp>
 #include <flux/algorithm/output_to.hpp>
+#include <flux/algorithm/quantiles.hpp>
 #include <flux/algorithm/search.hpp>
 #include <flux/algorithm/sort.hpp>
 #include <flux/algorithm/starts_with.hpp>
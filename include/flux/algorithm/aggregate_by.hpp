@@ -0,0 +1,92 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_AGGREGATE_BY_HPP_INCLUDED
+#define FLUX_ALGORITHM_AGGREGATE_BY_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <flux/algorithm/detail/flat_hash_table.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+FLUX_EXPORT
+template <typename Seq, typename KeyFn>
+using aggregate_key_t = std::decay_t<std::invoke_result_t<KeyFn&, element_t<Seq>&>>;
+
+namespace detail {
+
+// When pre-sizing the table from a sized sequence, don't reserve more than
+// this many groups up front: the number of distinct keys is often far smaller
+// than the number of elements, and an oversized table wastes cache.
+inline constexpr std::size_t aggregate_by_max_reserve = 4096;
+
+struct pair_first_fn {
+    template <typename Pair>
+    constexpr auto operator()(Pair const& pair) const -> auto const&
+    {
+        return pair.first;
+    }
+};
+
+struct aggregate_by_fn {
+    template <sequence Seq, typename KeyFn, typename Init, typename Func,
+              typename Key = aggregate_key_t<Seq, KeyFn>,
+              typename Hash = std::hash<Key>,
+              typename Eq = std::equal_to<>,
+              typename R = fold_result_t<Seq, Func, Init>>
+        requires std::invocable<KeyFn&, element_t<Seq>&> &&
+                 foldable<Seq, Func, Init> &&
+                 std::copy_constructible<Init> &&
+                 std::invocable<Hash const&, Key const&> &&
+                 std::predicate<Eq const&, Key const&, Key const&>
+    [[nodiscard]]
+    constexpr auto operator()(Seq&& seq, KeyFn key_fn, Init init, Func func,
+                              Hash hash = Hash{}, Eq eq = Eq{}) const
+        -> std::vector<std::pair<Key, R>>
+    {
+        using entry_t = std::pair<Key, R>;
+
+        flat_hash_table<entry_t, pair_first_fn, Hash, Eq> table(
+            pair_first_fn{}, std::move(hash), std::move(eq));
+
+        if constexpr (sized_sequence<Seq>) {
+            table.reserve(std::min(num::unchecked_cast<std::size_t>(flux::size(seq)),
+                                   aggregate_by_max_reserve));
+        }
+
+        flux::for_each_while(seq, [&](auto&& elem) {
+            auto&& key = std::invoke(key_fn, elem);
+            auto& entry = table.find_or_emplace(key, [&] {
+                return entry_t(Key(FLUX_FWD(key)), R(init));
+            }).first;
+            entry.second = std::invoke(func, std::move(entry.second), FLUX_FWD(elem));
+            return true;
+        });
+
+        return std::move(table).take_entries();
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto aggregate_by = detail::aggregate_by_fn{};
+
+template <typename D>
+template <typename KeyFn, typename Init, typename Func>
+    requires std::invocable<KeyFn&, element_t<D>&> &&
+             foldable<D, Func, Init>
+constexpr auto inline_sequence_base<D>::aggregate_by(KeyFn key_fn, Init init, Func func)
+{
+    return flux::aggregate_by(derived(), std::move(key_fn), std::move(init), std::move(func));
+}
+
+} // namespace flux
+
+#endif // FLUX_ALGORITHM_AGGREGATE_BY_HPP_INCLUDED
@@ -8,6 +8,8 @@
 
 #include <flux/core.hpp>
 
+#include <flux/algorithm/detail/simd.hpp>
+
 namespace flux {
 
 namespace detail {
@@ -37,6 +39,13 @@ struct count_eq_fn {
     constexpr auto operator()(Seq&& seq, Value const& value) const
         -> distance_t
     {
+        if constexpr (simd::kernel_sequence<Seq> && std::same_as<Value, value_t<Seq>>) {
+            if (!std::is_constant_evaluated()) {
+                return static_cast<distance_t>(
+                    simd::count(flux::data(seq), flux::usize(seq), value));
+            }
+        }
+
         distance_t counter = 0;
         flux::for_each_while(seq, [&](auto&& elem) {
             if (value == FLUX_FWD(elem)) {
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_DETAIL_BLOOM_FILTER_HPP_INCLUDED
+#define FLUX_ALGORITHM_DETAIL_BLOOM_FILTER_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <flux/algorithm/detail/flat_hash_table.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace flux::detail {
+
+/*
+ * A fixed-size Bloom filter. The number of bits and hash functions are
+ * chosen from the expected number of distinct items and the acceptable
+ * false positive rate; the memory used never grows after construction.
+ *
+ * The k probe positions are derived from a single hash using double hashing
+ * (Kirsch and Mitzenmacher), so each item is only hashed once.
+ */
+template <typename Hash>
+class bloom_filter {
+    std::vector<std::uint64_t> words_;
+    std::uint64_t bit_mask_ = 0;
+    int n_hashes_ = 1;
+    FLUX_NO_UNIQUE_ADDRESS Hash hash_;
+
+    template <typename Func>
+    constexpr auto for_each_bit(std::size_t h, Func func) const -> bool
+    {
+        std::uint64_t const h1 = mix_hash(h);
+        std::uint64_t const h2 = mix_hash(static_cast<std::size_t>(h1)) | 1;
+        for (int i = 0; i < n_hashes_; i++) {
+            std::uint64_t bit = (h1 + static_cast<std::uint64_t>(i) * h2) & bit_mask_;
+            if (!func(static_cast<std::size_t>(bit / 64), std::uint64_t{1} << (bit % 64))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    bloom_filter(std::size_t expected_items, double false_positive_rate,
+                 Hash hash = Hash{})
+        : hash_(std::move(hash))
+    {
+        FLUX_ASSERT(false_positive_rate > 0.0 && false_positive_rate < 1.0);
+
+        // Optimal number of bits m = -n ln(p) / (ln 2)^2, rounded up to a
+        // power of two so that probe positions can be masked rather than
+        // reduced modulo m
+        double const ln2 = 0.6931471805599453;
+        double const n = static_cast<double>(std::max(expected_items, std::size_t{1}));
+        double const m = -n * std::log(false_positive_rate) / (ln2 * ln2);
+        std::uint64_t n_bits = std::bit_ceil(
+            std::max(static_cast<std::uint64_t>(m), std::uint64_t{64}));
+
+        // Optimal number of hashes k = (m / n) ln 2, using the rounded m
+        n_hashes_ = std::max(1, static_cast<int>(
+            std::lround(static_cast<double>(n_bits) / n * ln2)));
+        bit_mask_ = n_bits - 1;
+        words_.assign(static_cast<std::size_t>(n_bits / 64), 0);
+    }
+
+    // Returns false if `item` has definitely not been inserted
+    template <typename T>
+    [[nodiscard]]
+    constexpr auto may_contain(T const& item) const -> bool
+    {
+        return for_each_bit(std::invoke(hash_, item), [this](std::size_t w, std::uint64_t b) {
+            return (words_[w] & b) != 0;
+        });
+    }
+
+    // Inserts `item`, returning true if it was definitely not present before
+    template <typename T>
+    constexpr auto insert(T const& item) -> bool
+    {
+        bool inserted = false;
+        for_each_bit(std::invoke(hash_, item), [&](std::size_t w, std::uint64_t b) {
+            inserted |= (words_[w] & b) == 0;
+            words_[w] |= b;
+            return true;
+        });
+        return inserted;
+    }
+
+    [[nodiscard]]
+    constexpr auto size_in_bits() const -> std::size_t { return words_.size() * 64; }
+
+    [[nodiscard]]
+    constexpr auto num_hashes() const -> int { return n_hashes_; }
+};
+
+} // namespace flux::detail
+
+#endif // FLUX_ALGORITHM_DETAIL_BLOOM_FILTER_HPP_INCLUDED
@@ -0,0 +1,310 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_DETAIL_FLAT_HASH_TABLE_HPP_INCLUDED
+#define FLUX_ALGORITHM_DETAIL_FLAT_HASH_TABLE_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace flux::detail {
+
+/*
+ * An insert-only open addressing hash table, used by the hashing algorithms.
+ *
+ * Entries are stored densely in a vector in insertion order, which makes
+ * iterating over (or handing out) the results cheap. The table itself is a
+ * power-of-two array of slots holding indices into the entry vector, plus a
+ * parallel array of one-byte control words in the style of SwissTable: each
+ * control byte is either `empty_ctrl`, or the low seven bits of the hash of
+ * the key in that slot.
+ *
+ * Probing inspects a group of eight control bytes at a time using SWAR
+ * (SIMD-within-a-register) tricks on a 64-bit word, so that most lookups
+ * compare at most one key, without needing any platform-specific intrinsics.
+ */
+
+// Standard library implementations of std::hash for integers are usually
+// the identity function, which would put all of the entropy in the wrong
+// bits. A single multiply-and-fold is enough to fix that, and keeps the
+// latency of each lookup low.
+constexpr auto mix_hash(std::size_t h) -> std::uint64_t
+{
+    auto x = static_cast<std::uint64_t>(h) * 0x9e3779b97f4a7c15;
+    return x ^ (x >> 32);
+}
+
+struct hash_group {
+    static constexpr std::size_t width = 8;
+    static constexpr std::uint8_t empty_ctrl = 0x80;
+
+    static constexpr std::uint64_t lsbs = 0x0101'0101'0101'0101;
+    static constexpr std::uint64_t msbs = 0x8080'8080'8080'8080;
+
+    std::uint64_t ctrl;
+
+    // Loads eight control bytes such that byte i is always in bits
+    // [8i, 8i+8), whatever the endianness
+    static constexpr auto load(std::uint8_t const* ptr) -> hash_group
+    {
+        if (std::is_constant_evaluated() || std::endian::native != std::endian::little) {
+            std::uint64_t word = 0;
+            for (std::size_t i = 0; i < width; i++) {
+                word |= std::uint64_t{ptr[i]} << (8 * i);
+            }
+            return hash_group{word};
+        } else {
+            std::uint64_t word;
+            std::memcpy(&word, ptr, sizeof(word));
+            return hash_group{word};
+        }
+    }
+
+    // Returns a mask with the high bit set in each byte which may be equal
+    // to `h2`. False positives are possible (but rare), so the caller must
+    // still compare keys; there are no false negatives.
+    constexpr auto match(std::uint8_t h2) const -> std::uint64_t
+    {
+        std::uint64_t x = ctrl ^ (lsbs * h2);
+        return (x - lsbs) & ~x & msbs;
+    }
+
+    // Full slots never have their high bit set, so this is exact
+    constexpr auto match_empty() const -> std::uint64_t
+    {
+        return ctrl & msbs;
+    }
+
+    // Returns the byte index of the lowest set bit in `mask`, and clears it
+    static constexpr auto next_index(std::uint64_t& mask) -> std::size_t
+    {
+        auto idx = static_cast<std::size_t>(std::countr_zero(mask)) / 8;
+        mask &= mask - 1;
+        return idx;
+    }
+};
+
+template <typename Entry, typename KeyOf, typename Hash, typename Eq,
+          typename Alloc = std::allocator<Entry>>
+class flat_hash_table {
+    template <typename T>
+    using rebind_t = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+    std::vector<Entry, rebind_t<Entry>> entries_;
+    std::vector<std::uint8_t, rebind_t<std::uint8_t>> ctrl_;
+    std::vector<std::size_t, rebind_t<std::size_t>> slots_;
+    std::size_t group_mask_ = 0;
+
+    FLUX_NO_UNIQUE_ADDRESS KeyOf key_of_;
+    FLUX_NO_UNIQUE_ADDRESS Hash hash_;
+    FLUX_NO_UNIQUE_ADDRESS Eq eq_;
+
+    static constexpr auto h1(std::uint64_t hash) -> std::size_t
+    {
+        return static_cast<std::size_t>(hash >> 7);
+    }
+
+    static constexpr auto h2(std::uint64_t hash) -> std::uint8_t
+    {
+        return static_cast<std::uint8_t>(hash & 0x7f);
+    }
+
+    constexpr auto capacity() const -> std::size_t { return ctrl_.size(); }
+
+    // Maximum load factor of 7/8
+    static constexpr auto max_entries(std::size_t cap) -> std::size_t
+    {
+        return cap - cap / 8;
+    }
+
+    template <typename K>
+    constexpr auto hash_of(K const& key) const -> std::uint64_t
+    {
+        return mix_hash(std::invoke(hash_, key));
+    }
+
+    // Returns the index of the first empty slot in the probe sequence
+    constexpr auto find_empty_slot(std::uint64_t hash) const -> std::size_t
+    {
+        std::size_t group = h1(hash) & group_mask_;
+        for (std::size_t step = 1; ; step++) {
+            std::size_t base = group * hash_group::width;
+            std::uint64_t empties = hash_group::load(ctrl_.data() + base).match_empty();
+            if (empties != 0) {
+                return base + hash_group::next_index(empties);
+            }
+            group = (group + step) & group_mask_;
+        }
+    }
+
+    constexpr auto set_slot(std::size_t slot, std::uint64_t hash, std::size_t entry_idx) -> void
+    {
+        ctrl_[slot] = h2(hash);
+        slots_[slot] = entry_idx;
+    }
+
+    constexpr auto rehash(std::size_t new_cap) -> void
+    {
+        ctrl_.assign(new_cap, hash_group::empty_ctrl);
+        slots_.resize(new_cap);
+        group_mask_ = new_cap / hash_group::width - 1;
+
+        for (std::size_t i = 0; i < entries_.size(); i++) {
+            auto hash = hash_of(std::invoke(key_of_, entries_[i]));
+            set_slot(find_empty_slot(hash), hash, i);
+        }
+    }
+
+    static constexpr auto capacity_for(std::size_t n_entries) -> std::size_t
+    {
+        std::size_t cap = 2 * hash_group::width;
+        while (max_entries(cap) < n_entries) {
+            cap *= 2;
+        }
+        return cap;
+    }
+
+public:
+    constexpr flat_hash_table() = default;
+
+    constexpr flat_hash_table(KeyOf key_of, Hash hash, Eq eq, Alloc const& alloc = Alloc())
+        : entries_(rebind_t<Entry>(alloc)),
+          ctrl_(rebind_t<std::uint8_t>(alloc)),
+          slots_(rebind_t<std::size_t>(alloc)),
+          key_of_(std::move(key_of)),
+          hash_(std::move(hash)),
+          eq_(std::move(eq))
+    {}
+
+    // Ensures that at least `n` entries can be inserted without rehashing
+    constexpr auto reserve(std::size_t n) -> void
+    {
+        entries_.reserve(n);
+        if (n > max_entries(capacity())) {
+            rehash(capacity_for(n));
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto size() const -> std::size_t { return entries_.size(); }
+
+    [[nodiscard]]
+    constexpr auto entries() const -> std::vector<Entry, rebind_t<Entry>> const&
+    {
+        return entries_;
+    }
+
+    // Allows the non-key parts of the entries to be modified in place
+    [[nodiscard]]
+    constexpr auto mutable_entries() -> std::span<Entry>
+    {
+        return std::span<Entry>(entries_);
+    }
+
+    [[nodiscard]]
+    constexpr auto take_entries() && -> std::vector<Entry, rebind_t<Entry>>
+    {
+        return std::move(entries_);
+    }
+
+    // Removes all entries, keeping the allocated memory
+    constexpr auto clear() -> void
+    {
+        entries_.clear();
+        std::fill(ctrl_.begin(), ctrl_.end(), hash_group::empty_ctrl);
+    }
+
+    // Returns a pointer to the entry with the given key, or nullptr.
+    // The pointer is invalidated by any subsequent insertion.
+    template <typename K>
+    [[nodiscard]]
+    constexpr auto find(K const& key) -> Entry*
+    {
+        if (entries_.empty()) {
+            return nullptr;
+        }
+
+        auto const hash = hash_of(key);
+        std::size_t group = h1(hash) & group_mask_;
+
+        for (std::size_t step = 1; ; step++) {
+            std::size_t base = group * hash_group::width;
+            auto const g = hash_group::load(ctrl_.data() + base);
+
+            for (auto matches = g.match(h2(hash)); matches != 0; ) {
+                Entry& entry = entries_[slots_[base + hash_group::next_index(matches)]];
+                if (std::invoke(eq_, std::invoke(key_of_, entry), key)) {
+                    return &entry;
+                }
+            }
+
+            if (g.match_empty() != 0) {
+                return nullptr;
+            }
+            group = (group + step) & group_mask_;
+        }
+    }
+
+    template <typename K>
+    [[nodiscard]]
+    constexpr auto find(K const& key) const -> Entry const*
+    {
+        return const_cast<flat_hash_table&>(*this).find(key);
+    }
+
+    /*
+     * Returns a reference to the entry with the given key, and false; or if
+     * there is no such entry, inserts `make()` and returns a reference to it
+     * and true. The key of `make()` must compare equal to `key`.
+     */
+    template <typename K, typename Make>
+    constexpr auto find_or_emplace(K const& key, Make&& make) -> std::pair<Entry&, bool>
+    {
+        if (capacity() == 0) {
+            rehash(capacity_for(1));
+        }
+
+        auto const hash = hash_of(key);
+        std::size_t group = h1(hash) & group_mask_;
+
+        for (std::size_t step = 1; ; step++) {
+            std::size_t base = group * hash_group::width;
+            auto const g = hash_group::load(ctrl_.data() + base);
+
+            for (auto matches = g.match(h2(hash)); matches != 0; ) {
+                Entry& entry = entries_[slots_[base + hash_group::next_index(matches)]];
+                if (std::invoke(eq_, std::invoke(key_of_, entry), key)) {
+                    return {entry, false};
+                }
+            }
+
+            if (auto empties = g.match_empty(); empties != 0) {
+                std::size_t slot = base + hash_group::next_index(empties);
+                // Only check the load factor when inserting, to keep it off
+                // the lookup path
+                if (entries_.size() >= max_entries(capacity())) {
+                    rehash(capacity_for(entries_.size() + 1));
+                    slot = find_empty_slot(hash);
+                }
+                entries_.push_back(std::invoke(FLUX_FWD(make)));
+                set_slot(slot, hash, entries_.size() - 1);
+                return {entries_.back(), true};
+            }
+            group = (group + step) & group_mask_;
+        }
+    }
+};
+
+} // namespace flux::detail
+
+#endif // FLUX_ALGORITHM_DETAIL_FLAT_HASH_TABLE_HPP_INCLUDED
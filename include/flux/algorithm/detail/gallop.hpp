@@ -0,0 +1,81 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_DETAIL_GALLOP_HPP_INCLUDED
+#define FLUX_ALGORITHM_DETAIL_GALLOP_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <algorithm>
+
+namespace flux::detail {
+
+// Sequences which we can jump around in, and which know where they end
+template <typename Seq>
+concept gallopable_sequence = random_access_sequence<Seq> && bounded_sequence<Seq>;
+
+// When merging two sorted sequences, we gallop through one of them if it has
+// more than this many times as many elements remaining as the other. Below
+// this ratio, a linear merge needs fewer comparisons.
+inline constexpr distance_t gallop_ratio = 16;
+
+enum class gallop_side : unsigned char { neither, first, second };
+
+// Decides which (if either) of two sorted sequences should be galloped
+// through when merging them from the given positions. This requires the
+// number of remaining elements on both sides, so both must be gallopable.
+template <typename Seq1, typename Seq2>
+constexpr auto choose_gallop_side(Seq1& seq1, cursor_t<Seq1> const& cur1,
+                                  Seq2& seq2, cursor_t<Seq2> const& cur2) -> gallop_side
+{
+    if constexpr (gallopable_sequence<Seq1> && gallopable_sequence<Seq2>) {
+        distance_t const n1 = flux::distance(seq1, cur1, flux::last(seq1));
+        distance_t const n2 = flux::distance(seq2, cur2, flux::last(seq2));
+        if (n1 / gallop_ratio > n2) {
+            return gallop_side::first;
+        } else if (n2 / gallop_ratio > n1) {
+            return gallop_side::second;
+        }
+    }
+    return gallop_side::neither;
+}
+
+/*
+ * Advances `cur` past the leading elements of `seq` for which `pred` returns
+ * true, given that `pred` is true for the element at `cur` and is partitioned
+ * over the rest of the sequence.
+ *
+ * This is an exponential search followed by a binary search, so skipping
+ * n elements requires O(log n) calls to `pred` rather than n.
+ */
+template <gallopable_sequence Seq, typename Pred>
+constexpr auto gallop(Seq& seq, cursor_t<Seq>& cur, Pred&& pred) -> void
+{
+    distance_t const remaining = flux::distance(seq, cur, flux::last(seq));
+
+    // Invariant: pred is true at cur + lo, and false at cur + hi (or hi is
+    // the end of the sequence)
+    distance_t lo = 0;
+    distance_t hi = 1;
+    while (hi < remaining && std::invoke(pred, flux::read_at(seq, flux::next(seq, cur, hi)))) {
+        lo = hi;
+        hi = num::mul(hi, distance_t{2});
+    }
+    hi = (std::min)(hi, remaining);
+
+    while (hi - lo > 1) {
+        distance_t mid = lo + (hi - lo) / 2;
+        if (std::invoke(pred, flux::read_at(seq, flux::next(seq, cur, mid)))) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    flux::inc(seq, cur, hi);
+}
+
+} // namespace flux::detail
+
+#endif // FLUX_ALGORITHM_DETAIL_GALLOP_HPP_INCLUDED
@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_DETAIL_LOSER_TREE_HPP_INCLUDED
+#define FLUX_ALGORITHM_DETAIL_LOSER_TREE_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <array>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace flux::detail {
+
+/*
+ * A tournament tree of losers over k players, numbered 0 to k-1, as described
+ * in Knuth, TAOCP vol. 3, section 5.4.1.
+ *
+ * The tree is a complete binary tree with the players as its leaves: leaf i
+ * is node k + i, and the parent of node n is node n/2. Each internal node
+ * records the loser of the match played there, and node 0 records the
+ * overall winner. After the winner's key changes, only the matches on the
+ * path from its leaf to the root need to be replayed, so selecting the next
+ * winner takes exactly floor(log2(k)) or ceil(log2(k)) comparisons.
+ *
+ * `beats(a, b)` must return true if player a should be selected before
+ * player b, and must be a strict total order on the players.
+ *
+ * If N is not std::dynamic_extent then the number of players is fixed at N,
+ * and the tree does not allocate.
+ */
+template <std::size_t N = std::dynamic_extent>
+class loser_tree {
+    using storage_t = std::conditional_t<N == std::dynamic_extent,
+                                         std::vector<std::size_t>,
+                                         std::array<std::size_t, N>>;
+
+    storage_t nodes_{};
+
+    constexpr auto num_players() const -> std::size_t { return nodes_.size(); }
+
+    // Plays all of the matches in the subtree rooted at node n, returning the
+    // winner of that subtree
+    template <typename Beats>
+    constexpr auto play(std::size_t n, Beats& beats) -> std::size_t
+    {
+        if (n >= num_players()) {
+            return n - num_players();
+        }
+
+        std::size_t a = play(2 * n, beats);
+        std::size_t b = play(2 * n + 1, beats);
+        if (beats(b, a)) {
+            std::swap(a, b);
+        }
+        nodes_[n] = b;
+        return a;
+    }
+
+public:
+    constexpr loser_tree() = default;
+
+    constexpr explicit loser_tree(std::size_t num_players)
+        requires (N == std::dynamic_extent)
+        : nodes_(num_players)
+    {}
+
+    // Plays every match from scratch
+    template <typename Beats>
+    constexpr auto build(Beats&& beats) -> void
+    {
+        if (num_players() > 0) {
+            nodes_[0] = play(1, beats);
+        }
+    }
+
+    // The player who should be selected next. The tree must not be empty.
+    [[nodiscard]]
+    constexpr auto winner() const -> std::size_t { return nodes_[0]; }
+
+    // Replays the matches of the current winner, after its key has changed
+    template <typename Beats>
+    constexpr auto replay(Beats&& beats) -> void
+    {
+        std::size_t w = nodes_[0];
+        for (std::size_t n = (w + num_players()) / 2; n > 0; n /= 2) {
+            if (beats(nodes_[n], w)) {
+                std::swap(nodes_[n], w);
+            }
+        }
+        nodes_[0] = w;
+    }
+};
+
+} // namespace flux::detail
+
+#endif // FLUX_ALGORITHM_DETAIL_LOSER_TREE_HPP_INCLUDED
@@ -0,0 +1,359 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_DETAIL_SIMD_HPP_INCLUDED
+#define FLUX_ALGORITHM_DETAIL_SIMD_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Runtime dispatch is implemented for x86-64 with GCC, whose target
+// attributes let one translation unit contain kernels for several
+// instruction sets. The kernels use GCC's __builtin_shuffle, which Clang
+// lacks, so Clang (which also defines __GNUC__) and other platforms use
+// only the scalar kernels. The module interface uses them too, as GCC 12
+// crashes writing the target-specific kernels into a module.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__) && !defined(FLUX_MODULE_INTERFACE)
+#  define FLUX_HAVE_SIMD_DISPATCH 1
+#else
+#  define FLUX_HAVE_SIMD_DISPATCH 0
+#endif
+
+namespace flux::detail::simd {
+
+/*
+ * Vectorised kernels for contiguous arrays of integers, with variants for
+ * SSE2, AVX2 and AVX-512 which are chosen between at runtime.
+ *
+ * The kernels are written once, using the compiler's vector extensions, and
+ * each variant instantiates them with a different vector width inside a
+ * function with the matching target attribute. No intrinsics headers are
+ * needed, and the variants are only called after the CPU has been probed,
+ * so that code built for baseline x86-64 can use AVX-512 where available.
+ *
+ * The kernels are never used during constant evaluation: callers use them
+ * only when !std::is_constant_evaluated().
+ */
+
+template <typename T>
+concept kernel_element = std::integral<T> && !std::same_as<T, bool> &&
+                         (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// Sequences can opt out of the kernels, for example to see every element
+// go through their own accessors
+template <typename T>
+inline constexpr bool disable_simd = false;
+
+template <typename T>
+    requires requires { T::disable_simd; } &&
+             decays_to<decltype(T::disable_simd), bool>
+inline constexpr bool disable_simd<T> = T::disable_simd;
+
+// Sequences whose elements the kernels can read straight from memory
+template <typename Seq>
+concept kernel_sequence =
+    contiguous_sequence<Seq> && sized_sequence<Seq> && kernel_element<value_t<Seq>> &&
+    (std::same_as<std::remove_reference_t<element_t<Seq>>, value_t<Seq>> ||
+     std::same_as<std::remove_reference_t<element_t<Seq>>, value_t<Seq> const>) &&
+    !disable_simd<traits_t<Seq>>;
+
+// The instruction sets the CPU supports. This asks the CPU, so prefer
+// active_level(), which caches the answer.
+inline auto detect_level() -> simd_level
+{
+#if FLUX_HAVE_SIMD_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return simd_level::avx512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        return simd_level::avx2;
+    } else {
+        return simd_level::sse2; // always available on x86-64
+    }
+#else
+    return simd_level::scalar;
+#endif
+}
+
+// The level which the kernels use: the best the CPU supports, limited by
+// FLUX_MAX_SIMD_LEVEL. The CPU is only probed the first time this is called.
+inline auto active_level() -> simd_level
+{
+    static simd_level const level = [] {
+        simd_level const detected = detect_level();
+        return detected < config::max_simd_level ? detected : config::max_simd_level;
+    }();
+    return level;
+}
+
+template <typename T>
+struct extrema {
+    T min;
+    T max;
+};
+
+template <kernel_element T>
+auto find_scalar(T const* data, std::size_t size, T value) -> std::size_t
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return size;
+}
+
+template <kernel_element T>
+auto count_scalar(T const* data, std::size_t size, T value) -> std::size_t
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        count += (data[i] == value);
+    }
+    return count;
+}
+
+// Precondition: size > 0
+template <kernel_element T>
+auto minmax_scalar(T const* data, std::size_t size) -> extrema<T>
+{
+    extrema<T> res{data[0], data[0]};
+    for (std::size_t i = 1; i < size; ++i) {
+        res.min = data[i] < res.min ? data[i] : res.min;
+        res.max = data[i] < res.max ? res.max : data[i];
+    }
+    return res;
+}
+
+#if FLUX_HAVE_SIMD_DISPATCH
+
+// Vectors of Bytes bytes of integers the same size and signedness as T. Using
+// the standard signed and unsigned types lets char8_t, wchar_t etc share
+// kernels with the corresponding plain integer types.
+template <typename T, std::size_t Bytes>
+struct vector_types {
+    using lane = std::conditional_t<std::is_signed_v<T>, std::make_signed_t<T>,
+                                    std::make_unsigned_t<T>>;
+    using ulane = std::make_unsigned_t<T>;
+    // Dependent on T, as GCC ignores vector_size on a non-dependent type
+    using word = std::conditional_t<sizeof(T) != 0, std::uint64_t, T>;
+
+    typedef lane vec __attribute__((vector_size(Bytes)));
+    typedef ulane uvec __attribute__((vector_size(Bytes)));
+    typedef word words __attribute__((vector_size(Bytes)));
+
+    static constexpr std::size_t lanes = Bytes / sizeof(T);
+};
+
+// SSE2 has no 64-bit comparisons, which makes emulating them slower than
+// the scalar kernels
+template <std::size_t Bytes, typename T>
+inline constexpr bool use_vectors = !(Bytes == 16 && sizeof(T) == 8);
+
+// The kernels below don't pass vectors to or from any functions, whose ABI
+// would depend on the target: everything happens inside the variant for each
+// target. Vectors are loaded with memcpy, as the data may not be aligned.
+
+template <std::size_t Bytes, kernel_element T>
+FLUX_ALWAYS_INLINE auto find_impl(T const* data, std::size_t size, T value) -> std::size_t
+{
+    if constexpr (!use_vectors<Bytes, T>) {
+        return find_scalar(data, size, value);
+    } else {
+        using V = vector_types<T, Bytes>;
+        using vec = typename V::vec;
+        using words = typename V::words;
+
+        // Testing whether any lane of a comparison matched is relatively
+        // expensive, so the results of four comparisons are combined first
+        constexpr std::size_t unroll = 4;
+
+        vec const needle = vec{} + static_cast<typename V::lane>(value);
+        std::size_t i = 0;
+        for (; i + unroll * V::lanes <= size; i += unroll * V::lanes) {
+            vec v0, v1, v2, v3;
+            __builtin_memcpy(&v0, data + i, sizeof(vec));
+            __builtin_memcpy(&v1, data + i + V::lanes, sizeof(vec));
+            __builtin_memcpy(&v2, data + i + 2 * V::lanes, sizeof(vec));
+            __builtin_memcpy(&v3, data + i + 3 * V::lanes, sizeof(vec));
+            // Each comparison is converted before they are combined, as GCC
+            // otherwise scalarises the AVX-512 version
+            words const found = (words) (v0 == needle) | (words) (v1 == needle) |
+                                (words) (v2 == needle) | (words) (v3 == needle);
+            std::uint64_t found_words[Bytes / 8];
+            __builtin_memcpy(&found_words, &found, sizeof(found));
+            std::uint64_t any = 0;
+            for (std::uint64_t w : found_words) {
+                any |= w;
+            }
+            if (any != 0) {
+                break;
+            }
+        }
+        // Either the vectors containing the first match, or the tail
+        return i + find_scalar(data + i, size - i, value);
+    }
+}
+
+template <std::size_t Bytes, kernel_element T>
+FLUX_ALWAYS_INLINE auto count_impl(T const* data, std::size_t size, T value) -> std::size_t
+{
+    if constexpr (!use_vectors<Bytes, T>) {
+        return count_scalar(data, size, value);
+    } else {
+        using V = vector_types<T, Bytes>;
+
+        // Comparisons set matching lanes to -1, so subtracting them counts the
+        // matches in each lane. The lane counters are added up before they can
+        // overflow.
+        constexpr std::size_t max_block = sizeof(T) == 1 ? 255 : 65535;
+
+        typename V::vec const needle = typename V::vec{} + static_cast<typename V::lane>(value);
+        std::size_t count = 0;
+        std::size_t i = 0;
+        while (i + V::lanes <= size) {
+            std::size_t block = (size - i) / V::lanes;
+            block = block < max_block ? block : max_block;
+            typename V::uvec counters{};
+            for (std::size_t b = 0; b < block; ++b, i += V::lanes) {
+                typename V::vec v;
+                __builtin_memcpy(&v, data + i, sizeof(v));
+                counters -= (typename V::uvec) (v == needle);
+            }
+            typename V::ulane lanes[V::lanes];
+            __builtin_memcpy(&lanes, &counters, sizeof(counters));
+            for (auto n : lanes) {
+                count += n;
+            }
+        }
+        return count + count_scalar(data + i, size - i, value);
+    }
+}
+
+// Leaves the smallest lane of lo and the largest lane of hi in lane 0, by
+// repeatedly folding the upper lanes onto the lower ones. Reading each lane
+// in turn instead would make GCC keep the vectors in memory during the main
+// loop.
+template <std::size_t Step, typename Vec, std::size_t... L>
+FLUX_ALWAYS_INLINE void fold_extrema(Vec& lo, Vec& hi, std::index_sequence<L...> lanes)
+{
+    using mask_t = decltype(lo < hi);
+    mask_t const mask = {((L + Step) % sizeof...(L))...};
+    Vec const lo_upper = __builtin_shuffle(lo, mask);
+    Vec const hi_upper = __builtin_shuffle(hi, mask);
+    lo = lo_upper < lo ? lo_upper : lo;
+    hi = hi < hi_upper ? hi_upper : hi;
+    if constexpr (Step > 1) {
+        fold_extrema<Step / 2>(lo, hi, lanes);
+    }
+}
+
+// Precondition: size > 0
+template <std::size_t Bytes, kernel_element T>
+FLUX_ALWAYS_INLINE auto minmax_impl(T const* data, std::size_t size) -> extrema<T>
+{
+    if constexpr (!use_vectors<Bytes, T>) {
+        return minmax_scalar(data, size);
+    } else {
+        using V = vector_types<T, Bytes>;
+
+        if (size < V::lanes) {
+            return minmax_scalar(data, size);
+        }
+
+        typename V::vec lo;
+        __builtin_memcpy(&lo, data, sizeof(lo));
+        typename V::vec hi = lo;
+        std::size_t i = V::lanes;
+        for (; i + V::lanes <= size; i += V::lanes) {
+            typename V::vec v;
+            __builtin_memcpy(&v, data + i, sizeof(v));
+            lo = v < lo ? v : lo;
+            hi = hi < v ? v : hi;
+        }
+
+        fold_extrema<V::lanes / 2>(lo, hi, std::make_index_sequence<V::lanes>{});
+        extrema<T> res{static_cast<T>(lo[0]), static_cast<T>(hi[0])};
+        if (i < size) {
+            auto const tail = minmax_scalar(data + i, size - i);
+            res.min = tail.min < res.min ? tail.min : res.min;
+            res.max = tail.max < res.max ? res.max : tail.max;
+        }
+        return res;
+    }
+}
+
+// Defines name_sse2, name_avx2 and name_avx512, which run name_impl with the
+// vector width of each instruction set
+#define FLUX_SIMD_VARIANTS(name)                                                 \
+    template <typename... Args>                                                  \
+    [[gnu::target("sse2")]] auto name##_sse2(Args... args)                       \
+    {                                                                            \
+        return name##_impl<16>(args...);                                         \
+    }                                                                            \
+    template <typename... Args>                                                  \
+    [[gnu::target("avx2")]] auto name##_avx2(Args... args)                       \
+    {                                                                            \
+        return name##_impl<32>(args...);                                         \
+    }                                                                            \
+    template <typename... Args>                                                  \
+    [[gnu::target("avx512f,avx512bw")]] auto name##_avx512(Args... args)         \
+    {                                                                            \
+        return name##_impl<64>(args...);                                         \
+    }
+
+FLUX_SIMD_VARIANTS(find)
+FLUX_SIMD_VARIANTS(count)
+FLUX_SIMD_VARIANTS(minmax)
+
+#undef FLUX_SIMD_VARIANTS
+
+// Calls the variant of a kernel for the active level
+#define FLUX_SIMD_DISPATCH(name, ...)                          \
+    switch (active_level()) {                                  \
+    case simd_level::avx512: return name##_avx512(__VA_ARGS__); \
+    case simd_level::avx2: return name##_avx2(__VA_ARGS__);     \
+    case simd_level::sse2: return name##_sse2(__VA_ARGS__);     \
+    case simd_level::scalar: break;                             \
+    }                                                           \
+    return name##_scalar(__VA_ARGS__)
+
+#else
+
+#define FLUX_SIMD_DISPATCH(name, ...) return name##_scalar(__VA_ARGS__)
+
+#endif // FLUX_HAVE_SIMD_DISPATCH
+
+// Returns the index of the first element equal to value, or size if there
+// is none
+template <kernel_element T>
+auto find(T const* data, std::size_t size, std::type_identity_t<T> value) -> std::size_t
+{
+    FLUX_SIMD_DISPATCH(find, data, size, value);
+}
+
+// Returns the number of elements equal to value
+template <kernel_element T>
+auto count(T const* data, std::size_t size, std::type_identity_t<T> value) -> std::size_t
+{
+    FLUX_SIMD_DISPATCH(count, data, size, value);
+}
+
+// Returns the smallest and largest elements. Precondition: size > 0
+template <kernel_element T>
+auto minmax(T const* data, std::size_t size) -> extrema<T>
+{
+    FLUX_DEBUG_ASSERT(size > 0);
+    FLUX_SIMD_DISPATCH(minmax, data, size);
+}
+
+#undef FLUX_SIMD_DISPATCH
+
+} // namespace flux::detail::simd
+
+#endif // FLUX_ALGORITHM_DETAIL_SIMD_HPP_INCLUDED
@@ -8,6 +8,8 @@
 
 #include <flux/core.hpp>
 
+#include <flux/algorithm/detail/simd.hpp>
+
 #include <cstring>
 #include <type_traits>
 
@@ -53,6 +55,13 @@ public:
                     return flux::next(seq, flux::first(seq), offset);
                 }
             }
+        } else if constexpr (simd::kernel_sequence<Seq> && std::same_as<Value, value_t<Seq>>) {
+            if (std::is_constant_evaluated()) {
+                return impl(seq, value); // LCOV_EXCL_LINE
+            } else {
+                auto offset = simd::find(flux::data(seq), flux::usize(seq), value);
+                return flux::next(seq, flux::first(seq), static_cast<distance_t>(offset));
+            }
         } else {
             return impl(seq, value);
         }
@@ -0,0 +1,269 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_HISTOGRAM_HPP_INCLUDED
+#define FLUX_ALGORITHM_HISTOGRAM_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace flux {
+
+/*
+ * Describes `count` bins of equal width, which together cover the half-open
+ * interval [min, max)
+ */
+FLUX_EXPORT
+template <typename T>
+struct bins {
+    T min;
+    T max;
+    std::size_t count;
+};
+
+template <typename T>
+bins(T, T, std::size_t) -> bins<T>;
+
+namespace detail {
+
+// Contiguous input is binned in blocks of this many elements
+inline constexpr std::size_t histogram_block_size = 256;
+
+// When there are at most this many bins, contiguous input is counted into
+// several interleaved sub-histograms, so that runs of equal values don't
+// serialise on a single counter
+inline constexpr std::size_t histogram_max_interleaved_bins = 4096;
+inline constexpr std::size_t histogram_interleave = 4;
+
+struct histogram_fn;
+
+} // namespace detail
+
+/*
+ * The counts of values falling into each of a set of fixed-width bins,
+ * together with the number of values below and above the range of the bins.
+ *
+ * Histograms over the same bins can be merged, so that partitions of a
+ * sequence can be counted in parallel and the results combined.
+ */
+FLUX_EXPORT
+template <typename T>
+class histogram_counts {
+    // Bin positions are calculated in floating point, at float precision if
+    // the inputs are floats so that the calculation vectorises well
+    using calc_t = std::conditional_t<std::same_as<T, float>, float, double>;
+
+    bins<T> bins_;
+    calc_t min_;
+    calc_t max_;
+    calc_t scale_;
+    calc_t last_slot_;
+    std::int32_t num_bins_;
+    // counts_[0] is the underflow, counts_[1..n] are the bins, and
+    // counts_[n + 1] is the overflow
+    std::vector<std::uint64_t> counts_;
+
+    friend struct detail::histogram_fn;
+
+    // Returns the index into counts_ for the given value. The position is
+    // clamped in floating point and converted to a 32-bit integer, which is
+    // a single instruction (scalar or vector) on common hardware. Adding the
+    // offset of 1 can round the position of a value just below min up into
+    // the first bin, and a value just below max can round up into the
+    // overflow, so the slot is then corrected by comparing the value itself
+    // with min and max. This also sends NaNs to the underflow. The
+    // corrections select between integers, which unlike floating point
+    // selects GCC will vectorise without -fno-trapping-math.
+    static constexpr auto slot(T value, calc_t min, calc_t max, calc_t scale, calc_t last,
+                               std::int32_t n) -> std::uint32_t
+    {
+        calc_t const v = static_cast<calc_t>(value);
+        calc_t pos = (v - min) * scale + calc_t(1);
+        pos = pos > calc_t(0) ? pos : calc_t(0);
+        pos = pos < last ? pos : last;
+        std::int32_t s = static_cast<std::int32_t>(pos);
+        s = s < n ? s : n;
+        s = v < max ? s : n + 1;
+        s = v >= min ? s : 0;
+        return static_cast<std::uint32_t>(s);
+    }
+
+    constexpr auto slot(T value) const -> std::uint32_t
+    {
+        return slot(value, min_, max_, scale_, last_slot_, num_bins_);
+    }
+
+    // Counts a contiguous block of values. First we work out which slot each
+    // value in a block falls into, in a loop which the compiler can
+    // vectorise, and then do the increments. With few enough bins, the
+    // increments are spread over interleaved sub-histograms, so that runs of
+    // similar values don't all wait on the same counter.
+    constexpr auto add_contiguous(T const* values, std::size_t n) -> void
+    {
+        constexpr std::size_t block_size = detail::histogram_block_size;
+        constexpr std::size_t ways = detail::histogram_interleave;
+
+        // Keep the parameters in locals, so that the compiler knows they
+        // aren't changed by the increments
+        calc_t const min = min_;
+        calc_t const max = max_;
+        calc_t const scale = scale_;
+        calc_t const last = last_slot_;
+        std::int32_t const num_bins = num_bins_;
+        std::array<std::uint32_t, block_size> slots{};
+
+        bool const interleave = bins_.count <= detail::histogram_max_interleaved_bins;
+        std::size_t const stride = counts_.size();
+        std::vector<std::uint64_t> sub(interleave ? ways * stride : 0);
+        std::uint64_t* const counts = interleave ? sub.data() : counts_.data();
+
+        std::size_t base = 0;
+        for (; base + block_size <= n; base += block_size) {
+            for (std::size_t i = 0; i < block_size; i++) {
+                slots[i] = slot(values[base + i], min, max, scale, last, num_bins);
+            }
+            if (interleave) {
+                for (std::size_t i = 0; i < block_size; i += ways) {
+                    for (std::size_t w = 0; w < ways; w++) {
+                        ++counts[w * stride + slots[i + w]];
+                    }
+                }
+            } else {
+                for (std::size_t i = 0; i < block_size; i++) {
+                    ++counts[slots[i]];
+                }
+            }
+        }
+
+        for (; base < n; base++) {
+            ++counts_[slot(values[base], min, max, scale, last, num_bins)];
+        }
+
+        for (std::size_t w = 0; w < sub.size() / stride; w++) {
+            for (std::size_t s = 0; s < stride; s++) {
+                counts_[s] += sub[w * stride + s];
+            }
+        }
+    }
+
+public:
+    constexpr explicit histogram_counts(bins<T> b)
+        : bins_(b),
+          min_(static_cast<calc_t>(b.min)),
+          max_(static_cast<calc_t>(b.max)),
+          scale_(static_cast<calc_t>(b.count) /
+                 (static_cast<calc_t>(b.max) - static_cast<calc_t>(b.min))),
+          last_slot_(static_cast<calc_t>(b.count + 1)),
+          num_bins_(static_cast<std::int32_t>(b.count))
+    {
+        if (b.count == 0 || !(b.min < b.max)) {
+            runtime_error("histogram bins must be non-empty, with min < max");
+        }
+        if (b.count > std::size_t{INT32_MAX} - 1) {
+            runtime_error("too many histogram bins");
+        }
+        counts_.resize(b.count + 2);
+    }
+
+    // Counts a single value
+    constexpr auto add(T value) -> void { ++counts_[slot(value)]; }
+
+    // Adds the counts of another histogram over the same bins
+    constexpr auto merge(histogram_counts const& other) -> void
+    {
+        if (bins_.min != other.bins_.min || bins_.max != other.bins_.max ||
+            bins_.count != other.bins_.count) {
+            runtime_error("merged histograms must have the same bins");
+        }
+        for (std::size_t i = 0; i < counts_.size(); i++) {
+            counts_[i] += other.counts_[i];
+        }
+    }
+
+    [[nodiscard]]
+    constexpr auto get_bins() const -> bins<T> const& { return bins_; }
+
+    [[nodiscard]]
+    constexpr auto num_bins() const -> std::size_t { return bins_.count; }
+
+    // The number of values in bin i, which covers [bin_min(i), bin_min(i + 1))
+    [[nodiscard]]
+    constexpr auto count(std::size_t i) const -> std::uint64_t
+    {
+        FLUX_ASSERT(i < bins_.count);
+        return counts_[i + 1];
+    }
+
+    // The counts of all of the bins, in order
+    [[nodiscard]]
+    constexpr auto counts() const -> std::span<std::uint64_t const>
+    {
+        return std::span<std::uint64_t const>(counts_).subspan(1, bins_.count);
+    }
+
+    [[nodiscard]]
+    constexpr auto bin_min(std::size_t i) const -> calc_t
+    {
+        return min_ + static_cast<calc_t>(i) / scale_;
+    }
+
+    // The number of values less than min, or which were NaN
+    [[nodiscard]]
+    constexpr auto underflow() const -> std::uint64_t { return counts_.front(); }
+
+    // The number of values greater than or equal to max
+    [[nodiscard]]
+    constexpr auto overflow() const -> std::uint64_t { return counts_.back(); }
+
+    // The total number of values counted, including under- and overflows
+    [[nodiscard]]
+    constexpr auto total() const -> std::uint64_t
+    {
+        std::uint64_t sum = 0;
+        for (std::uint64_t c : counts_) {
+            sum += c;
+        }
+        return sum;
+    }
+};
+
+namespace detail {
+
+struct histogram_fn {
+    template <sequence Seq, typename T>
+        requires std::is_arithmetic_v<T> &&
+                 std::convertible_to<element_t<Seq>, T>
+    [[nodiscard]]
+    constexpr auto operator()(Seq&& seq, bins<T> b) const -> histogram_counts<T>
+    {
+        histogram_counts<T> hist(b);
+
+        if constexpr (contiguous_sequence<Seq> && sized_sequence<Seq> &&
+                      std::same_as<value_t<Seq>, T>) {
+            hist.add_contiguous(flux::data(seq),
+                                num::unchecked_cast<std::size_t>(flux::size(seq)));
+        } else {
+            flux::for_each_while(seq, [&hist](auto&& elem) {
+                hist.add(static_cast<T>(FLUX_FWD(elem)));
+                return true;
+            });
+        }
+
+        return hist;
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto histogram = detail::histogram_fn{};
+
+} // namespace flux
+
+#endif // FLUX_ALGORITHM_HISTOGRAM_HPP_INCLUDED
@@ -8,6 +8,7 @@
 
 #include <flux/core.hpp>
 
+#include <flux/algorithm/detail/simd.hpp>
 #include <flux/algorithm/fold.hpp>
 
 namespace flux {
@@ -21,12 +22,28 @@ struct minmax_result {
 
 namespace detail {
 
+// Whether min(), max() and minmax() can use the SIMD kernel, which compares
+// integers with their built-in operators
+template <typename Seq, typename Cmp>
+concept simd_minmax_sequence =
+    simd::kernel_sequence<Seq> && std::same_as<Cmp, std::compare_three_way>;
+
 struct min_op {
     template <sequence Seq, weak_ordering_for<Seq> Cmp = std::compare_three_way>
     [[nodiscard]]
     constexpr auto operator()(Seq&& seq, Cmp cmp = Cmp{}) const
         -> flux::optional<value_t<Seq>>
     {
+        if constexpr (simd_minmax_sequence<Seq, Cmp>) {
+            if (!std::is_constant_evaluated()) {
+                auto const size = flux::usize(seq);
+                if (size == 0) {
+                    return std::nullopt;
+                }
+                return flux::optional<value_t<Seq>>(simd::minmax(flux::data(seq), size).min);
+            }
+        }
+
         return flux::fold_first(FLUX_FWD(seq), [&](auto min, auto&& elem) -> value_t<Seq> {
             if (std::invoke(cmp, elem, min) < 0) {
                 return value_t<Seq>(FLUX_FWD(elem));
@@ -43,6 +60,16 @@ struct max_op {
     constexpr auto operator()(Seq&& seq, Cmp cmp = Cmp{}) const
         -> flux::optional<value_t<Seq>>
     {
+        if constexpr (simd_minmax_sequence<Seq, Cmp>) {
+            if (!std::is_constant_evaluated()) {
+                auto const size = flux::usize(seq);
+                if (size == 0) {
+                    return std::nullopt;
+                }
+                return flux::optional<value_t<Seq>>(simd::minmax(flux::data(seq), size).max);
+            }
+        }
+
         return flux::fold_first(FLUX_FWD(seq), [&](auto max, auto&& elem) -> value_t<Seq> {
             if (!(std::invoke(cmp, elem, max) < 0)) {
                 return value_t<Seq>(FLUX_FWD(elem));
@@ -61,6 +88,17 @@ struct minmax_op {
     {
         using R = minmax_result<value_t<Seq>>;
 
+        if constexpr (simd_minmax_sequence<Seq, Cmp>) {
+            if (!std::is_constant_evaluated()) {
+                auto const size = flux::usize(seq);
+                if (size == 0) {
+                    return std::nullopt;
+                }
+                auto const res = simd::minmax(flux::data(seq), size);
+                return flux::optional<R>(R{res.min, res.max});
+            }
+        }
+
         auto cur = flux::first(seq);
         if (flux::is_last(seq, cur)) {
             return std::nullopt;
@@ -0,0 +1,303 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ALGORITHM_QUANTILES_HPP_INCLUDED
+#define FLUX_ALGORITHM_QUANTILES_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+/*
+ * A KLL sketch (Karnin, Lang and Liberty, "Optimal Quantile Approximation in
+ * Streams", 2016), which summarises a stream of values in bounded memory and
+ * answers rank and quantile queries about it to within a given error.
+ *
+ * The sketch is a stack of "compactors". Values are added to level 0. When a
+ * level reaches its capacity, either its odd- or its even-positioned items in
+ * sorted order (chosen at random) are promoted to the level above, where each
+ * stands for twice as many values. Capacities shrink geometrically from k at
+ * the top of the stack, so the sketch holds O(k) items however many values
+ * have been added.
+ *
+ * Only level 0 ever needs sorting: the levels above it are kept sorted by
+ * merging in each batch of promoted items, which are already in order.
+ *
+ * Sketches can be merged, so partitions of a stream can be summarised in
+ * parallel and the results combined. The random choices are made with a
+ * small fixed-seed generator, so results are reproducible.
+ */
+FLUX_EXPORT
+template <std::totally_ordered T>
+    requires std::copyable<T>
+class quantile_sketch {
+    std::size_t k_;
+    std::uint64_t n_ = 0;
+    std::vector<std::vector<T>> levels_;
+    std::vector<std::size_t> capacities_;
+    std::vector<T> promoted_;
+    std::vector<T> merged_;
+    std::size_t num_items_ = 0;
+    std::uint64_t rng_ = 0x9e3779b97f4a7c15;
+
+    // The smallest capacity of any level
+    static constexpr std::size_t min_capacity = 8;
+
+    // The capacity of each level is k * (2/3)^depth, where depth is the
+    // distance from the top level, but at least min_capacity
+    constexpr auto update_capacities() -> void
+    {
+        capacities_.resize(levels_.size());
+        double cap = static_cast<double>(k_);
+        for (std::size_t h = levels_.size(); h-- > 0; ) {
+            auto const c = static_cast<std::size_t>(cap);
+            capacities_[h] = (std::max)(c + (static_cast<double>(c) < cap), min_capacity);
+            cap *= 2.0 / 3.0;
+        }
+
+    }
+
+    // Merges the sorted items of `from` into the sorted level `into`
+    constexpr auto merge_sorted(std::vector<T>& into, std::vector<T>& from) -> void
+    {
+        merged_.clear();
+        merged_.reserve(into.size() + from.size());
+        std::ranges::merge(std::make_move_iterator(into.begin()),
+                           std::make_move_iterator(into.end()),
+                           std::make_move_iterator(from.begin()),
+                           std::make_move_iterator(from.end()),
+                           std::back_inserter(merged_));
+        std::swap(into, merged_);
+    }
+
+    // xorshift64
+    constexpr auto coin_flip() -> bool
+    {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        return (rng_ & 1) != 0;
+    }
+
+    // Compacts every level which has reached its capacity, from the bottom
+    // up, adding a new level at the top if necessary
+    constexpr auto compress() -> void
+    {
+        for (std::size_t h = 0; h < levels_.size(); h++) {
+            if (levels_[h].size() < capacities_[h]) {
+                continue;
+            }
+            if (h + 1 == levels_.size()) {
+                levels_.emplace_back();
+                update_capacities();
+            }
+
+            auto& level = levels_[h];
+            if (h == 0) {
+                std::ranges::sort(level);
+            }
+
+            // With an odd number of items, the largest stays behind
+            std::size_t const len = level.size() & ~std::size_t{1};
+            promoted_.clear();
+            for (std::size_t i = coin_flip() ? 1 : 0; i < len; i += 2) {
+                promoted_.push_back(std::move(level[i]));
+            }
+            if (len < level.size()) {
+                level.front() = std::move(level.back());
+                level.resize(1);
+            } else {
+                level.clear();
+            }
+            merge_sorted(levels_[h + 1], promoted_);
+            num_items_ -= len / 2;
+        }
+    }
+
+    // Returns each item together with the number of values it stands for,
+    // sorted by item
+    constexpr auto weighted_items() const -> std::vector<std::pair<T, std::uint64_t>>
+    {
+        std::vector<std::pair<T, std::uint64_t>> items;
+        items.reserve(num_items_);
+        for (std::size_t h = 0; h < levels_.size(); h++) {
+            for (T const& item : levels_[h]) {
+                items.emplace_back(item, std::uint64_t{1} << h);
+            }
+        }
+        std::ranges::sort(items, std::ranges::less{}, &std::pair<T, std::uint64_t>::first);
+        return items;
+    }
+
+public:
+    // Creates a sketch with the given accuracy parameter. The rank error
+    // is proportional to 1/k, and the sketch holds about 3k items.
+    constexpr explicit quantile_sketch(std::size_t k)
+        : k_((std::max)(k, min_capacity)),
+          levels_(1)
+    {
+        update_capacities();
+    }
+
+    // Returns the smallest k for which the rank error is at most eps
+    [[nodiscard]]
+    static constexpr auto k_for_epsilon(double eps) -> std::size_t
+    {
+        if (!(eps > 0.0 && eps < 1.0)) {
+            runtime_error("quantile_sketch epsilon must be between 0 and 1");
+        }
+        // Chosen empirically: over many streams and quantiles, the worst
+        // rank error seen with this k is around 0.8 eps
+        return static_cast<std::size_t>(3.5 / eps) + 1;
+    }
+
+    // Adds a value to the sketch
+    constexpr auto add(T value) -> void
+    {
+        levels_[0].push_back(std::move(value));
+        ++n_;
+        ++num_items_;
+        if (levels_[0].size() >= capacities_[0]) {
+            compress();
+        }
+    }
+
+    // Adds the values summarised by another sketch to this one. Both sketches
+    // should have the same k; otherwise the error is that of the smaller.
+    constexpr auto merge(quantile_sketch const& other) -> void
+    {
+        k_ = (std::min)(k_, other.k_);
+        if (levels_.size() < other.levels_.size()) {
+            levels_.resize(other.levels_.size());
+        }
+        levels_[0].insert(levels_[0].end(), other.levels_[0].begin(),
+                          other.levels_[0].end());
+        for (std::size_t h = 1; h < other.levels_.size(); h++) {
+            promoted_ = other.levels_[h];
+            merge_sorted(levels_[h], promoted_);
+        }
+        n_ += other.n_;
+        num_items_ += other.num_items_;
+        update_capacities();
+        compress();
+    }
+
+    // The number of values added to the sketch
+    [[nodiscard]]
+    constexpr auto count() const -> std::uint64_t { return n_; }
+
+    [[nodiscard]]
+    constexpr auto is_empty() const -> bool { return n_ == 0; }
+
+    // The number of items currently held by the sketch
+    [[nodiscard]]
+    constexpr auto num_retained() const -> std::size_t { return num_items_; }
+
+    // Returns an estimate of the fraction of values which are less than or
+    // equal to `value`
+    [[nodiscard]]
+    constexpr auto rank(T const& value) const -> double
+    {
+        if (n_ == 0) {
+            return 0.0;
+        }
+        std::uint64_t weight = 0;
+        for (std::size_t h = 0; h < levels_.size(); h++) {
+            for (T const& item : levels_[h]) {
+                if (!(value < item)) {
+                    weight += std::uint64_t{1} << h;
+                }
+            }
+        }
+        return static_cast<double>(weight) / static_cast<double>(n_);
+    }
+
+    // Returns an estimate of the value whose rank is q, for 0 <= q <= 1
+    [[nodiscard]]
+    constexpr auto quantile(double q) const -> T
+    {
+        if (n_ == 0) {
+            runtime_error("quantile() called on an empty quantile_sketch");
+        }
+        if (!(q >= 0.0 && q <= 1.0)) {
+            runtime_error("quantile() argument must be between 0 and 1");
+        }
+
+        auto const items = weighted_items();
+        auto const target = static_cast<double>(n_) * q;
+        std::uint64_t weight = 0;
+        for (auto const& [item, w] : items) {
+            weight += w;
+            if (static_cast<double>(weight) >= target) {
+                return item;
+            }
+        }
+        return items.back().first;
+    }
+
+    // Returns estimates of several quantiles at once, which is cheaper than
+    // calling quantile() for each. The fractions must be in ascending order.
+    [[nodiscard]]
+    constexpr auto quantiles(std::vector<double> const& qs) const -> std::vector<T>
+    {
+        if (n_ == 0) {
+            runtime_error("quantiles() called on an empty quantile_sketch");
+        }
+
+        auto const items = weighted_items();
+        std::vector<T> out;
+        out.reserve(qs.size());
+        std::size_t idx = 0;
+        std::uint64_t weight = items.front().second;
+        for (double q : qs) {
+            if (!(q >= 0.0 && q <= 1.0)) {
+                runtime_error("quantiles() arguments must be between 0 and 1");
+            }
+            auto const target = static_cast<double>(n_) * q;
+            while (static_cast<double>(weight) < target && idx + 1 < items.size()) {
+                weight += items[++idx].second;
+            }
+            out.push_back(items[idx].first);
+        }
+        return out;
+    }
+};
+
+namespace detail {
+
+struct quantiles_fn {
+    template <sequence Seq>
+        requires std::totally_ordered<value_t<Seq>> &&
+                 std::copyable<value_t<Seq>> &&
+                 std::constructible_from<value_t<Seq>, element_t<Seq>>
+    [[nodiscard]]
+    constexpr auto operator()(Seq&& seq, double eps) const -> quantile_sketch<value_t<Seq>>
+    {
+        quantile_sketch<value_t<Seq>> sketch(
+            quantile_sketch<value_t<Seq>>::k_for_epsilon(eps));
+
+        flux::for_each_while(seq, [&sketch](auto&& elem) {
+            sketch.add(value_t<Seq>(FLUX_FWD(elem)));
+            return true;
+        });
+
+        return sketch;
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto quantiles = detail::quantiles_fn{};
+
+} // namespace flux
+
+#endif // FLUX_ALGORITHM_QUANTILES_HPP_INCLUDED
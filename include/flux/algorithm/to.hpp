@@ -75,6 +75,18 @@ constexpr auto make_inserter(C& c)
     }
 }
 
+// When converting a sequence of sequences, an allocator (or memory resource)
+// passed for the outer container is also used for each inner container, so
+// that e.g. a std::pmr::vector<std::pmr::string> allocates all of its
+// strings from the same resource
+template <typename C, typename... Args>
+concept propagates_allocator =
+    sizeof...(Args) == 1 &&
+    (std::uses_allocator_v<C, std::remove_cvref_t<Args>> && ...) &&
+    requires { typename container_value_t<C>::allocator_type; } &&
+    (std::constructible_from<typename container_value_t<C>::allocator_type,
+                             std::remove_cvref_t<Args> const&> && ...);
+
 template <template <typename...> typename C, typename Seq, typename... Args>
 using ctad_direct_seq = decltype(C(FLUX_DECLVAL(Seq), FLUX_DECLVAL(Args)...));
 
@@ -143,9 +155,18 @@ constexpr auto to(Seq&& seq, Args&&... args) -> Container
         }
     } else {
         static_assert(sequence<element_t<Seq>>);
-        return flux::to<Container>(flux::map(flux::from_fwd_ref(FLUX_FWD(seq)), [](auto&& elem) {
-            return flux::to<detail::container_value_t<Container>>(FLUX_FWD(elem));
-        }), FLUX_FWD(args)...);
+        using Inner = detail::container_value_t<Container>;
+        if constexpr (detail::propagates_allocator<Container, Args...>) {
+            auto inner_alloc = typename Inner::allocator_type(std::as_const(args)...);
+            return flux::to<Container>(flux::map(flux::from_fwd_ref(FLUX_FWD(seq)),
+                [&inner_alloc](auto&& elem) {
+                    return flux::to<Inner>(FLUX_FWD(elem), inner_alloc);
+                }), FLUX_FWD(args)...);
+        } else {
+            return flux::to<Container>(flux::map(flux::from_fwd_ref(FLUX_FWD(seq)), [](auto&& elem) {
+                return flux::to<Inner>(FLUX_FWD(elem));
+            }), FLUX_FWD(args)...);
+        }
     }
 }
 
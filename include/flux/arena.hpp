@@ -0,0 +1,165 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ARENA_HPP_INCLUDED
+#define FLUX_ARENA_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace flux {
+
+/*
+ * A monotonic memory resource for short-lived allocations, such as the
+ * containers produced by flux::to() while handling a single request.
+ *
+ * Memory is obtained from the upstream resource in geometrically growing
+ * blocks and handed out by bumping a pointer; deallocation is a no-op.
+ * Calling reset() makes all of the memory available again. If the arena has
+ * grown to more than one block, they are replaced by a single block of the
+ * same total size, so that an arena which is reused for many similar
+ * workloads stops allocating from upstream after the first reset().
+ *
+ * Like std::pmr::monotonic_buffer_resource, an arena is not thread safe.
+ */
+FLUX_EXPORT
+class arena : public std::pmr::memory_resource {
+    struct block_header {
+        block_header* prev;
+        std::size_t size; // including the header
+    };
+
+    static constexpr std::size_t header_size =
+        (sizeof(block_header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    std::pmr::memory_resource* upstream_;
+    block_header* head_ = nullptr;
+    std::byte* cur_ = nullptr;
+    std::byte* end_ = nullptr;
+    std::size_t next_block_size_;
+    std::size_t bytes_allocated_ = 0;
+    std::size_t upstream_allocations_ = 0;
+
+    static auto block_begin(block_header* block) noexcept -> std::byte*
+    {
+        return reinterpret_cast<std::byte*>(block) + header_size;
+    }
+
+    static auto block_end(block_header* block) noexcept -> std::byte*
+    {
+        return reinterpret_cast<std::byte*>(block) + block->size;
+    }
+
+    auto add_block(std::size_t min_bytes) -> void
+    {
+        std::size_t size = std::max(next_block_size_, min_bytes + header_size);
+        void* mem = upstream_->allocate(size, alignof(std::max_align_t));
+        ++upstream_allocations_;
+        head_ = ::new (mem) block_header{head_, size};
+        cur_ = block_begin(head_);
+        end_ = block_end(head_);
+        next_block_size_ = size + size / 2;
+    }
+
+    auto free_blocks(block_header* block) noexcept -> void
+    {
+        while (block) {
+            block_header* prev = block->prev;
+            upstream_->deallocate(block, block->size, alignof(std::max_align_t));
+            block = prev;
+        }
+    }
+
+protected:
+    auto do_allocate(std::size_t bytes, std::size_t align) -> void* override
+    {
+        void* ptr = cur_;
+        std::size_t space = static_cast<std::size_t>(end_ - cur_);
+        if (!cur_ || !std::align(align, bytes, ptr, space)) {
+            add_block(bytes + align);
+            ptr = cur_;
+            space = static_cast<std::size_t>(end_ - cur_);
+            ptr = std::align(align, bytes, ptr, space);
+        }
+        cur_ = static_cast<std::byte*>(ptr) + bytes;
+        bytes_allocated_ += bytes;
+        return ptr;
+    }
+
+    auto do_deallocate(void*, std::size_t, std::size_t) -> void override {}
+
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+        -> bool override
+    {
+        return this == &other;
+    }
+
+public:
+    explicit arena(std::size_t initial_size = 4096,
+                   std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_(upstream),
+          next_block_size_(std::max(initial_size, std::size_t{64}) + header_size)
+    {}
+
+    explicit arena(std::pmr::memory_resource* upstream)
+        : arena(4096, upstream)
+    {}
+
+    arena(arena const&) = delete;
+    arena& operator=(arena const&) = delete;
+
+    ~arena() override { release(); }
+
+    /*
+     * Makes all memory owned by the arena available for reuse, coalescing
+     * multiple blocks into one. Any memory previously handed out by the
+     * arena must no longer be in use.
+     */
+    auto reset() -> void
+    {
+        if (head_ && head_->prev) {
+            std::size_t total = 0;
+            for (block_header* b = head_; b; b = b->prev) {
+                total += b->size;
+            }
+            release();
+            next_block_size_ = total;
+            add_block(0);
+        } else if (head_) {
+            cur_ = block_begin(head_);
+            end_ = block_end(head_);
+        }
+        bytes_allocated_ = 0;
+    }
+
+    // Returns all memory to the upstream resource
+    auto release() noexcept -> void
+    {
+        free_blocks(std::exchange(head_, nullptr));
+        cur_ = end_ = nullptr;
+        bytes_allocated_ = 0;
+    }
+
+    // The total size of the allocations made since the last reset() or release()
+    [[nodiscard]]
+    auto bytes_allocated() const noexcept -> std::size_t { return bytes_allocated_; }
+
+    // The number of blocks requested from the upstream resource over the
+    // lifetime of the arena
+    [[nodiscard]]
+    auto upstream_allocations() const noexcept -> std::size_t { return upstream_allocations_; }
+
+    [[nodiscard]]
+    auto upstream_resource() const noexcept -> std::pmr::memory_resource* { return upstream_; }
+};
+
+} // namespace flux
+
+#endif // FLUX_ARENA_HPP_INCLUDED
@@ -0,0 +1,15 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ASYNC_HPP_INCLUDED
+#define FLUX_ASYNC_HPP_INCLUDED
+
+#include <flux/async/async_generator.hpp>
+#include <flux/async/task.hpp>
+
+#if __has_include(<poll.h>) && __has_include(<unistd.h>)
+#include <flux/async/event_loop.hpp>
+#endif
+
+#endif // FLUX_ASYNC_HPP_INCLUDED
@@ -0,0 +1,405 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ASYNC_ASYNC_GENERATOR_HPP_INCLUDED
+#define FLUX_ASYNC_ASYNC_GENERATOR_HPP_INCLUDED
+
+#include <flux/core.hpp>
+#include <flux/async/task.hpp>
+#include <flux/sequence/generator.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+namespace detail {
+
+template <typename A>
+auto get_awaiter(A&& a) -> decltype(auto)
+{
+    if constexpr (requires { FLUX_FWD(a).operator co_await(); }) {
+        return FLUX_FWD(a).operator co_await();
+    } else if constexpr (requires { operator co_await(FLUX_FWD(a)); }) {
+        return operator co_await(FLUX_FWD(a));
+    } else {
+        return FLUX_FWD(a);
+    }
+}
+
+template <typename A>
+using await_result_t = decltype(get_awaiter(std::declval<A>()).await_resume());
+
+template <typename>
+inline constexpr bool is_flux_optional = false;
+
+template <typename T>
+inline constexpr bool is_flux_optional<flux::optional<T>> = true;
+
+template <typename>
+struct optional_element {};
+
+template <typename T>
+struct optional_element<flux::optional<T>> {
+    using type = T;
+};
+
+} // namespace detail
+
+FLUX_EXPORT
+template <typename Seq>
+using async_next_t = detail::await_result_t<decltype(std::declval<Seq&>().next())>;
+
+/*
+ * An async sequence has a member function next() which returns an awaitable.
+ * Awaiting it produces a flux::optional holding the next element, or an
+ * empty optional once the sequence is exhausted.
+ */
+FLUX_EXPORT
+template <typename Seq>
+concept async_sequence =
+    requires { typename async_next_t<Seq>; } &&
+    detail::is_flux_optional<std::remove_cvref_t<async_next_t<Seq>>>;
+
+FLUX_EXPORT
+template <async_sequence Seq>
+using async_element_t =
+    typename detail::optional_element<std::remove_cvref_t<async_next_t<Seq>>>::type;
+
+FLUX_EXPORT
+template <async_sequence Seq>
+using async_value_t = std::remove_cvref_t<async_element_t<Seq>>;
+
+FLUX_EXPORT
+template <typename ElemT>
+    requires (std::is_object_v<ElemT> || std::is_lvalue_reference_v<ElemT>)
+class async_generator;
+
+namespace detail {
+
+template <typename Seq>
+concept adaptable_async_sequence =
+    async_sequence<std::remove_cvref_t<Seq>> &&
+    std::move_constructible<std::remove_cvref_t<Seq>>;
+
+template <typename Seq>
+using async_yield_t = std::conditional_t<std::is_reference_v<async_element_t<Seq>>,
+                                         async_element_t<Seq>,
+                                         async_value_t<Seq>>;
+
+struct async_map_fn {
+    template <adaptable_async_sequence Seq, typename Func,
+              typename S = std::remove_cvref_t<Seq>>
+        requires std::invocable<Func&, async_element_t<S>>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, Func func) const
+        -> async_generator<std::invoke_result_t<Func&, async_element_t<S>>>
+    {
+        return impl<S>(S(FLUX_FWD(seq)), std::move(func));
+    }
+
+private:
+    template <typename S, typename Func>
+    static auto impl(S seq, Func func)
+        -> async_generator<std::invoke_result_t<Func&, async_element_t<S>>>
+    {
+        while (auto elem = co_await seq.next()) {
+            co_yield std::invoke(func, std::forward<async_element_t<S>>(*elem));
+        }
+    }
+};
+
+struct async_filter_fn {
+    template <adaptable_async_sequence Seq, typename Pred,
+              typename S = std::remove_cvref_t<Seq>>
+        requires std::predicate<Pred&, async_element_t<S>&>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, Pred pred) const -> async_generator<async_yield_t<S>>
+    {
+        return impl<S>(S(FLUX_FWD(seq)), std::move(pred));
+    }
+
+private:
+    template <typename S, typename Pred>
+    static auto impl(S seq, Pred pred) -> async_generator<async_yield_t<S>>
+    {
+        while (auto elem = co_await seq.next()) {
+            if (std::invoke(pred, *elem)) {
+                co_yield std::forward<async_element_t<S>>(*elem);
+            }
+        }
+    }
+};
+
+struct async_take_fn {
+    template <adaptable_async_sequence Seq, typename S = std::remove_cvref_t<Seq>>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, num::integral auto count) const
+        -> async_generator<async_yield_t<S>>
+    {
+        auto count_ = num::checked_cast<distance_t>(count);
+        if (count_ < 0) {
+            runtime_error("Negative argument passed to take()");
+        }
+        return impl<S>(S(FLUX_FWD(seq)), count_);
+    }
+
+private:
+    template <typename S>
+    static auto impl(S seq, distance_t count) -> async_generator<async_yield_t<S>>
+    {
+        // Don't pull another element from the underlying sequence once we
+        // have enough, as doing so may block waiting for I/O
+        while (count > 0) {
+            auto elem = co_await seq.next();
+            if (!elem) {
+                break;
+            }
+            --count;
+            co_yield std::forward<async_element_t<S>>(*elem);
+        }
+    }
+};
+
+struct async_chunk_fn {
+    template <adaptable_async_sequence Seq, typename S = std::remove_cvref_t<Seq>>
+        requires std::constructible_from<async_value_t<S>, async_element_t<S>>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, num::integral auto chunk_sz) const
+        -> async_generator<std::vector<async_value_t<S>>>
+    {
+        auto chunk_sz_ = num::checked_cast<distance_t>(chunk_sz);
+        if (chunk_sz_ <= 0) {
+            runtime_error("Chunk size must be greater than zero");
+        }
+        return impl<S>(S(FLUX_FWD(seq)), chunk_sz_);
+    }
+
+private:
+    template <typename S>
+    static auto impl(S seq, distance_t chunk_sz)
+        -> async_generator<std::vector<async_value_t<S>>>
+    {
+        std::vector<async_value_t<S>> chunk;
+        chunk.reserve(num::unchecked_cast<std::size_t>(chunk_sz));
+
+        while (auto elem = co_await seq.next()) {
+            chunk.emplace_back(std::forward<async_element_t<S>>(*elem));
+            if (num::cast<distance_t>(chunk.size()) == chunk_sz) {
+                co_yield chunk;
+                chunk.clear();
+            }
+        }
+
+        if (!chunk.empty()) {
+            co_yield chunk;
+        }
+    }
+};
+
+struct async_for_each_fn {
+    template <adaptable_async_sequence Seq, typename Func,
+              typename S = std::remove_cvref_t<Seq>>
+        requires std::invocable<Func&, async_element_t<S>>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, Func func) const -> task<Func>
+    {
+        return impl<S>(S(FLUX_FWD(seq)), std::move(func));
+    }
+
+private:
+    template <typename S, typename Func>
+    static auto impl(S seq, Func func) -> task<Func>
+    {
+        while (auto elem = co_await seq.next()) {
+            std::invoke(func, std::forward<async_element_t<S>>(*elem));
+        }
+        co_return func;
+    }
+};
+
+struct async_fold_fn {
+    template <adaptable_async_sequence Seq, typename Func,
+              typename S = std::remove_cvref_t<Seq>,
+              std::movable Init = async_value_t<S>>
+        requires std::invocable<Func&, Init, async_element_t<S>> &&
+                 std::assignable_from<Init&, std::invoke_result_t<Func&, Init, async_element_t<S>>>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, Func func, Init init = Init{}) const -> task<Init>
+    {
+        return impl<S>(S(FLUX_FWD(seq)), std::move(func), std::move(init));
+    }
+
+private:
+    template <typename S, typename Func, typename Init>
+    static auto impl(S seq, Func func, Init init) -> task<Init>
+    {
+        while (auto elem = co_await seq.next()) {
+            init = std::invoke(func, std::move(init),
+                               std::forward<async_element_t<S>>(*elem));
+        }
+        co_return init;
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto async_map = detail::async_map_fn{};
+FLUX_EXPORT inline constexpr auto async_filter = detail::async_filter_fn{};
+FLUX_EXPORT inline constexpr auto async_take = detail::async_take_fn{};
+FLUX_EXPORT inline constexpr auto async_chunk = detail::async_chunk_fn{};
+FLUX_EXPORT inline constexpr auto async_for_each = detail::async_for_each_fn{};
+FLUX_EXPORT inline constexpr auto async_fold = detail::async_fold_fn{};
+
+/*
+ * A coroutine which produces a sequence of elements asynchronously.
+ *
+ * The body may use both co_yield and co_await. Consumers obtain elements by
+ * awaiting next(), which transfers control directly to the generator and
+ * back again once it yields, so no scheduler is involved unless the
+ * generator itself awaits I/O.
+ */
+FLUX_EXPORT
+template <typename ElemT>
+    requires (std::is_object_v<ElemT> || std::is_lvalue_reference_v<ElemT>)
+class async_generator {
+public:
+    using yielded_type = std::conditional_t<std::is_reference_v<ElemT>,
+                                            ElemT,
+                                            ElemT const&>;
+
+    struct promise_type;
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+private:
+    // Returns control to whichever coroutine is waiting on next()
+    struct yield_awaiter {
+        auto await_ready() const noexcept -> bool { return false; }
+
+        auto await_suspend(handle_type self) noexcept -> std::coroutine_handle<>
+        {
+            return self.promise().consumer_;
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    struct next_awaiter {
+        handle_type coro;
+
+        auto await_ready() const noexcept -> bool { return !coro || coro.done(); }
+
+        auto await_suspend(std::coroutine_handle<> consumer) noexcept
+            -> std::coroutine_handle<>
+        {
+            coro.promise().consumer_ = consumer;
+            return coro;
+        }
+
+        auto await_resume() -> flux::optional<yielded_type>
+        {
+            if (!coro) {
+                return nullopt;
+            }
+            auto& p = coro.promise();
+            if (coro.done()) {
+                if (p.except_) {
+                    std::rethrow_exception(std::exchange(p.except_, nullptr));
+                }
+                return nullopt;
+            }
+            return flux::optional<yielded_type>(static_cast<yielded_type>(*p.ptr_));
+        }
+    };
+
+public:
+    struct promise_type : detail::generator_promise_alloc {
+        auto initial_suspend() noexcept { return std::suspend_always{}; }
+
+        auto final_suspend() noexcept { return yield_awaiter{}; }
+
+        auto get_return_object() noexcept
+        {
+            return async_generator(handle_type::from_promise(*this));
+        }
+
+        auto yield_value(yielded_type elem) noexcept
+        {
+            ptr_ = std::addressof(elem);
+            return yield_awaiter{};
+        }
+
+        auto unhandled_exception() noexcept -> void
+        {
+            except_ = std::current_exception();
+        }
+
+        void return_void() noexcept {}
+
+        std::add_pointer_t<yielded_type> ptr_ = nullptr;
+        std::coroutine_handle<> consumer_;
+        std::exception_ptr except_;
+    };
+
+private:
+    handle_type coro_;
+
+    explicit async_generator(handle_type handle) noexcept : coro_(handle) {}
+
+public:
+    async_generator(async_generator&& other) noexcept
+        : coro_(std::exchange(other.coro_, {}))
+    {}
+
+    async_generator& operator=(async_generator&& other) noexcept
+    {
+        std::swap(coro_, other.coro_);
+        return *this;
+    }
+
+    ~async_generator()
+    {
+        if (coro_) { coro_.destroy(); }
+    }
+
+    /*
+     * Returns an awaitable which resumes the generator until it yields its
+     * next element, producing an empty optional once it has finished
+     */
+    [[nodiscard]]
+    auto next() noexcept -> next_awaiter { return next_awaiter{coro_}; }
+
+    template <typename Func>
+    [[nodiscard]]
+    auto map(Func func) && { return async_map(std::move(*this), std::move(func)); }
+
+    template <typename Pred>
+    [[nodiscard]]
+    auto filter(Pred pred) && { return async_filter(std::move(*this), std::move(pred)); }
+
+    [[nodiscard]]
+    auto take(num::integral auto count) && { return async_take(std::move(*this), count); }
+
+    [[nodiscard]]
+    auto chunk(num::integral auto chunk_sz) && { return async_chunk(std::move(*this), chunk_sz); }
+
+    template <typename Func>
+    [[nodiscard]]
+    auto for_each(Func func) && { return async_for_each(std::move(*this), std::move(func)); }
+
+    template <typename Func, typename Init = std::remove_cvref_t<ElemT>>
+    [[nodiscard]]
+    auto fold(Func func, Init init = Init{}) &&
+    {
+        return async_fold(std::move(*this), std::move(func), std::move(init));
+    }
+};
+
+} // namespace flux
+
+#endif // FLUX_ASYNC_ASYNC_GENERATOR_HPP_INCLUDED
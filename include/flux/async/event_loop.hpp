@@ -0,0 +1,230 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ASYNC_EVENT_LOOP_HPP_INCLUDED
+#define FLUX_ASYNC_EVENT_LOOP_HPP_INCLUDED
+
+#include <flux/core.hpp>
+#include <flux/async/async_generator.hpp>
+#include <flux/async/task.hpp>
+#include <flux/sequence/array_ptr.hpp>
+
+#include <cerrno>
+#include <coroutine>
+#include <deque>
+#include <system_error>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
+namespace flux {
+
+/*
+ * A minimal single-threaded event loop for running tasks which wait on
+ * POSIX file descriptors.
+ *
+ * Coroutines which are ready to run are resumed in FIFO order. When there
+ * is nothing left to run, the loop blocks in poll() until one of the file
+ * descriptors being waited on becomes ready.
+ */
+FLUX_EXPORT
+class event_loop {
+    struct io_waiter {
+        int fd;
+        short events;
+        std::coroutine_handle<> handle;
+    };
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::vector<io_waiter> waiters_;
+    std::vector<task<void>> spawned_;
+
+    struct schedule_awaiter {
+        event_loop& loop;
+
+        auto await_ready() const noexcept -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<> handle) -> void
+        {
+            loop.ready_.push_back(handle);
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    struct io_awaiter {
+        event_loop& loop;
+        int fd;
+        short events;
+
+        auto await_ready() const noexcept -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<> handle) -> void
+        {
+            loop.waiters_.push_back(io_waiter{fd, events, handle});
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    [[noreturn]] static auto throw_errno(char const* what) -> void
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Blocks until at least one waiting file descriptor is ready, then moves
+    // the corresponding coroutines to the ready queue
+    auto wait_for_io() -> void
+    {
+        std::vector<::pollfd> fds;
+        fds.reserve(waiters_.size());
+        for (io_waiter const& w : waiters_) {
+            fds.push_back(::pollfd{.fd = w.fd, .events = w.events, .revents = 0});
+        }
+
+        if (::poll(fds.data(), static_cast<::nfds_t>(fds.size()), -1) < 0) {
+            if (errno == EINTR) {
+                return;
+            }
+            throw_errno("poll");
+        }
+
+        std::size_t n_waiting = 0;
+        for (std::size_t i = 0; i < fds.size(); i++) {
+            if (fds[i].revents != 0) {
+                ready_.push_back(waiters_[i].handle);
+            } else {
+                waiters_[n_waiting++] = waiters_[i];
+            }
+        }
+        waiters_.resize(n_waiting);
+    }
+
+    // Destroys finished spawned tasks, propagating any exceptions
+    auto reap_spawned() -> void
+    {
+        for (std::size_t i = 0; i < spawned_.size(); i++) {
+            if (spawned_[i].done()) {
+                task<void> t = std::move(spawned_[i]);
+                spawned_.erase(spawned_.begin() + static_cast<std::ptrdiff_t>(i--));
+                detail::task_access::result(t);
+            }
+        }
+    }
+
+    auto read_blocks_impl(int fd, distance_t block_size)
+        -> async_generator<array_ptr<char const>>
+    {
+        std::vector<char> buf(num::checked_cast<std::size_t>(block_size));
+        while (true) {
+            distance_t n = co_await read_some(fd, buf.data(), block_size);
+            if (n == 0) {
+                break;
+            }
+            co_yield make_array_ptr_unchecked(static_cast<char const*>(buf.data()), n);
+        }
+    }
+
+public:
+    event_loop() = default;
+    event_loop(event_loop&&) = delete;
+    event_loop& operator=(event_loop&&) = delete;
+
+    /*
+     * Suspends the current coroutine and puts it at the back of the ready
+     * queue, allowing other coroutines to run
+     */
+    [[nodiscard]]
+    auto schedule() noexcept -> schedule_awaiter { return schedule_awaiter{*this}; }
+
+    // Suspends the current coroutine until `fd` is ready for reading
+    [[nodiscard]]
+    auto readable(int fd) noexcept -> io_awaiter { return io_awaiter{*this, fd, POLLIN}; }
+
+    // Suspends the current coroutine until `fd` is ready for writing
+    [[nodiscard]]
+    auto writable(int fd) noexcept -> io_awaiter { return io_awaiter{*this, fd, POLLOUT}; }
+
+    /*
+     * Waits until `fd` is readable, then reads up to `size` bytes into `buf`.
+     * Returns the number of bytes read, which is zero at end of file.
+     */
+    auto read_some(int fd, char* buf, distance_t size) -> task<distance_t>
+    {
+        while (true) {
+            co_await readable(fd);
+            auto n = ::read(fd, buf, num::checked_cast<std::size_t>(size));
+            if (n >= 0) {
+                co_return num::checked_cast<distance_t>(n);
+            } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                throw_errno("read");
+            }
+        }
+    }
+
+    // Writes all `size` bytes from `buf` to `fd`, waiting as necessary
+    auto write_all(int fd, char const* buf, distance_t size) -> task<>
+    {
+        while (size > 0) {
+            co_await writable(fd);
+            auto n = ::write(fd, buf, num::checked_cast<std::size_t>(size));
+            if (n >= 0) {
+                buf += n;
+                size -= num::checked_cast<distance_t>(n);
+            } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                throw_errno("write");
+            }
+        }
+    }
+
+    /*
+     * Returns an async sequence of the blocks read from `fd` until end of
+     * file. Each block is only valid until the next one is requested.
+     */
+    [[nodiscard]]
+    auto read_blocks(int fd, distance_t block_size = 4096)
+        -> async_generator<array_ptr<char const>>
+    {
+        FLUX_ASSERT(block_size > 0);
+        return read_blocks_impl(fd, block_size);
+    }
+
+    /*
+     * Starts running `t` concurrently with other tasks on this loop. The loop
+     * owns the task; an exception escaping it is rethrown from run().
+     */
+    auto spawn(task<> t) -> void
+    {
+        ready_.push_back(detail::task_access::handle(t));
+        spawned_.push_back(std::move(t));
+    }
+
+    // Runs the loop until `t` has completed, and returns its result
+    template <typename T>
+    auto run(task<T> t) -> T
+    {
+        auto handle = detail::task_access::handle(t);
+        FLUX_ASSERT(handle != nullptr);
+        ready_.push_back(handle);
+
+        while (!handle.done()) {
+            if (!ready_.empty()) {
+                auto next = ready_.front();
+                ready_.pop_front();
+                next.resume();
+                reap_spawned();
+            } else {
+                FLUX_ASSERT(!waiters_.empty() && "event_loop::run(): deadlock");
+                wait_for_io();
+            }
+        }
+
+        return detail::task_access::result(t);
+    }
+};
+
+} // namespace flux
+
+#endif // FLUX_ASYNC_EVENT_LOOP_HPP_INCLUDED
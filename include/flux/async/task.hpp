@@ -0,0 +1,200 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_ASYNC_TASK_HPP_INCLUDED
+#define FLUX_ASYNC_TASK_HPP_INCLUDED
+
+#include <flux/core.hpp>
+#include <flux/sequence/generator.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace flux {
+
+namespace detail {
+
+struct task_access;
+
+struct task_promise_base : generator_promise_alloc {
+private:
+    struct final_awaiter {
+        auto await_ready() const noexcept -> bool { return false; }
+
+        template <typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> self) noexcept
+            -> std::coroutine_handle<>
+        {
+            auto cont = self.promise().continuation_;
+            return cont ? cont : std::noop_coroutine();
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+public:
+    auto initial_suspend() noexcept { return std::suspend_always{}; }
+
+    auto final_suspend() noexcept { return final_awaiter{}; }
+
+    auto unhandled_exception() noexcept -> void
+    {
+        except_ = std::current_exception();
+    }
+
+    auto rethrow_if_exception() -> void
+    {
+        if (except_) {
+            std::rethrow_exception(std::exchange(except_, nullptr));
+        }
+    }
+
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr except_;
+};
+
+template <typename T>
+struct task_promise : task_promise_base {
+    template <typename U = T>
+        requires std::convertible_to<U, T>
+    auto return_value(U&& val) -> void
+    {
+        if constexpr (std::is_reference_v<T>) {
+            value_.emplace(static_cast<T>(FLUX_FWD(val)));
+        } else {
+            value_.emplace(FLUX_FWD(val));
+        }
+    }
+
+    auto result() -> T
+    {
+        rethrow_if_exception();
+        if constexpr (std::is_reference_v<T>) {
+            return *value_;
+        } else {
+            return std::move(*value_);
+        }
+    }
+
+    flux::optional<std::conditional_t<std::is_reference_v<T>, T, std::remove_cv_t<T>>> value_;
+};
+
+template <>
+struct task_promise<void> : task_promise_base {
+    auto return_void() noexcept -> void {}
+
+    auto result() -> void { rethrow_if_exception(); }
+};
+
+} // namespace detail
+
+/*
+ * A lazily-started coroutine which produces a single value of type T.
+ *
+ * The coroutine does not begin executing until the task is awaited, at which
+ * point control is transferred to it directly. When it completes, the
+ * awaiting coroutine is resumed with the result (or exception).
+ */
+FLUX_EXPORT
+template <typename T = void>
+class [[nodiscard]] task {
+public:
+    struct promise_type : detail::task_promise<T> {
+        auto get_return_object() noexcept -> task
+        {
+            return task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+private:
+    handle_type coro_;
+
+    explicit task(handle_type handle) noexcept : coro_(handle) {}
+
+    struct awaiter {
+        handle_type coro;
+
+        auto await_ready() const noexcept -> bool { return coro.done(); }
+
+        auto await_suspend(std::coroutine_handle<> cont) noexcept -> std::coroutine_handle<>
+        {
+            coro.promise().continuation_ = cont;
+            return coro;
+        }
+
+        auto await_resume() -> T { return coro.promise().result(); }
+    };
+
+    friend struct detail::task_access;
+
+public:
+    task(task&& other) noexcept : coro_(std::exchange(other.coro_, {})) {}
+
+    task& operator=(task&& other) noexcept
+    {
+        std::swap(coro_, other.coro_);
+        return *this;
+    }
+
+    ~task()
+    {
+        if (coro_) { coro_.destroy(); }
+    }
+
+    [[nodiscard]]
+    auto done() const noexcept -> bool { return !coro_ || coro_.done(); }
+
+    auto operator co_await() && noexcept -> awaiter
+    {
+        FLUX_ASSERT(coro_ != nullptr);
+        return awaiter{coro_};
+    }
+};
+
+namespace detail {
+
+// Gives schedulers access to the underlying coroutine of a task, so that it
+// can be started without another coroutine awaiting it
+struct task_access {
+    template <typename T>
+    static auto handle(task<T> const& t) noexcept -> std::coroutine_handle<>
+    {
+        return t.coro_;
+    }
+
+    template <typename T>
+    static auto result(task<T>& t) -> T
+    {
+        return t.coro_.promise().result();
+    }
+};
+
+struct sync_wait_fn {
+    template <typename T>
+    auto operator()(task<T> t) const -> T
+    {
+        auto handle = task_access::handle(t);
+        FLUX_ASSERT(handle != nullptr);
+        handle.resume();
+        FLUX_ASSERT(t.done() && "sync_wait(): task suspended waiting for an event loop");
+        return task_access::result(t);
+    }
+};
+
+} // namespace detail
+
+/*
+ * Runs a task to completion on the current thread and returns its result.
+ *
+ * The task must not suspend waiting for an external event: tasks which
+ * perform I/O should be run with an event_loop instead.
+ */
+FLUX_EXPORT inline constexpr auto sync_wait = detail::sync_wait_fn{};
+
+} // namespace flux
+
+#endif // FLUX_ASYNC_TASK_HPP_INCLUDED
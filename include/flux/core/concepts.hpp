@@ -439,6 +439,39 @@ struct default_sequence_traits {
 
 namespace detail {
 
+/*
+ * The same loop as default_sequence_traits::for_each_while(), but reading
+ * elements with read_at_unchecked(). Every cursor it reads has just been
+ * compared against last() or is_last(), so adaptors which implement those
+ * correctly in terms of their bases can use this to avoid re-checking each
+ * base cursor on every element.
+ */
+template <typename Self, typename Pred>
+    requires sequence_requirements<Self>
+constexpr auto for_each_while_unchecked(Self& self, Pred&& pred) -> cursor_t<Self>
+{
+    using Traits = traits_t<Self>;
+
+    auto cur = Traits::first(self);
+    if constexpr (bounded_sequence<Self> && regular_cursor<cursor_t<Self>>) {
+        auto const last = Traits::last(self);
+        while (cur != last) {
+            if (!std::invoke(pred, Traits::read_at_unchecked(self, cur))) {
+                break;
+            }
+            Traits::inc(self, cur);
+        }
+    } else {
+        while (!Traits::is_last(self, cur)) {
+            if (!std::invoke(pred, Traits::read_at_unchecked(self, cur))) {
+                break;
+            }
+            Traits::inc(self, cur);
+        }
+    }
+    return cur;
+}
+
 template <typename T>
 concept has_nested_sequence_traits =
     requires { typename T::flux_sequence_traits; } &&
@@ -26,6 +26,11 @@
 #define FLUX_INTEGER_CAST_POLICY_CHECKED 1001
 #define FLUX_INTEGER_CAST_POLICY_UNCHECKED 1002
 
+#define FLUX_SIMD_LEVEL_SCALAR 0
+#define FLUX_SIMD_LEVEL_SSE2   1
+#define FLUX_SIMD_LEVEL_AVX2   2
+#define FLUX_SIMD_LEVEL_AVX512 3
+
 // Default error policy is terminate
 #define FLUX_DEFAULT_ERROR_POLICY FLUX_ERROR_POLICY_TERMINATE
 
@@ -113,6 +118,23 @@
 #  endif
 #endif // FLUX_DISABLE_STATIC_BOUNDS_CHECKING
 
+// Should generators recycle their coroutine frames using a thread-local pool?
+#ifndef FLUX_ENABLE_GENERATOR_FRAME_POOL
+#  define FLUX_ENABLE_GENERATOR_FRAME_POOL 1
+#endif
+
+// Should instrument() count sequence operations, or pass sequences through
+// untouched?
+#ifndef FLUX_ENABLE_INSTRUMENTATION
+#  define FLUX_ENABLE_INSTRUMENTATION 0
+#endif
+
+// Which instruction sets may the SIMD kernels use? The best one the CPU
+// supports, up to this level, is chosen at runtime
+#ifndef FLUX_MAX_SIMD_LEVEL
+#  define FLUX_MAX_SIMD_LEVEL FLUX_SIMD_LEVEL_AVX512
+#endif
+
 // Default int_t is ptrdiff_t
 #define FLUX_DEFAULT_INT_TYPE std::ptrdiff_t
 
@@ -149,6 +171,14 @@ enum class integer_cast_policy {
     unchecked = FLUX_INTEGER_CAST_POLICY_UNCHECKED
 };
 
+FLUX_EXPORT
+enum class simd_level {
+    scalar = FLUX_SIMD_LEVEL_SCALAR,
+    sse2 = FLUX_SIMD_LEVEL_SSE2,
+    avx2 = FLUX_SIMD_LEVEL_AVX2,
+    avx512 = FLUX_SIMD_LEVEL_AVX512
+};
+
 namespace config {
 
 FLUX_EXPORT
@@ -174,6 +204,15 @@ inline constexpr bool print_error_on_terminate = FLUX_PRINT_ERROR_ON_TERMINATE;
 FLUX_EXPORT
 inline constexpr bool enable_debug_asserts = FLUX_ENABLE_DEBUG_ASSERTS;
 
+FLUX_EXPORT
+inline constexpr bool enable_generator_frame_pool = FLUX_ENABLE_GENERATOR_FRAME_POOL;
+
+FLUX_EXPORT
+inline constexpr bool enable_instrumentation = FLUX_ENABLE_INSTRUMENTATION;
+
+FLUX_EXPORT
+inline constexpr simd_level max_simd_level = static_cast<simd_level>(FLUX_MAX_SIMD_LEVEL);
+
 } // namespace config
 
 } // namespace flux
@@ -27,6 +27,9 @@ FLUX_EXPORT
 template <sequence Seq>
 using bounds_t = bounds<cursor_t<Seq>>;
 
+FLUX_EXPORT
+struct instrument_counters;
+
 template <typename Derived>
 struct inline_sequence_base {
 private:
@@ -265,6 +268,13 @@ public:
         requires multipass_sequence<Derived> &&
                  std::equality_comparable<element_t<Derived>>;
 
+    template <typename D = Derived, typename Hash = std::hash<value_t<D>>,
+              typename Eq = std::equal_to<>>
+        requires std::invocable<Hash const&, element_t<D>&> &&
+                 std::predicate<Eq const&, value_t<D> const&, element_t<D>&>
+    [[nodiscard]]
+    constexpr auto distinct(Hash hash = Hash{}, Eq eq = Eq{}) &&;
+
     [[nodiscard]]
     constexpr auto drop(num::integral auto count) &&;
 
@@ -309,6 +319,9 @@ public:
     [[nodiscard]]
     constexpr auto map(Func func) &&;
 
+    [[nodiscard]]
+    constexpr auto instrument(instrument_counters& counters) &&;
+
     template <adaptable_sequence Mask>
         requires detail::boolean_testable<element_t<Mask>>
     [[nodiscard]]
@@ -385,6 +398,13 @@ public:
      * Algorithms
      */
 
+    /// Groups elements by key using a hash table, folding each group into an accumulator
+    template <typename KeyFn, typename Init, typename Func>
+        requires std::invocable<KeyFn&, element_t<Derived>&> &&
+                 foldable<Derived, Func, Init>
+    [[nodiscard]]
+    constexpr auto aggregate_by(KeyFn key_fn, Init init, Func func);
+
     /// Returns `true` if every element of the sequence satisfies the predicate
     template <typename Pred>
         requires std::predicate<Pred&, element_t<Derived>>
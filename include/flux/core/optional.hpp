@@ -27,56 +27,127 @@ concept can_optional =
 
 }
 
+/*
+ * Customisation point allowing flux::optional<T> to store its "disengaged"
+ * state inside a T, rather than in a separate flag.
+ *
+ * A specialisation must provide
+ *
+ *    static constexpr auto null_value() noexcept -> T;
+ *    static constexpr auto is_null(T const&) noexcept -> bool;
+ *
+ * where null_value() returns a value which is never stored in an engaged
+ * optional. Types using a niche must be trivially copyable.
+ *
+ * Only the owner of a type can promise that some value of it is never
+ * stored, so flux provides no niches for fundamental types: every value of
+ * an integer or floating point type is one that a user may legitimately
+ * put in an optional. Flux does use niches for some of its own cursor
+ * types, for example the cursor of flux::single().
+ */
+FLUX_EXPORT
+template <typename T>
+struct optional_niche {};
+
+namespace detail {
+
+// These are spelled as concepts so that the constrained partial
+// specialisations of optional below are ordered by subsumption
+template <typename T>
+concept optional_object = can_optional<T> && std::is_object_v<T>;
+
+template <typename T>
+concept has_optional_niche =
+    optional_object<T> &&
+    std::is_trivially_copyable_v<T> &&
+    requires (T const& t) {
+        { optional_niche<T>::null_value() } noexcept -> std::same_as<T>;
+        { optional_niche<T>::is_null(t) } noexcept -> std::same_as<bool>;
+    };
+
+struct empty_flag {};
+
+}
+
 FLUX_EXPORT
 template <typename T>
 class optional;
 
-template <detail::can_optional T>
-    requires std::is_object_v<T>
+template <detail::optional_object T>
 class optional<T> {
 
+    static constexpr bool use_niche = detail::has_optional_niche<T>;
+
+    using flag_t = std::conditional_t<use_niche, detail::empty_flag, bool>;
+
     struct dummy {};
 
+    // When T has a niche, item_ is always the active member, holding
+    // optional_niche<T>::null_value() when the optional is disengaged
     union {
         dummy dummy_{};
         T item_;
     };
 
-    bool engaged_ = false;
+    FLUX_NO_UNIQUE_ADDRESS flag_t engaged_{};
+
+    static constexpr auto engaged_flag() -> flag_t
+    {
+        if constexpr (use_niche) {
+            return flag_t{};
+        } else {
+            return true;
+        }
+    }
+
+    constexpr auto check_not_null() const -> void
+    {
+        if constexpr (use_niche) {
+            FLUX_ASSERT(!optional_niche<T>::is_null(item_));
+        }
+    }
 
     template <typename... Args>
     constexpr auto construct(Args&&... args) {
         std::construct_at(std::addressof(item_), FLUX_FWD(args)...);
-        engaged_ = true;
+        engaged_ = engaged_flag();
     }
 
 public:
 
     constexpr optional() noexcept {}
 
-    constexpr explicit(false) optional(nullopt_t) noexcept {}
+    constexpr optional() noexcept requires use_niche
+        : item_(optional_niche<T>::null_value())
+    {}
+
+    constexpr explicit(false) optional(nullopt_t) noexcept : optional() {}
 
     template <decays_to<T> U = T>
     constexpr explicit optional(U&& item)
-        noexcept(std::is_nothrow_constructible_v<T, U>)
+        noexcept(std::is_nothrow_constructible_v<T, U> && !use_niche)
         : item_(FLUX_FWD(item)),
-          engaged_(true)
-    {}
+          engaged_(engaged_flag())
+    {
+        check_not_null();
+    }
 
     template <typename... Args>
         requires std::constructible_from<T, Args...>
     constexpr explicit optional(std::in_place_t, Args&&... args)
-        noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        noexcept(std::is_nothrow_constructible_v<T, Args...> && !use_niche)
         : item_(FLUX_FWD(args)...),
-          engaged_(true)
-    {}
+          engaged_(engaged_flag())
+    {
+        check_not_null();
+    }
 
     /*
      * Destructors
      */
     constexpr ~optional()
     {
-        if (engaged_) {
+        if (has_value()) {
             item_.T::~T();
         }
     }
@@ -90,7 +161,7 @@ public:
         noexcept(std::is_nothrow_copy_constructible_v<T>)
         requires std::copy_constructible<T>
     {
-        if (other.engaged_) {
+        if (use_niche || other.has_value()) {
             construct(other.item_);
         }
     }
@@ -108,8 +179,8 @@ public:
                  std::is_nothrow_copy_constructible_v<T>)
         requires std::copy_constructible<T>
     {
-        if (engaged_) {
-            if (other.engaged_) {
+        if (has_value()) {
+            if (other.has_value()) {
                 if constexpr (std::is_copy_assignable_v<T>) {
                     item_ = other.item_;
                 } else {
@@ -120,7 +191,7 @@ public:
                 reset();
             }
         } else {
-            if (other.engaged_) {
+            if (other.has_value()) {
                 construct(other.item_);
             }
         }
@@ -139,7 +210,7 @@ public:
         noexcept(std::is_nothrow_move_constructible_v<T>)
         requires std::move_constructible<T>
     {
-        if (other.engaged_) {
+        if (use_niche || other.has_value()) {
             construct(std::move(other).item_);
         }
     }
@@ -157,8 +228,8 @@ public:
                  std::is_nothrow_move_assignable_v<T>)
         requires std::move_constructible<T>
     {
-        if (engaged_) {
-            if (other.engaged_) {
+        if (has_value()) {
+            if (other.has_value()) {
                 if constexpr (std::is_move_assignable_v<T>) {
                     item_ = std::move(other).item_;
                 } else {
@@ -169,7 +240,7 @@ public:
                 reset();
             }
         } else {
-            if (other.engaged_) {
+            if (other.has_value()) {
                 construct(std::move(other).item_);
             }
         }
@@ -185,9 +256,16 @@ public:
      * Observers
      */
     [[nodiscard]]
-    constexpr auto has_value() const -> bool { return engaged_; }
+    constexpr auto has_value() const -> bool
+    {
+        if constexpr (use_niche) {
+            return !optional_niche<T>::is_null(item_);
+        } else {
+            return engaged_;
+        }
+    }
 
-    constexpr explicit operator bool() const { return engaged_; }
+    constexpr explicit operator bool() const { return has_value(); }
 
     template <decays_to<optional> Opt>
     [[nodiscard]]
@@ -303,7 +381,9 @@ public:
 
     constexpr auto reset() -> void
     {
-        if (engaged_) {
+        if constexpr (use_niche) {
+            item_ = optional_niche<T>::null_value();
+        } else if (engaged_) {
             item_.T::~T();
             engaged_ = false;
         }
@@ -315,6 +395,7 @@ public:
     {
         reset();
         construct(FLUX_FWD(args)...);
+        check_not_null();
         return item_;
     }
 
@@ -328,7 +409,7 @@ public:
     constexpr auto map(F&& func) & -> optional<std::invoke_result_t<F, T&>>
     {
         using R = optional<std::invoke_result_t<F, T&>>;
-        if (engaged_) {
+        if (has_value()) {
             return R(std::invoke(FLUX_FWD(func), value_unchecked()));
         } else {
             return nullopt;
@@ -342,7 +423,7 @@ public:
     constexpr auto map(F&& func) const& -> optional<std::invoke_result_t<F, T const&>>
     {
         using R = optional<std::invoke_result_t<F, T const&>>;
-        if (engaged_) {
+        if (has_value()) {
             return R(std::invoke(FLUX_FWD(func), value_unchecked()));
         } else {
             return nullopt;
@@ -356,7 +437,7 @@ public:
     constexpr auto map(F&& func) && -> optional<std::invoke_result_t<F, T&&>>
     {
         using R = optional<std::invoke_result_t<F, T&>>;
-        if (engaged_) {
+        if (has_value()) {
             return R(std::invoke(FLUX_FWD(func), std::move(*this).value_unchecked()));
         } else {
             return nullopt;
@@ -370,7 +451,7 @@ public:
     constexpr auto map(F&& func) const&& -> optional<std::invoke_result_t<F, T const&&>>
     {
         using R = optional<std::invoke_result_t<F, T const&&>>;
-        if (engaged_) {
+        if (has_value()) {
             return R(std::invoke(FLUX_FWD(func), std::move(*this).value_unchecked()));
         } else {
             return nullopt;
@@ -0,0 +1,254 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_EXTERNAL_SORT_HPP_INCLUDED
+#define FLUX_EXTERNAL_SORT_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <flux/adaptor/merge.hpp>
+#include <flux/algorithm/for_each.hpp>
+#include <flux/algorithm/sort.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+namespace detail {
+
+/*
+ * A binary temporary file holding the sorted runs of an external sort. The
+ * file is removed when the spill_file is destroyed, which happens when the
+ * last run referring to it goes away.
+ *
+ * Runs are written and read in large blocks, so the stream's own buffer is
+ * disabled to avoid copying everything twice.
+ */
+class spill_file {
+    std::filesystem::path path_;
+    std::fstream stream_;
+
+    [[noreturn]]
+    auto fail(char const* what) const -> void
+    {
+        throw std::filesystem::filesystem_error(
+            what, path_, std::make_error_code(std::errc::io_error));
+    }
+
+public:
+    explicit spill_file(std::filesystem::path const& dir)
+    {
+        std::random_device rd;
+        std::mt19937_64 gen((std::uint64_t{rd()} << 32) | rd());
+
+        // Pick a name which isn't taken. 64 random bits makes a collision
+        // with a concurrent sort vanishingly unlikely.
+        do {
+            path_ = dir / ("flux-sort-" + std::to_string(gen()) + ".tmp");
+        } while (std::filesystem::exists(path_));
+
+        stream_.rdbuf()->pubsetbuf(nullptr, 0);
+        stream_.open(path_, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!stream_) {
+            fail("flux::external_sort: cannot create temporary file");
+        }
+    }
+
+    spill_file(spill_file const&) = delete;
+    spill_file& operator=(spill_file const&) = delete;
+
+    ~spill_file()
+    {
+        stream_.close();
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    // Appends bytes to the end of the file
+    auto write(void const* data, std::size_t bytes) -> void
+    {
+        stream_.write(static_cast<char const*>(data),
+                      num::checked_cast<std::streamsize>(bytes));
+        if (!stream_) {
+            fail("flux::external_sort: cannot write temporary file");
+        }
+    }
+
+    auto read(std::uint64_t offset, void* data, std::size_t bytes) -> void
+    {
+        stream_.seekg(num::checked_cast<std::streamoff>(offset));
+        stream_.read(static_cast<char*>(data), num::checked_cast<std::streamsize>(bytes));
+        if (!stream_) {
+            fail("flux::external_sort: cannot read temporary file");
+        }
+    }
+};
+
+/*
+ * One sorted run of an external sort. A run which was spilled to disk is
+ * read back a block at a time into `buffer_`; otherwise, `buffer_` holds the
+ * whole run. Each call to first() starts again from the beginning of the run.
+ */
+template <typename T>
+struct sorted_run : inline_sequence_base<sorted_run<T>> {
+private:
+    std::shared_ptr<spill_file> file_; // null if the run is held in memory
+    std::uint64_t offset_ = 0;         // in elements, from the start of the file
+    std::size_t size_ = 0;
+    std::size_t block_size_ = 0;
+    std::size_t loaded_ = 0;           // elements read from the file so far
+    std::vector<T> buffer_;
+    std::size_t pos_ = 0;
+
+    auto refill() -> void
+    {
+        std::size_t const n = (std::min)(block_size_, size_ - loaded_);
+        buffer_.resize(n);
+        if (n > 0) {
+            file_->read((offset_ + loaded_) * sizeof(T), buffer_.data(), n * sizeof(T));
+        }
+        loaded_ += n;
+        pos_ = 0;
+    }
+
+public:
+    sorted_run(std::shared_ptr<spill_file> file, std::uint64_t offset, std::size_t size)
+        : file_(std::move(file)),
+          offset_(offset),
+          size_(size)
+    {}
+
+    explicit sorted_run(std::vector<T>&& elements)
+        : size_(elements.size()),
+          buffer_(std::move(elements))
+    {}
+
+    // Sets how many elements are read from the file at a time
+    auto set_block_size(std::size_t n) -> void { block_size_ = (std::max)(n, std::size_t{1}); }
+
+    struct flux_sequence_traits : default_sequence_traits {
+    private:
+        struct cursor_type {
+            cursor_type(cursor_type&&) = default;
+            cursor_type& operator=(cursor_type&&) = default;
+
+        private:
+            friend struct flux_sequence_traits;
+            cursor_type() = default;
+        };
+
+    public:
+        using value_type = T;
+
+        static auto first(sorted_run& self) -> cursor_type
+        {
+            if (self.file_) {
+                self.loaded_ = 0;
+                self.refill();
+            } else {
+                self.pos_ = 0;
+            }
+            return cursor_type{};
+        }
+
+        static auto is_last(sorted_run& self, cursor_type const&) -> bool
+        {
+            return self.pos_ == self.buffer_.size();
+        }
+
+        static auto inc(sorted_run& self, cursor_type&) -> void
+        {
+            if (++self.pos_ == self.buffer_.size() && self.file_) {
+                self.refill();
+            }
+        }
+
+        static auto read_at(sorted_run& self, cursor_type const&) -> T&
+        {
+            return self.buffer_[self.pos_];
+        }
+    };
+};
+
+struct external_sort_fn {
+    template <adaptable_sequence Seq, typename Cmp>
+        requires std::is_trivially_copyable_v<value_t<Seq>> &&
+                 std::default_initializable<value_t<Seq>> &&
+                 std::constructible_from<value_t<Seq>, element_t<Seq>> &&
+                 ordering_invocable<Cmp&, value_t<Seq>&, value_t<Seq>&, std::weak_ordering>
+    [[nodiscard]]
+    auto operator()(Seq&& seq, Cmp cmp, std::size_t memory_budget,
+                    std::filesystem::path const& temp_dir
+                        = std::filesystem::temp_directory_path()) const
+        -> sequence auto
+    {
+        using T = value_t<Seq>;
+        using run_t = sorted_run<T>;
+
+        std::size_t const run_size = (std::max)(memory_budget / sizeof(T), std::size_t{1});
+
+        std::vector<T> buffer;
+        std::vector<run_t> runs;
+        std::shared_ptr<spill_file> file;
+        std::uint64_t spilled = 0;
+
+        auto spill = [&] {
+            flux::sort(buffer, std::ref(cmp));
+            if (!file) {
+                file = std::make_shared<spill_file>(temp_dir);
+            }
+            file->write(buffer.data(), buffer.size() * sizeof(T));
+            runs.emplace_back(file, spilled, buffer.size());
+            spilled += buffer.size();
+            buffer.clear();
+        };
+
+        flux::for_each(seq, [&](auto&& elem) {
+            // Only spill once we know there is more to come, so that an
+            // input which fits in the budget never touches the disk
+            if (buffer.size() == run_size) {
+                spill();
+            } else if (buffer.size() == buffer.capacity()) {
+                buffer.reserve((std::min)((std::max)(2 * buffer.capacity(), std::size_t{16}),
+                                          run_size));
+            }
+            buffer.emplace_back(FLUX_FWD(elem));
+        });
+
+        if (!file) {
+            flux::sort(buffer, std::ref(cmp));
+            runs.emplace_back(std::move(buffer));
+        } else {
+            if (!buffer.empty()) {
+                spill();
+            }
+            // Share the budget between the read buffers of the runs
+            buffer = std::vector<T>();
+            for (run_t& run : runs) {
+                run.set_block_size(run_size / runs.size());
+            }
+        }
+
+        return flux::merge_all(std::move(runs), std::move(cmp));
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto external_sort = detail::external_sort_fn{};
+
+} // namespace flux
+
+#endif // FLUX_EXTERNAL_SORT_HPP_INCLUDED
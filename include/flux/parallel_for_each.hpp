@@ -0,0 +1,115 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_PARALLEL_FOR_EACH_HPP_INCLUDED
+#define FLUX_PARALLEL_FOR_EACH_HPP_INCLUDED
+
+#include <flux/core.hpp>
+
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace flux {
+
+namespace detail {
+
+// Sequences whose traits can iterate a block of `count` elements starting
+// from a cursor faster than by repeated inc() -- currently the cartesian
+// adaptors, which walk the block row by row
+template <typename Seq, typename Pred>
+concept has_for_each_while_n =
+    requires (Seq& seq, cursor_t<Seq> cur, distance_t count, Pred& pred) {
+        { traits_t<Seq>::for_each_while_n(seq, cur, count, pred) } -> std::same_as<cursor_t<Seq>>;
+    };
+
+struct parallel_for_each_fn {
+private:
+    template <typename Seq, typename Func>
+    static auto run_block(Seq& seq, Func& func, distance_t from, distance_t count) -> void
+    {
+        auto pred = [&func](auto&& elem) {
+            std::invoke(func, FLUX_FWD(elem));
+            return true;
+        };
+
+        auto cur = flux::next(seq, flux::first(seq), from);
+        if constexpr (has_for_each_while_n<Seq, decltype(pred)>) {
+            (void) traits_t<Seq>::for_each_while_n(seq, std::move(cur), count, pred);
+        } else {
+            for (distance_t i = 0; i < count; ++i) {
+                pred(flux::read_at_unchecked(seq, cur));
+                flux::inc(seq, cur);
+            }
+        }
+    }
+
+public:
+    template <typename Seq, typename Func>
+        requires random_access_sequence<Seq const> &&
+                 sized_sequence<Seq const> &&
+                 std::invocable<Func const&, element_t<Seq const>>
+    auto operator()(Seq const& seq, Func const& func,
+                    std::size_t n_threads = std::thread::hardware_concurrency()) const
+        -> void
+    {
+        distance_t const size = flux::size(seq);
+        distance_t const n_blocks = (cmp::min)(
+            (cmp::max)(num::checked_cast<distance_t>(n_threads), distance_t{1}), size);
+
+        if (n_blocks <= 1) {
+            if (size > 0) {
+                run_block(seq, func, 0, size);
+            }
+            return;
+        }
+
+        // The first `rem` blocks get one extra element
+        distance_t const block_size = size / n_blocks;
+        distance_t const rem = size % n_blocks;
+        auto block_start = [&](distance_t b) { return b * block_size + (cmp::min)(b, rem); };
+
+        std::vector<std::exception_ptr> errors(static_cast<std::size_t>(n_blocks));
+        std::vector<std::thread> workers;
+        workers.reserve(static_cast<std::size_t>(n_blocks - 1));
+
+        auto work = [&](distance_t b) {
+            try {
+                run_block(seq, func, block_start(b), block_start(b + 1) - block_start(b));
+            } catch (...) {
+                errors[static_cast<std::size_t>(b)] = std::current_exception();
+            }
+        };
+
+        // The calling thread takes the last block, and any whose thread
+        // couldn't be started
+        for (distance_t b = 0; b < n_blocks - 1; ++b) {
+            try {
+                workers.emplace_back(work, b);
+            } catch (std::system_error const&) {
+                work(b);
+            }
+        }
+        work(n_blocks - 1);
+
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        for (auto& e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto parallel_for_each = detail::parallel_for_each_fn{};
+
+} // namespace flux
+
+#endif // FLUX_PARALLEL_FOR_EACH_HPP_INCLUDED
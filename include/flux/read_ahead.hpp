@@ -0,0 +1,243 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_READ_AHEAD_HPP_INCLUDED
+#define FLUX_READ_AHEAD_HPP_INCLUDED
+
+#include <flux/core.hpp>
+#include <flux/sequence/array_ptr.hpp>
+
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace flux {
+
+FLUX_EXPORT
+struct read_ahead_options {
+    distance_t block_size = 64 * 1024;
+    distance_t queue_depth = 3;
+};
+
+namespace detail {
+
+/*
+ * State shared between the consumer and the background reader thread.
+ *
+ * The buffer is split into `depth` blocks which are used as a ring. The reader
+ * fills blocks in order while fewer than `depth` of them are outstanding; the
+ * consumer holds on to the block at `read_idx` until it is incremented past it.
+ */
+struct read_ahead_state {
+    std::FILE* file = nullptr;
+    std::size_t block_size;
+    std::size_t depth;
+    std::unique_ptr<char[]> buffer;
+    std::unique_ptr<std::size_t[]> sizes;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::size_t filled = 0;     // guarded by mtx
+    bool done = false;          // guarded by mtx
+    bool error = false;         // guarded by mtx
+    bool stop = false;          // guarded by mtx
+
+    std::size_t read_idx = 0;   // consumer only
+    bool holding = false;       // consumer only
+
+    std::thread reader;
+
+    read_ahead_state(std::FILE* f, std::size_t block_sz, std::size_t depth_)
+        : file(f),
+          block_size(block_sz),
+          depth(depth_),
+          buffer(new char[block_sz * depth_]),
+          sizes(new std::size_t[depth_]{})
+    {
+        if (file == nullptr) {
+            done = true;
+            error = true;
+        } else {
+            reader = std::thread([this] { run(); });
+        }
+    }
+
+    read_ahead_state(read_ahead_state&&) = delete;
+
+    ~read_ahead_state()
+    {
+        if (reader.joinable()) {
+            {
+                std::lock_guard lock(mtx);
+                stop = true;
+            }
+            cv.notify_all();
+            reader.join();
+        }
+        if (file) {
+            std::fclose(file);
+        }
+    }
+
+    auto block_ptr(std::size_t idx) const -> char*
+    {
+        return buffer.get() + idx * block_size;
+    }
+
+    // Runs on the background thread
+    void run()
+    {
+        std::size_t write_idx = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mtx);
+                cv.wait(lock, [this] { return stop || filled < depth; });
+                if (stop) {
+                    return;
+                }
+            }
+
+            // The slot at write_idx is not visible to the consumer, so it is
+            // safe to fill it without holding the lock
+            std::size_t n = std::fread(block_ptr(write_idx), 1, block_size, file);
+            bool const eof = n < block_size;
+            bool const failed = eof && std::ferror(file);
+            sizes[write_idx] = n;
+
+            {
+                std::lock_guard lock(mtx);
+                if (n > 0) {
+                    ++filled;
+                }
+                if (eof) {
+                    done = true;
+                    error = failed;
+                }
+            }
+            cv.notify_all();
+
+            if (eof) {
+                return;
+            }
+            write_idx = (write_idx + 1) % depth;
+        }
+    }
+
+    // Consumer: waits until the next block is available. Returns false if
+    // the reader has finished and there are no more blocks
+    auto acquire() -> bool
+    {
+        std::unique_lock lock(mtx);
+        cv.wait(lock, [this] { return filled > 0 || done; });
+        holding = filled > 0;
+        return holding;
+    }
+
+    // Consumer: hands the current block back to the reader
+    void release()
+    {
+        {
+            std::lock_guard lock(mtx);
+            --filled;
+        }
+        cv.notify_all();
+        read_idx = (read_idx + 1) % depth;
+        holding = false;
+    }
+};
+
+class read_ahead_sequence : public inline_sequence_base<read_ahead_sequence> {
+    std::unique_ptr<read_ahead_state> state_;
+
+public:
+    read_ahead_sequence(std::FILE* file, read_ahead_options opts)
+    {
+        FLUX_ASSERT(opts.block_size > 0);
+        FLUX_ASSERT(opts.queue_depth > 0);
+        state_ = std::make_unique<read_ahead_state>(
+            file,
+            num::checked_cast<std::size_t>(opts.block_size),
+            num::checked_cast<std::size_t>(opts.queue_depth));
+    }
+
+    read_ahead_sequence(read_ahead_sequence&&) = default;
+    read_ahead_sequence& operator=(read_ahead_sequence&&) = default;
+
+    /// Returns true if the file could not be opened, or if a read error
+    /// occurred. Only meaningful once iteration has reached the end.
+    [[nodiscard]]
+    auto has_error() const -> bool
+    {
+        std::lock_guard lock(state_->mtx);
+        return state_->error;
+    }
+
+    struct flux_sequence_traits : default_sequence_traits {
+    private:
+        struct cursor_type {
+            explicit cursor_type() = default;
+            cursor_type(cursor_type&&) = default;
+            cursor_type& operator=(cursor_type&&) = default;
+        };
+
+        using self_t = read_ahead_sequence;
+
+    public:
+        static auto first(self_t& self) -> cursor_type
+        {
+            self.state_->acquire();
+            return cursor_type{};
+        }
+
+        static auto is_last(self_t& self, cursor_type const&) -> bool
+        {
+            return !self.state_->holding;
+        }
+
+        static auto inc(self_t& self, cursor_type& cur) -> cursor_type&
+        {
+            flux::assert_(self.state_->holding,
+                          "flux::read_ahead::inc(): attempt to iterate past end of file");
+            self.state_->release();
+            self.state_->acquire();
+            return cur;
+        }
+
+        static auto read_at(self_t& self, cursor_type const&) -> array_ptr<char const>
+        {
+            auto& st = *self.state_;
+            flux::assert_(st.holding,
+                          "flux::read_ahead::read_at(): attempt to read past end of file");
+            return make_array_ptr_unchecked(static_cast<char const*>(st.block_ptr(st.read_idx)),
+                                            st.sizes[st.read_idx]);
+        }
+    };
+};
+
+struct read_ahead_fn {
+    [[nodiscard]]
+    auto operator()(char const* path, read_ahead_options opts = {}) const
+        -> read_ahead_sequence
+    {
+        return read_ahead_sequence(std::fopen(path, "rb"), opts);
+    }
+
+    [[nodiscard]]
+    auto operator()(std::string const& path, read_ahead_options opts = {}) const
+        -> read_ahead_sequence
+    {
+        return (*this)(path.c_str(), opts);
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT inline constexpr auto read_ahead = detail::read_ahead_fn{};
+
+} // namespace flux
+
+#endif // FLUX_READ_AHEAD_HPP_INCLUDED
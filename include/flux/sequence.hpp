@@ -7,6 +7,7 @@
 #define FLUX_SEQUENCE_HPP_INCLUDED
 
 #include <flux/sequence/array_ptr.hpp>
+#include <flux/sequence/batch_generator.hpp>
 #include <flux/sequence/bitset.hpp>
 #include <flux/sequence/empty.hpp>
 #include <flux/sequence/generator.hpp>
@@ -17,6 +18,7 @@
 #include <flux/sequence/range.hpp>
 #include <flux/sequence/repeat.hpp>
 #include <flux/sequence/single.hpp>
+#include <flux/sequence/soa_vector.hpp>
 #include <flux/sequence/unfold.hpp>
 
 #endif // FLUX_SEQUENCE_HPP_INCLUDED
@@ -0,0 +1,231 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_SEQUENCE_BATCH_GENERATOR_HPP_INCLUDED
+#define FLUX_SEQUENCE_BATCH_GENERATOR_HPP_INCLUDED
+
+#include <flux/core.hpp>
+#include <flux/sequence/generator.hpp>
+
+#include <algorithm>
+#include <coroutine>
+#include <utility>
+
+namespace flux {
+
+namespace detail {
+
+// The buffer takes up half of the largest frame which the frame pool caches,
+// leaving the rest for the coroutine's own state and locals
+template <typename T>
+inline constexpr std::size_t default_batch_capacity =
+    std::max(std::size_t{1}, generator_frame_pool::max_size / 2 / sizeof(T));
+
+}
+
+/*
+ * A coroutine generator which yields its elements in batches.
+ *
+ * Single elements passed to co_yield are appended to a buffer inside the
+ * coroutine frame, and the coroutine is only suspended when the buffer is
+ * full. Contiguous sequences passed to co_yield are handed to the consumer
+ * directly without copying. The consumer then iterates over a whole batch
+ * before resuming the coroutine.
+ */
+FLUX_EXPORT
+template <typename T, std::size_t Capacity = detail::default_batch_capacity<T>>
+    requires std::is_object_v<T> && std::default_initializable<T> && std::movable<T> &&
+             (Capacity > 0)
+struct batch_generator : inline_sequence_base<batch_generator<T, Capacity>> {
+
+    struct promise_type;
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct promise_type : detail::generator_promise_alloc {
+    private:
+        struct yield_awaiter {
+            bool ready;
+
+            constexpr auto await_ready() const noexcept -> bool { return ready; }
+            constexpr auto await_suspend(std::coroutine_handle<>) const noexcept -> void {}
+            constexpr auto await_resume() const noexcept -> void {}
+        };
+
+    public:
+        auto initial_suspend() { return std::suspend_always{}; }
+
+        auto final_suspend() noexcept { return std::suspend_always{}; }
+
+        auto get_return_object()
+        {
+            return batch_generator(handle_type::from_promise(*this));
+        }
+
+        auto yield_value(T const& elem) -> yield_awaiter
+            requires std::copyable<T>
+        {
+            buffer_[count_++] = elem;
+            return yield_awaiter{count_ < Capacity};
+        }
+
+        auto yield_value(T&& elem) -> yield_awaiter
+        {
+            buffer_[count_++] = std::move(elem);
+            return yield_awaiter{count_ < Capacity};
+        }
+
+        // Any buffered elements are handed out before the elements of `seq`,
+        // so that ordering is preserved
+        template <typename Seq>
+            requires contiguous_sequence<Seq> && sized_sequence<Seq> &&
+                     std::same_as<value_t<Seq>, T>
+        auto yield_value(Seq&& seq) -> std::suspend_always
+        {
+            span_data_ = flux::data(seq);
+            span_size_ = flux::usize(seq);
+            return {};
+        }
+
+        auto unhandled_exception() { throw; }
+
+        void return_void() noexcept {}
+
+        T buffer_[Capacity]{};
+        std::size_t count_ = 0;
+        T const* span_data_ = nullptr;
+        std::size_t span_size_ = 0;
+    };
+
+private:
+    handle_type coro_;
+
+    explicit batch_generator(handle_type&& handle) : coro_(std::move(handle)) {}
+
+    auto promise() -> promise_type& { return coro_.promise(); }
+
+    auto batch_size() -> std::size_t
+    {
+        return promise().count_ + promise().span_size_;
+    }
+
+    // Resumes the coroutine until it produces a non-empty batch or finishes
+    auto next_batch() -> void
+    {
+        auto& p = promise();
+        while (true) {
+            p.count_ = 0;
+            p.span_data_ = nullptr;
+            p.span_size_ = 0;
+            if (coro_.done()) {
+                return;
+            }
+            coro_.resume();
+            if (p.count_ + p.span_size_ > 0) {
+                return;
+            }
+        }
+    }
+
+    friend struct sequence_traits<batch_generator>;
+
+public:
+    batch_generator(batch_generator&& other) noexcept
+        : coro_(std::exchange(other.coro_, {}))
+    {}
+
+    batch_generator& operator=(batch_generator&& other) noexcept
+    {
+        std::swap(coro_, other.coro_);
+        return *this;
+    }
+
+    ~batch_generator()
+    {
+        if (coro_) { coro_.destroy(); }
+    }
+};
+
+template <typename T, std::size_t Capacity>
+struct sequence_traits<batch_generator<T, Capacity>> : default_sequence_traits
+{
+private:
+    struct cursor_type {
+        cursor_type(cursor_type&&) = default;
+        cursor_type& operator=(cursor_type&&) = default;
+    private:
+        explicit cursor_type(std::size_t p) : pos(p) {}
+        std::size_t pos;
+        friend struct sequence_traits;
+    };
+
+    using self_t = batch_generator<T, Capacity>;
+
+public:
+    static auto first(self_t& self) -> cursor_type
+    {
+        self.next_batch();
+        return cursor_type{0};
+    }
+
+    static auto is_last(self_t& self, cursor_type const& cur) -> bool
+    {
+        return cur.pos >= self.batch_size();
+    }
+
+    static auto inc(self_t& self, cursor_type& cur) -> cursor_type&
+    {
+        if (++cur.pos == self.batch_size()) {
+            self.next_batch();
+            cur.pos = 0;
+        }
+        return cur;
+    }
+
+    static auto read_at(self_t& self, cursor_type const& cur) -> T const&
+    {
+        auto& p = self.promise();
+        if (cur.pos < p.count_) {
+            return p.buffer_[cur.pos];
+        } else {
+            bounds_check(cur.pos - p.count_ < p.span_size_);
+            return p.span_data_[cur.pos - p.count_];
+        }
+    }
+
+    static auto read_at_unchecked(self_t& self, cursor_type const& cur) -> T const&
+    {
+        auto& p = self.promise();
+        if (cur.pos < p.count_) {
+            return p.buffer_[cur.pos];
+        } else {
+            return p.span_data_[cur.pos - p.count_];
+        }
+    }
+
+    static auto for_each_while(self_t& self, auto&& pred) -> cursor_type
+    {
+        self.next_batch();
+        auto& p = self.promise();
+
+        while (p.count_ + p.span_size_ > 0) {
+            for (std::size_t i = 0; i < p.count_; i++) {
+                if (!std::invoke(pred, std::as_const(p.buffer_[i]))) {
+                    return cursor_type{i};
+                }
+            }
+            for (std::size_t i = 0; i < p.span_size_; i++) {
+                if (!std::invoke(pred, p.span_data_[i])) {
+                    return cursor_type{p.count_ + i};
+                }
+            }
+            self.next_batch();
+        }
+        return cursor_type{0};
+    }
+};
+
+} // namespace flux
+
+#endif // FLUX_SEQUENCE_BATCH_GENERATOR_HPP_INCLUDED
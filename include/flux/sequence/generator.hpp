@@ -9,10 +9,257 @@
 #include <flux/core.hpp>
 
 #include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
 #include <utility>
 
 namespace flux {
 
+namespace detail {
+
+/*
+ * A thread-local cache of coroutine frames, bucketed by (rounded-up) size.
+ *
+ * Generators created in a loop typically have identically-sized frames, so
+ * after the first iteration every allocation can be satisfied from the
+ * free list without going to the global allocator.
+ */
+struct generator_frame_pool {
+private:
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t num_buckets = 16;
+    static constexpr std::size_t max_cached_per_bucket = 32;
+
+    struct node {
+        node* next;
+    };
+
+    struct bucket {
+        node* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    bucket buckets_[num_buckets]{};
+
+    static inline thread_local bool destroyed_ = false;
+
+    static auto local() -> generator_frame_pool&
+    {
+        static thread_local generator_frame_pool pool;
+        return pool;
+    }
+
+    static constexpr auto bucket_index(std::size_t size) -> std::size_t
+    {
+        return (size - 1) / granularity;
+    }
+
+    static constexpr auto bucket_size(std::size_t idx) -> std::size_t
+    {
+        return (idx + 1) * granularity;
+    }
+
+    generator_frame_pool() = default;
+
+public:
+    // The largest frame which is cached, including the trailer
+    static constexpr std::size_t max_size = granularity * num_buckets;
+
+    generator_frame_pool(generator_frame_pool&&) = delete;
+
+    ~generator_frame_pool()
+    {
+        for (std::size_t i = 0; i < num_buckets; i++) {
+            node* n = buckets_[i].head;
+            while (n != nullptr) {
+                ::operator delete(std::exchange(n, n->next), bucket_size(i));
+            }
+        }
+        destroyed_ = true;
+    }
+
+    static auto allocate(std::size_t size) -> void*
+    {
+        std::size_t const idx = bucket_index(size);
+        if (idx >= num_buckets) {
+            return ::operator new(size);
+        }
+
+        // Frames in bucket range are always bucket-sized, even once this
+        // thread's pool has been destroyed, because they may be freed on a
+        // thread whose pool is still alive
+        if (!destroyed_) {
+            bucket& b = local().buckets_[idx];
+            if (b.head != nullptr) {
+                --b.count;
+                return std::exchange(b.head, b.head->next);
+            }
+        }
+        return ::operator new(bucket_size(idx));
+    }
+
+    static auto deallocate(void* ptr, std::size_t size) noexcept -> void
+    {
+        std::size_t const idx = bucket_index(size);
+        if (idx >= num_buckets) {
+            ::operator delete(ptr, size);
+            return;
+        }
+
+        if (!destroyed_) {
+            bucket& b = local().buckets_[idx];
+            if (b.count < max_cached_per_bucket) {
+                b.head = ::new (ptr) node{b.head};
+                ++b.count;
+                return;
+            }
+        }
+        ::operator delete(ptr, bucket_size(idx));
+    }
+};
+
+/*
+ * Allocation of generator coroutine frames.
+ *
+ * Every frame is followed by a pointer to the function which must be used to
+ * free it, and (when the coroutine was called with std::allocator_arg) by a
+ * copy of the user's allocator. This allows a single non-template
+ * operator delete in the promise type to handle every case.
+ */
+struct generator_frame {
+private:
+    using dealloc_fn = void (*)(void*, std::size_t) noexcept;
+
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) aligned_block {
+        std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+    };
+
+    static constexpr auto align_up(std::size_t n, std::size_t align) -> std::size_t
+    {
+        return (n + align - 1) & ~(align - 1);
+    }
+
+    static constexpr auto trailer_offset(std::size_t frame_size) -> std::size_t
+    {
+        return align_up(frame_size, alignof(dealloc_fn));
+    }
+
+    template <typename Alloc>
+    static constexpr auto alloc_offset(std::size_t frame_size) -> std::size_t
+    {
+        return align_up(trailer_offset(frame_size) + sizeof(dealloc_fn), alignof(Alloc));
+    }
+
+    template <typename Alloc>
+    static constexpr auto num_blocks(std::size_t frame_size) -> std::size_t
+    {
+        return align_up(alloc_offset<Alloc>(frame_size) + sizeof(Alloc), sizeof(aligned_block))
+                   / sizeof(aligned_block);
+    }
+
+    static auto trailer(void* frame, std::size_t frame_size) -> dealloc_fn*
+    {
+        return reinterpret_cast<dealloc_fn*>(static_cast<std::byte*>(frame) + trailer_offset(frame_size));
+    }
+
+    static auto pool_size(std::size_t frame_size) -> std::size_t
+    {
+        return trailer_offset(frame_size) + sizeof(dealloc_fn);
+    }
+
+    static auto deallocate_default(void* frame, std::size_t frame_size) noexcept -> void
+    {
+        if constexpr (config::enable_generator_frame_pool) {
+            generator_frame_pool::deallocate(frame, pool_size(frame_size));
+        } else {
+            ::operator delete(frame, pool_size(frame_size));
+        }
+    }
+
+    template <typename Alloc>
+    static auto deallocate_with(void* frame, std::size_t frame_size) noexcept -> void
+    {
+        auto* stored = std::launder(reinterpret_cast<Alloc*>(
+            static_cast<std::byte*>(frame) + alloc_offset<Alloc>(frame_size)));
+        Alloc alloc(std::move(*stored));
+        stored->~Alloc();
+        std::allocator_traits<Alloc>::deallocate(alloc, static_cast<aligned_block*>(frame),
+                                                 num_blocks<Alloc>(frame_size));
+    }
+
+public:
+    static auto allocate(std::size_t frame_size) -> void*
+    {
+        void* frame = nullptr;
+        if constexpr (config::enable_generator_frame_pool) {
+            frame = generator_frame_pool::allocate(pool_size(frame_size));
+        } else {
+            frame = ::operator new(pool_size(frame_size));
+        }
+        ::new (trailer(frame, frame_size)) dealloc_fn(&deallocate_default);
+        return frame;
+    }
+
+    template <typename Allocator>
+    static auto allocate(std::size_t frame_size, Allocator const& allocator) -> void*
+    {
+        using Alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<aligned_block>;
+        Alloc alloc(allocator);
+        void* frame = std::allocator_traits<Alloc>::allocate(alloc, num_blocks<Alloc>(frame_size));
+        ::new (trailer(frame, frame_size)) dealloc_fn(&deallocate_with<Alloc>);
+        ::new (static_cast<std::byte*>(frame) + alloc_offset<Alloc>(frame_size)) Alloc(std::move(alloc));
+        return frame;
+    }
+
+    static auto deallocate(void* frame, std::size_t frame_size) noexcept -> void
+    {
+        (*std::launder(trailer(frame, frame_size)))(frame, frame_size);
+    }
+};
+
+/*
+ * Base class for promise types which allocate their frames via
+ * generator_frame, supporting the std::allocator_arg convention
+ */
+struct generator_promise_alloc {
+    static auto operator new(std::size_t size) -> void*
+    {
+        return generator_frame::allocate(size);
+    }
+
+    template <typename Alloc, typename... Args>
+    static auto operator new(std::size_t size, std::allocator_arg_t,
+                             Alloc const& alloc, Args const&...) -> void*
+    {
+        return generator_frame::allocate(size, alloc);
+    }
+
+    template <typename This, typename Alloc, typename... Args>
+    static auto operator new(std::size_t size, This const&, std::allocator_arg_t,
+                             Alloc const& alloc, Args const&...) -> void*
+    {
+        return generator_frame::allocate(size, alloc);
+    }
+
+    static auto operator delete(void* ptr, std::size_t size) noexcept -> void
+    {
+        generator_frame::deallocate(ptr, size);
+    }
+};
+
+} // namespace detail
+
+FLUX_EXPORT
+template <typename Seq>
+struct elements_of {
+    FLUX_NO_UNIQUE_ADDRESS Seq seq;
+};
+
+template <typename Seq>
+elements_of(Seq&&) -> elements_of<Seq&&>;
+
 FLUX_EXPORT
 template <typename ElemT>
 struct generator : inline_sequence_base<generator<ElemT>> {
@@ -25,27 +272,112 @@ struct generator : inline_sequence_base<generator<ElemT>> {
 
     using handle_type = std::coroutine_handle<promise_type>;
 
-    struct promise_type {
+private:
+    // Awaiter for co_yield elements_of(gen). Control is transferred directly
+    // to the nested generator, which becomes the new "leaf" of the root
+    // generator. Resuming the root generator always resumes the current leaf,
+    // so the cost per element is independent of the depth of nesting.
+    template <typename Gen>
+    struct nested_awaiter {
+        Gen gen;
+
+        auto await_ready() const noexcept -> bool { return !gen.coro_; }
+
+        auto await_suspend(handle_type parent) noexcept -> std::coroutine_handle<>
+        {
+            promise_type& root = *parent.promise().root_;
+            promise_type& child = gen.coro_.promise();
+            child.root_ = &root;
+            child.parent_ = parent;
+            root.leaf_ = gen.coro_;
+            return gen.coro_;
+        }
+
+        auto await_resume() -> void
+        {
+            if (gen.coro_ && gen.coro_.promise().except_) {
+                std::rethrow_exception(std::move(gen.coro_.promise().except_));
+            }
+        }
+    };
+
+    struct final_awaiter {
+        auto await_ready() const noexcept -> bool { return false; }
+
+        auto await_suspend(handle_type self) noexcept -> std::coroutine_handle<>
+        {
+            promise_type& p = self.promise();
+            if (p.parent_) {
+                p.root_->leaf_ = p.parent_;
+                return p.parent_;
+            } else {
+                return std::noop_coroutine();
+            }
+        }
+
+        auto await_resume() const noexcept -> void {}
+    };
+
+    template <typename Seq>
+    static auto yield_all(Seq&& seq) -> generator
+    {
+        FLUX_FOR(auto&& elem, seq) {
+            co_yield static_cast<yielded_type>(FLUX_FWD(elem));
+        }
+    }
+
+public:
+    struct promise_type : detail::generator_promise_alloc {
         auto initial_suspend() { return std::suspend_always{}; }
 
-        auto final_suspend() noexcept { return std::suspend_always{}; }
+        auto final_suspend() noexcept { return final_awaiter{}; }
 
         auto get_return_object()
         {
+            leaf_ = handle_type::from_promise(*this);
             return generator(handle_type::from_promise(*this));
         }
 
         auto yield_value(yielded_type elem)
         {
-            ptr_ = std::addressof(elem);
+            root_->ptr_ = std::addressof(elem);
             return std::suspend_always{};
         }
 
-        auto unhandled_exception() { throw; }
+        template <typename Gen>
+            requires std::same_as<std::remove_cvref_t<Gen>, generator>
+        auto yield_value(elements_of<Gen> elems) noexcept
+        {
+            return nested_awaiter<generator&>{elems.seq};
+        }
+
+        template <typename Seq>
+            requires (!std::same_as<std::remove_cvref_t<Seq>, generator>) &&
+                     sequence<Seq> &&
+                     std::convertible_to<element_t<Seq>, yielded_type>
+        auto yield_value(elements_of<Seq> elems)
+        {
+            return nested_awaiter<generator>{yield_all<Seq>(FLUX_FWD(elems.seq))};
+        }
+
+        auto unhandled_exception()
+        {
+            if (parent_) {
+                except_ = std::current_exception();
+            } else {
+                throw;
+            }
+        }
 
         void return_void() noexcept {}
 
+        // Only meaningful in the root generator
         std::add_pointer_t<yielded_type> ptr_;
+        handle_type leaf_;
+
+        promise_type* root_ = this;
+        handle_type parent_;
+        std::exception_ptr except_;
     };
 
 private:
@@ -85,10 +417,11 @@ private:
     };
 
     using self_t = generator<T>;
+    using yielded_type = typename self_t::yielded_type;
 
 public:
     static auto first(self_t& self) {
-        self.coro_.resume();
+        self.coro_.promise().leaf_.resume();
         return cursor_type{};
     }
 
@@ -99,13 +432,24 @@ public:
 
     static auto inc(self_t& self, cursor_type& cur) -> cursor_type&
     {
-        self.coro_.resume();
+        self.coro_.promise().leaf_.resume();
         return cur;
     }
 
     static auto read_at(self_t& self, cursor_type const&) -> decltype(auto)
     {
-        return static_cast<typename self_t::yielded_type>(*self.coro_.promise().ptr_);
+        return static_cast<yielded_type>(*self.coro_.promise().ptr_);
+    }
+
+    static auto for_each_while(self_t& self, auto&& pred) -> cursor_type
+    {
+        auto& root = self.coro_.promise();
+        for (root.leaf_.resume(); !self.coro_.done(); root.leaf_.resume()) {
+            if (!std::invoke(pred, static_cast<yielded_type>(*root.ptr_))) {
+                break;
+            }
+        }
+        return cursor_type{};
     }
 };
 
@@ -44,6 +44,10 @@ public:
     constexpr auto value() const -> T const& { return obj_; }
 };
 
+// Cursors for single_sequence only ever take two values, leaving the rest of
+// the byte free to mark a disengaged optional
+enum class single_cursor : unsigned char { valid, done };
+
 struct single_fn {
     template <typename T>
     constexpr auto operator()(T&& t) const -> single_sequence<std::decay_t<T>>
@@ -54,13 +58,26 @@ struct single_fn {
 
 } // namespace detail
 
+template <>
+struct optional_niche<detail::single_cursor> {
+    static constexpr auto null_value() noexcept -> detail::single_cursor
+    {
+        return static_cast<detail::single_cursor>(2);
+    }
+
+    static constexpr auto is_null(detail::single_cursor cur) noexcept -> bool
+    {
+        return static_cast<unsigned char>(cur) > 1;
+    }
+};
+
 template <typename T>
 struct sequence_traits<detail::single_sequence<T>> : default_sequence_traits
 {
 private:
     using self_t = detail::single_sequence<T>;
 
-    enum class cursor_type : bool { valid, done };
+    using cursor_type = detail::single_cursor;
 
 public:
 
@@ -0,0 +1,310 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef FLUX_SEQUENCE_SOA_VECTOR_HPP_INCLUDED
+#define FLUX_SEQUENCE_SOA_VECTOR_HPP_INCLUDED
+
+#include <flux/core.hpp>
+#include <flux/adaptor/zip.hpp>
+#include <flux/algorithm/sort.hpp>
+#include <flux/sequence/array_ptr.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+/*
+ * A "struct of arrays" container, storing each field in its own contiguous
+ * column.
+ *
+ * The soa_vector itself is a random-access, sized sequence whose elements
+ * are pairs or tuples of references to the fields of each row, exactly as
+ * for zip(). Individual columns are available as contiguous sequences.
+ */
+FLUX_EXPORT
+template <typename... Fields>
+    requires (sizeof...(Fields) > 0) &&
+             ((std::is_object_v<Fields> && !std::is_const_v<Fields> &&
+               !std::same_as<Fields, bool>) && ...)
+struct soa_vector : inline_sequence_base<soa_vector<Fields...>> {
+private:
+    detail::pair_or_tuple_t<std::vector<Fields>...> columns_;
+
+    friend struct sequence_traits<soa_vector>;
+
+    template <typename Func>
+    constexpr auto for_each_column(Func func) -> void
+    {
+        std::apply([&func](auto&... cols) { (func(cols), ...); }, columns_);
+    }
+
+    template <std::size_t... I, typename... Args>
+    constexpr auto emplace_back_impl(std::index_sequence<I...>, Args&&... args) -> void
+    {
+        (std::get<I>(columns_).emplace_back(FLUX_FWD(args)), ...);
+    }
+
+public:
+    using value_type = detail::pair_or_tuple_t<Fields...>;
+
+    template <std::size_t I>
+    using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    soa_vector() = default;
+
+    constexpr explicit soa_vector(num::integral auto count)
+        : columns_(std::vector<Fields>(num::checked_cast<std::size_t>(count))...)
+    {}
+
+    constexpr soa_vector(std::initializer_list<value_type> ilist)
+    {
+        reserve(ilist.size());
+        for (value_type const& row : ilist) {
+            push_back(row);
+        }
+    }
+
+    /*
+     * Columns
+     */
+    template <std::size_t I>
+        requires (I < sizeof...(Fields))
+    [[nodiscard]]
+    constexpr auto column() -> array_ptr<field_t<I>>
+    {
+        return array_ptr<field_t<I>>(std::get<I>(columns_));
+    }
+
+    template <std::size_t I>
+        requires (I < sizeof...(Fields))
+    [[nodiscard]]
+    constexpr auto column() const -> array_ptr<field_t<I> const>
+    {
+        return array_ptr<field_t<I> const>(std::get<I>(columns_));
+    }
+
+    // Returns the row at `idx`, as a pair or tuple of references
+    [[nodiscard]]
+    constexpr auto row(num::integral auto idx)
+    {
+        auto i = num::checked_cast<distance_t>(idx);
+        indexed_bounds_check(i, this->size());
+        return std::apply([i](auto&... cols) {
+            return detail::pair_or_tuple_t<Fields&...>(cols[static_cast<std::size_t>(i)]...);
+        }, columns_);
+    }
+
+    [[nodiscard]]
+    constexpr auto row(num::integral auto idx) const
+    {
+        auto i = num::checked_cast<distance_t>(idx);
+        indexed_bounds_check(i, this->size());
+        return std::apply([i](auto const&... cols) {
+            return detail::pair_or_tuple_t<Fields const&...>(cols[static_cast<std::size_t>(i)]...);
+        }, columns_);
+    }
+
+    /*
+     * Capacity
+     */
+    [[nodiscard]]
+    constexpr auto capacity() const -> std::size_t { return std::get<0>(columns_).capacity(); }
+
+    [[nodiscard]]
+    constexpr auto max_size() const -> std::size_t
+    {
+        return std::apply([](auto const&... cols) {
+            return std::min({cols.max_size()...});
+        }, columns_);
+    }
+
+    constexpr auto reserve(std::size_t new_cap) -> void
+    {
+        for_each_column([new_cap](auto& col) { col.reserve(new_cap); });
+    }
+
+    /*
+     * Modifiers
+     */
+    constexpr auto clear() noexcept -> void
+    {
+        for_each_column([](auto& col) { col.clear(); });
+    }
+
+    constexpr auto resize(std::size_t count) -> void
+    {
+        for_each_column([count](auto& col) { col.resize(count); });
+    }
+
+    template <typename... Args>
+        requires (sizeof...(Args) == sizeof...(Fields)) &&
+                 (std::constructible_from<Fields, Args> && ...)
+    constexpr auto emplace_back(Args&&... args) -> void
+    {
+        emplace_back_impl(std::index_sequence_for<Fields...>{}, FLUX_FWD(args)...);
+    }
+
+    constexpr auto push_back(value_type const& row) -> void
+    {
+        std::apply([this](auto const&... fields) { emplace_back(fields...); }, row);
+    }
+
+    constexpr auto push_back(value_type&& row) -> void
+    {
+        std::apply([this](auto&... fields) { emplace_back(std::move(fields)...); }, row);
+    }
+
+    constexpr auto pop_back() -> void
+    {
+        FLUX_ASSERT(!std::get<0>(columns_).empty());
+        for_each_column([](auto& col) { col.pop_back(); });
+    }
+
+    /*
+     * Sorts the rows of the soa_vector according to the values in column I.
+     *
+     * Unlike flux::sort(), which swaps whole rows at each step, this sorts a
+     * permutation using only the key column, and then applies it to each
+     * column in turn.
+     */
+    template <std::size_t I, typename Cmp = std::compare_three_way>
+        requires (I < sizeof...(Fields)) &&
+                 ordering_invocable<Cmp&, field_t<I> const&, field_t<I> const&,
+                                    std::weak_ordering>
+    constexpr auto sort_by_column(Cmp cmp = {}) -> void
+    {
+        auto const& key = std::get<I>(columns_);
+        std::vector<distance_t> perm(key.size());
+        std::iota(perm.begin(), perm.end(), distance_t{0});
+
+        flux::sort(perm, [&key, &cmp](distance_t lhs, distance_t rhs) {
+            return std::invoke(cmp, key[static_cast<std::size_t>(lhs)],
+                               key[static_cast<std::size_t>(rhs)]);
+        });
+
+        for_each_column([&perm](auto& col) {
+            std::remove_reference_t<decltype(col)> sorted;
+            sorted.reserve(col.size());
+            for (distance_t idx : perm) {
+                sorted.push_back(std::move(col[static_cast<std::size_t>(idx)]));
+            }
+            col = std::move(sorted);
+        });
+    }
+
+    friend constexpr auto operator==(soa_vector const& lhs, soa_vector const& rhs) -> bool
+        requires (std::equality_comparable<Fields> && ...)
+    {
+        return lhs.columns_ == rhs.columns_;
+    }
+};
+
+template <typename... Fields>
+struct sequence_traits<soa_vector<Fields...>> : default_sequence_traits {
+private:
+    using self_t = soa_vector<Fields...>;
+
+    // A zip of references to the columns. This is cheap to construct, so
+    // each operation makes a new one and forwards to it.
+    template <typename Self>
+    static constexpr auto zipped(Self& self)
+    {
+        return std::apply([]<typename... Cols>(Cols&... cols) {
+            return detail::zip_adaptor<detail::ref_adaptor<Cols>...>(
+                detail::ref_adaptor<Cols>(cols)...);
+        }, self.columns_);
+    }
+
+public:
+    using value_type = value_t<decltype(zipped(std::declval<self_t&>()))>;
+
+    static constexpr auto first(auto& self)
+    {
+        auto z = zipped(self);
+        return flux::first(z);
+    }
+
+    static constexpr auto is_last(auto& self, auto const& cur) -> bool
+    {
+        auto z = zipped(self);
+        return flux::is_last(z, cur);
+    }
+
+    static constexpr auto read_at(auto& self, auto const& cur)
+    {
+        auto z = zipped(self);
+        return flux::read_at(z, cur);
+    }
+
+    static constexpr auto read_at_unchecked(auto& self, auto const& cur)
+    {
+        auto z = zipped(self);
+        return flux::read_at_unchecked(z, cur);
+    }
+
+    static constexpr auto move_at(auto& self, auto const& cur)
+    {
+        auto z = zipped(self);
+        return flux::move_at(z, cur);
+    }
+
+    static constexpr auto move_at_unchecked(auto& self, auto const& cur)
+    {
+        auto z = zipped(self);
+        return flux::move_at_unchecked(z, cur);
+    }
+
+    static constexpr auto inc(auto& self, auto& cur) -> auto&
+    {
+        auto z = zipped(self);
+        return flux::inc(z, cur);
+    }
+
+    static constexpr auto dec(auto& self, auto& cur) -> auto&
+    {
+        auto z = zipped(self);
+        return flux::dec(z, cur);
+    }
+
+    static constexpr auto inc(auto& self, auto& cur, distance_t offset) -> auto&
+    {
+        auto z = zipped(self);
+        return flux::inc(z, cur, offset);
+    }
+
+    static constexpr auto distance(auto& self, auto const& from, auto const& to) -> distance_t
+    {
+        auto z = zipped(self);
+        return flux::distance(z, from, to);
+    }
+
+    static constexpr auto last(auto& self)
+    {
+        auto z = zipped(self);
+        return flux::last(z);
+    }
+
+    static constexpr auto size(auto& self) -> distance_t
+    {
+        auto z = zipped(self);
+        return flux::size(z);
+    }
+
+    static constexpr auto for_each_while(auto& self, auto&& pred)
+    {
+        auto z = zipped(self);
+        return flux::for_each_while(z, FLUX_FWD(pred));
+    }
+};
+
+} // namespace flux
+
+#endif // FLUX_SEQUENCE_SOA_VECTOR_HPP_INCLUDED
@@ -1,10 +1,12 @@
-
 module;
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <bitset>
+#include <chrono>
 #include <climits>
+#include <cmath>
 #include <compare>
 #include <concepts>
 #include <coroutine>
@@ -18,9 +20,13 @@ module;
 #include <iosfwd>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <new>
+#include <numeric>
 #include <optional>
 #include <ranges>
 #include <source_location>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -28,6 +34,7 @@ module;
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 #include <version>
 
 export module flux;
@@ -57,3 +64,13 @@ export module flux;
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+
+// Explicit instantiation declarations of the algorithms which are most often
+// called with these argument types. Their definitions are compiled once, in
+// flux_instantiations.cpp, and importers which see these declarations need
+// not emit their own copies. The functions are constexpr, and so inline:
+// compilers are still free to instantiate them for inlining, and GCC does so
+// when optimising.
+#define FLUX_INSTANTIATION extern
+#include "flux_instantiations.hpp"
+#undef FLUX_INSTANTIATION
@@ -0,0 +1,19 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+module;
+
+#include <compare>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+module flux;
+
+// Definitions of the specialisations declared `extern` in the interface
+#define FLUX_INSTANTIATION
+#include "flux_instantiations.hpp"
+#undef FLUX_INSTANTIATION
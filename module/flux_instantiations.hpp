@@ -0,0 +1,44 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The algorithm specialisations which the flux module compiles once, for its
+// importers. This file is included twice: by the module interface with
+// FLUX_INSTANTIATION defined as `extern`, declaring them, and by the
+// implementation unit with it defined as nothing, defining them.
+
+#ifndef FLUX_INSTANTIATION
+#error "FLUX_INSTANTIATION must be defined before including this file"
+#endif
+
+#define FLUX_INSTANTIATE_SORT(Seq, Cmp) \
+    FLUX_INSTANTIATION template auto flux::detail::sort_fn::operator()<Seq, Cmp>( \
+        std::add_rvalue_reference_t<Seq>, Cmp) const;
+
+#define FLUX_INSTANTIATE_FIND(Seq, Value) \
+    FLUX_INSTANTIATION template auto flux::detail::find_fn::operator()<Seq, Value>( \
+        std::add_rvalue_reference_t<Seq>, Value const&) const -> flux::cursor_t<Seq>;
+
+#define FLUX_INSTANTIATE_SUM(Seq) \
+    FLUX_INSTANTIATION template auto flux::detail::sum_op::operator()<Seq>( \
+        std::add_rvalue_reference_t<Seq>) const -> flux::value_t<Seq>;
+
+FLUX_INSTANTIATE_SORT(std::vector<int>&, std::compare_three_way)
+FLUX_INSTANTIATE_SORT(std::vector<std::string>&, std::compare_three_way)
+// Doubles are only partially ordered, so need a comparator to be sorted
+FLUX_INSTANTIATE_SORT(std::vector<double>&,
+                      std::remove_const_t<decltype(flux::cmp::compare_floating_point_unchecked)>)
+
+FLUX_INSTANTIATE_FIND(std::string&, char)
+FLUX_INSTANTIATE_FIND(std::string const&, char)
+FLUX_INSTANTIATE_FIND(std::string_view, char)
+FLUX_INSTANTIATE_FIND(std::string_view&, char)
+FLUX_INSTANTIATE_FIND(std::span<char const>, char)
+
+FLUX_INSTANTIATE_SUM(std::vector<int>&)
+FLUX_INSTANTIATE_SUM(std::vector<int> const&)
+FLUX_INSTANTIATE_SUM(std::span<int const>)
+
+#undef FLUX_INSTANTIATE_SORT
+#undef FLUX_INSTANTIATE_FIND
+#undef FLUX_INSTANTIATE_SUM
@@ -0,0 +1,103 @@
+# Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Checks the x86-64 assembly generated for one kernel of codegen_kernels.cpp.
+#
+# Usage: cmake -DASM_FILE=<file.s> -DKERNEL=<name> -P check_codegen.cmake
+#
+# The flux version of the kernel passes if it is vectorised whenever the
+# hand-written reference is, and calls no functions apart from those which
+# the reference also calls (such as memset).
+
+cmake_minimum_required(VERSION 3.23)
+
+if (NOT ASM_FILE OR NOT KERNEL)
+    message(FATAL_ERROR "ASM_FILE and KERNEL must be set")
+endif()
+
+file(STRINGS "${ASM_FILE}" asm_lines)
+
+# Collects the instructions of a function, together with its cold part if
+# the compiler split one off
+function(function_body name out_var)
+    set(body "")
+    set(in_body FALSE)
+    foreach(line IN LISTS asm_lines)
+        if (line STREQUAL "${name}:" OR line STREQUAL "${name}.cold:")
+            set(in_body TRUE)
+        elseif (in_body)
+            if (line MATCHES "^[ \t]*\\.cfi_endproc" OR line MATCHES "^[ \t]*\\.size[ \t]")
+                set(in_body FALSE)
+            else()
+                list(APPEND body "${line}")
+            endif()
+        endif()
+    endforeach()
+    if (NOT body)
+        message(FATAL_ERROR "${name} not found in ${ASM_FILE}")
+    endif()
+    set(${out_var} "${body}" PARENT_SCOPE)
+endfunction()
+
+# Counts the packed SIMD instructions in a function, ignoring the xor idiom
+# which compilers use to zero registers in scalar code too
+function(count_vector_instructions name out_var)
+    function_body(${name} body)
+    set(count 0)
+    foreach(line IN LISTS body)
+        if (line MATCHES "^[ \t]+(v?p[a-z0-9]+|v?[a-z0-9]+p[sd])[ \t].*%[xyz]mm" AND
+            NOT CMAKE_MATCH_1 MATCHES "^v?(pxor|xorps|xorpd)$")
+            math(EXPR count "${count} + 1")
+        endif()
+    endforeach()
+    set(${out_var} ${count} PARENT_SCOPE)
+endfunction()
+
+# Lists the functions called from a function, including tail calls
+function(called_functions name out_var)
+    function_body(${name} body)
+    set(calls "")
+    foreach(line IN LISTS body)
+        # Each MATCHES resets CMAKE_MATCH_<n>, so the two patterns can't be
+        # tested in the same condition
+        set(callee "")
+        if (line MATCHES "^[ \t]+call[a-z]*[ \t]+\\*?([^ \t]+)")
+            set(callee "${CMAKE_MATCH_1}")
+        elseif (line MATCHES "^[ \t]+jmp[a-z]*[ \t]+([A-Za-z_][^ \t]*)")
+            set(callee "${CMAKE_MATCH_1}")
+        endif()
+        string(REGEX REPLACE "@PLT$" "" callee "${callee}")
+        if (callee AND NOT callee STREQUAL "${name}.cold")
+            list(APPEND calls "${callee}")
+        endif()
+    endforeach()
+    list(REMOVE_DUPLICATES calls)
+    set(${out_var} "${calls}" PARENT_SCOPE)
+endfunction()
+
+count_vector_instructions(${KERNEL}_reference ref_vector)
+count_vector_instructions(${KERNEL}_flux flux_vector)
+called_functions(${KERNEL}_reference ref_calls)
+called_functions(${KERNEL}_flux flux_calls)
+
+message("${KERNEL}_reference: ${ref_vector} vector instructions, calls: [${ref_calls}]")
+message("${KERNEL}_flux: ${flux_vector} vector instructions, calls: [${flux_calls}]")
+
+set(failed FALSE)
+
+if (ref_vector GREATER 0 AND flux_vector EQUAL 0)
+    message("${KERNEL}_flux was not vectorised")
+    set(failed TRUE)
+endif()
+
+foreach(callee IN LISTS flux_calls)
+    if (NOT callee IN_LIST ref_calls)
+        message("${KERNEL}_flux calls ${callee}, which the reference does not")
+        set(failed TRUE)
+    endif()
+endforeach()
+
+if (failed)
+    message(FATAL_ERROR "codegen check failed for ${KERNEL}")
+endif()
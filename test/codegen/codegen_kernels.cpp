@@ -0,0 +1,125 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Kernels whose generated assembly is inspected by check_codegen.cmake.
+//
+// Each pipeline is written twice: a hand-written loop named <name>_reference,
+// and the flux version named <name>_flux. This file is only compiled to
+// assembly, never linked, so the kernels are extern "C" to keep their
+// symbol names predictable.
+
+#include <flux/adaptor/adjacent.hpp>
+#include <flux/adaptor/cartesian_product.hpp>
+#include <flux/adaptor/chain.hpp>
+#include <flux/adaptor/filter.hpp>
+#include <flux/adaptor/map.hpp>
+#include <flux/adaptor/stride.hpp>
+#include <flux/adaptor/zip.hpp>
+#include <flux/algorithm/fold.hpp>
+#include <flux/algorithm/for_each.hpp>
+#include <flux/sequence/iota.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <span>
+
+namespace {
+
+constexpr auto triple = [](int x) { return 3 * x; };
+constexpr auto is_positive = [](int x) { return x > 0; };
+
+}
+
+extern "C" {
+
+int map_filter_sum_reference(int const* data, std::size_t n)
+{
+    int res = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        int x = triple(data[i]);
+        if (is_positive(x)) { res += x; }
+    }
+    return res;
+}
+
+int map_filter_sum_flux(int const* data, std::size_t n)
+{
+    return flux::from(std::span(data, n)).map(triple).filter(is_positive).sum();
+}
+
+int zip_dot_product_reference(int const* a, int const* b, std::size_t n)
+{
+    int res = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        res += a[i] * b[i];
+    }
+    return res;
+}
+
+int zip_dot_product_flux(int const* a, int const* b, std::size_t n)
+{
+    return flux::zip(flux::from(std::span(a, n)), flux::from(std::span(b, n)))
+        .map(flux::unpack(std::multiplies{}))
+        .sum();
+}
+
+int stride_map_sum_reference(int const* data, std::size_t n)
+{
+    int res = 0;
+    for (std::size_t i = 0; i < n; i += 3) {
+        res += triple(data[i]);
+    }
+    return res;
+}
+
+int stride_map_sum_flux(int const* data, std::size_t n)
+{
+    return flux::from(std::span(data, n)).stride(3).map(triple).sum();
+}
+
+int pairwise_diff_sum_reference(int const* data, std::size_t n)
+{
+    int res = 0;
+    for (std::size_t i = 1; i < n; i++) {
+        res += data[i] - data[i - 1];
+    }
+    return res;
+}
+
+int pairwise_diff_sum_flux(int const* data, std::size_t n)
+{
+    return flux::from(std::span(data, n))
+        .pairwise_map([](int a, int b) { return b - a; })
+        .sum();
+}
+
+void cartesian_product_memset_reference(double* A, flux::distance_t N, flux::distance_t M)
+{
+    for (flux::distance_t i = 0; i != N; ++i) {
+        for (flux::distance_t j = 0; j != M; ++j) {
+            A[i * M + j] = 0.0;
+        }
+    }
+}
+
+void cartesian_product_memset_flux(double* A, flux::distance_t N, flux::distance_t M)
+{
+    flux::for_each(flux::cartesian_product(flux::ints(0, N), flux::ints(0, M)),
+                   flux::unpack([&](auto i, auto j) { A[i * M + j] = 0.0; }));
+}
+
+int chain_sum_reference(int const* a, std::size_t n, int const* b, std::size_t m)
+{
+    int res = 0;
+    for (std::size_t i = 0; i < n; i++) { res += a[i]; }
+    for (std::size_t i = 0; i < m; i++) { res += b[i]; }
+    return res;
+}
+
+int chain_sum_flux(int const* a, std::size_t n, int const* b, std::size_t m)
+{
+    return flux::chain(flux::from(std::span(a, n)), flux::from(std::span(b, m))).sum();
+}
+
+}
@@ -244,6 +244,26 @@ constexpr bool test_adjacent()
         STATIC_CHECK(seq.is_last(seq.last()));
     }
 
+    // Internal iteration works as expected
+    {
+        auto seq = flux::adjacent<3>(std::array{1, 2, 3, 4, 5});
+
+        STATIC_CHECK(seq.count() == 3);
+        STATIC_CHECK(seq.fold([](int sum, auto t) {
+            auto [a, b, c] = t;
+            return sum + a * b * c;
+        }, 0) == 6 + 24 + 60);
+
+        auto cur = seq.find_if([](auto t) { return std::get<0>(t) == 2; });
+        STATIC_CHECK(tuple_equal(seq[cur], std::array{2, 3, 4}));
+
+        cur = seq.find_if([](auto t) { return std::get<0>(t) == 9; });
+        STATIC_CHECK(cur == seq.last());
+
+        // Fewer elements than the window size
+        STATIC_CHECK(flux::adjacent<3>(std::array{1, 2}).count() == 0);
+    }
+
     return true;
 }
 static_assert(test_adjacent());
@@ -0,0 +1,130 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+struct sale {
+    std::string_view region;
+    int amount;
+};
+
+// std::hash isn't constexpr, so use a trivial one for compile-time tests
+constexpr auto identity_hash = [](int i) { return static_cast<std::size_t>(i); };
+
+constexpr bool test_aggregate_by()
+{
+    // Empty sequence
+    {
+        auto result = flux::aggregate_by(flux::empty<int>, std::identity{}, 0,
+                                         std::plus<>{}, identity_hash);
+        STATIC_CHECK(result.empty());
+    }
+
+    // Groups appear in order of first occurrence
+    {
+        int arr[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+
+        auto result = flux::aggregate_by(arr, [](int i) { return i % 3; }, 0,
+                                         std::plus<>{}, identity_hash);
+
+        using P = std::pair<int, int>;
+        STATIC_CHECK(result == std::vector<P>{{0, 3 + 9 + 6 + 3}, {1, 1 + 4 + 1}, {2, 5 + 2 + 5 + 5}});
+    }
+
+    // More groups than the initial table size, so that we rehash
+    {
+        auto result = flux::aggregate_by(flux::ints(0, 1000),
+                                         [](auto i) { return int(i % 200); },
+                                         flux::distance_t{0},
+                                         [](flux::distance_t n, auto) { return n + 1; },
+                                         identity_hash);
+
+        STATIC_CHECK(result.size() == 200);
+        STATIC_CHECK(flux::all(result, [](auto const& p) { return p.second == 5; }));
+        STATIC_CHECK(flux::equal(flux::ref(result).map(&std::pair<int, flux::distance_t>::first),
+                                 flux::ints(0, 200)));
+    }
+
+    return true;
+}
+static_assert(test_aggregate_by());
+
+}
+
+TEST_CASE("aggregate_by")
+{
+    bool res = test_aggregate_by();
+    REQUIRE(res);
+
+    SUBCASE("group by string key")
+    {
+        std::vector<sale> sales{
+            {"north", 10}, {"south", 5}, {"east", 7}, {"north", 3},
+            {"west", 1}, {"east", 2}, {"north", 4},
+        };
+
+        auto totals = flux::aggregate_by(sales, &sale::region, 0,
+                                         [](int acc, sale const& s) { return acc + s.amount; });
+
+        using P = std::pair<std::string_view, int>;
+        CHECK(totals == std::vector<P>{{"north", 17}, {"south", 5}, {"east", 9}, {"west", 1}});
+    }
+
+    SUBCASE("accumulator type differs from element type")
+    {
+        std::vector<std::string> words{"apple", "avocado", "banana", "blueberry", "cherry", "apricot"};
+
+        auto by_initial = flux::ref(words).aggregate_by(
+            [](std::string const& w) { return w.front(); },
+            std::vector<std::string>{},
+            [](std::vector<std::string> acc, std::string const& w) {
+                acc.push_back(w);
+                return acc;
+            });
+
+        REQUIRE(by_initial.size() == 3);
+        CHECK(by_initial[0].first == 'a');
+        CHECK(by_initial[0].second == std::vector<std::string>{"apple", "avocado", "apricot"});
+        CHECK(by_initial[2].second == std::vector<std::string>{"cherry"});
+    }
+
+    SUBCASE("single-pass sequence")
+    {
+        auto seq = single_pass_only(flux::ints(0, 10));
+        auto result = flux::aggregate_by(std::move(seq), flux::pred::even, flux::distance_t{0},
+                                         std::plus<>{});
+
+        using P = std::pair<bool, flux::distance_t>;
+        CHECK(result == std::vector<P>{{true, 20}, {false, 25}});
+    }
+
+    SUBCASE("agrees with std::unordered_map")
+    {
+        std::vector<int> keys;
+        for (int i = 0; i < 100'000; i++) {
+            keys.push_back((i * 7919) % 10'007);
+        }
+
+        auto result = flux::aggregate_by(keys, std::identity{}, 0LL,
+                                         [](long long acc, int i) { return acc + i; });
+
+        std::unordered_map<int, long long> expected;
+        for (int k : keys) {
+            expected[k] += k;
+        }
+
+        REQUIRE(result.size() == expected.size());
+        CHECK(flux::all(result, [&](auto const& p) { return expected.at(p.first) == p.second; }));
+    }
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <flux/arena.hpp>
+
+#include "test_utils.hpp"
+
+namespace {
+
+struct counting_resource : std::pmr::memory_resource {
+    int n_allocs = 0;
+    int n_deallocs = 0;
+
+private:
+    auto do_allocate(std::size_t bytes, std::size_t align) -> void* override
+    {
+        ++n_allocs;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+
+    auto do_deallocate(void* p, std::size_t bytes, std::size_t align) -> void override
+    {
+        ++n_deallocs;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override
+    {
+        return this == &other;
+    }
+};
+
+}
+
+TEST_CASE("arena")
+{
+    SUBCASE("allocations are aligned and distinct")
+    {
+        flux::arena arena(64);
+
+        std::vector<void*> ptrs;
+        for (std::size_t align : {1, 2, 4, 8, 16, 32, 64, 128}) {
+            void* p = arena.allocate(24, align);
+            CHECK(reinterpret_cast<std::uintptr_t>(p) % align == 0);
+            ptrs.push_back(p);
+        }
+
+        for (std::size_t i = 1; i < ptrs.size(); i++) {
+            CHECK(ptrs[i] != ptrs[i - 1]);
+        }
+
+        CHECK(arena.bytes_allocated() == 8 * 24);
+    }
+
+    SUBCASE("large allocations")
+    {
+        flux::arena arena(64);
+        void* p = arena.allocate(100'000, 16);
+        CHECK(p != nullptr);
+        CHECK(arena.upstream_allocations() == 1);
+    }
+
+    SUBCASE("only allocates from upstream when a block is exhausted")
+    {
+        counting_resource upstream;
+        {
+            flux::arena arena(1024, &upstream);
+            CHECK(upstream.n_allocs == 0);
+
+            for (int i = 0; i < 10; i++) {
+                (void) arena.allocate(64, 8);
+            }
+            CHECK(upstream.n_allocs == 1);
+            CHECK(arena.upstream_allocations() == 1);
+
+            for (int i = 0; i < 1000; i++) {
+                (void) arena.allocate(64, 8);
+            }
+            CHECK(upstream.n_allocs > 1);
+            CHECK(upstream.n_allocs < 20); // blocks grow geometrically
+        }
+        CHECK(upstream.n_deallocs == upstream.n_allocs);
+    }
+
+    SUBCASE("reset coalesces blocks for reuse")
+    {
+        counting_resource upstream;
+        flux::arena arena(256, &upstream);
+
+        auto work = [&] {
+            std::pmr::vector<std::pmr::string> vec(&arena);
+            for (int i = 0; i < 100; i++) {
+                vec.emplace_back(std::string(40, char('a' + i % 26)));
+            }
+            return vec.size();
+        };
+
+        CHECK(work() == 100);
+        int const first_allocs = upstream.n_allocs;
+        CHECK(first_allocs > 1);
+
+        arena.reset();
+        CHECK(upstream.n_deallocs == first_allocs);
+        CHECK(upstream.n_allocs == first_allocs + 1);
+        CHECK(arena.bytes_allocated() == 0);
+
+        // The coalesced block is large enough that later rounds of the same
+        // size don't need upstream at all
+        for (int i = 0; i < 5; i++) {
+            arena.reset();
+            CHECK(work() == 100);
+            auto vec = flux::split_string(std::string_view("a bb ccc dddd"), ' ')
+                           .to<std::pmr::vector<std::pmr::string>>(&arena);
+            CHECK(vec.size() == 4);
+        }
+        CHECK(upstream.n_allocs == first_allocs + 1);
+
+        arena.release();
+        CHECK(upstream.n_deallocs == upstream.n_allocs);
+    }
+
+    SUBCASE("arenas compare equal only to themselves")
+    {
+        flux::arena a1, a2;
+        CHECK(a1.is_equal(a1));
+        CHECK(!a1.is_equal(a2));
+    }
+}
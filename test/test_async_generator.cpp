@@ -0,0 +1,269 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <flux/async.hpp>
+
+#include "test_utils.hpp"
+
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>
+#endif
+
+namespace {
+
+using flux::async_generator;
+using flux::task;
+
+auto ints(int from, int const to) -> async_generator<int>
+{
+    while (from < to) {
+        co_yield from++;
+    }
+}
+
+auto add(int a, int b) -> task<int>
+{
+    co_return a + b;
+}
+
+// Awaits another task between each element
+auto sums(int n) -> async_generator<int>
+{
+    for (int i = 0; i < n; i++) {
+        co_yield co_await add(i, i);
+    }
+}
+
+auto strings() -> async_generator<std::string>
+{
+    co_yield "a";
+    co_yield std::string("b");
+    std::string c = "c";
+    co_yield c;
+}
+
+auto throws_after(int n) -> async_generator<int>
+{
+    for (int i = 0; i < n; i++) {
+        co_yield i;
+    }
+    throw std::runtime_error("oops");
+}
+
+auto collect(async_generator<int> gen) -> task<std::vector<int>>
+{
+    std::vector<int> out;
+    while (auto elem = co_await gen.next()) {
+        out.push_back(*elem);
+    }
+    co_return out;
+}
+
+#if __has_include(<fcntl.h>)
+
+struct pipe_fds {
+    int fds[2] = {-1, -1};
+
+    pipe_fds()
+    {
+        REQUIRE(::pipe(fds) == 0);
+        ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        ::fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    }
+
+    ~pipe_fds() { close_read(); close_write(); }
+
+    void close_read() { if (fds[0] >= 0) { ::close(std::exchange(fds[0], -1)); } }
+    void close_write() { if (fds[1] >= 0) { ::close(std::exchange(fds[1], -1)); } }
+};
+
+auto make_contents(std::size_t size) -> std::string
+{
+    std::string str(size, '\0');
+    for (std::size_t i = 0; i < size; i++) {
+        str[i] = static_cast<char>('a' + (i % 26));
+    }
+    return str;
+}
+
+auto write_then_close(flux::event_loop& loop, pipe_fds& pipe, std::string const& data,
+                      flux::distance_t piece) -> task<>
+{
+    for (flux::distance_t i = 0; i < flux::distance_t(data.size()); i += piece) {
+        auto n = std::min(piece, flux::distance_t(data.size()) - i);
+        co_await loop.write_all(pipe.fds[1], data.data() + i, n);
+        // Let the reader run
+        co_await loop.schedule();
+    }
+    pipe.close_write();
+}
+
+auto count_lines(flux::event_loop& loop, int fd) -> task<int>
+{
+    co_return co_await loop.read_blocks(fd, 7)
+        .map([](flux::array_ptr<char const> const& block) {
+            return int(flux::count_eq(block, '\n'));
+        })
+        .fold(std::plus<>{}, 0);
+}
+
+#endif
+
+}
+
+TEST_CASE("async_generator")
+{
+    SUBCASE("concepts")
+    {
+        using G = async_generator<int>;
+
+        static_assert(flux::async_sequence<G>);
+        static_assert(!flux::sequence<G>);
+        static_assert(std::same_as<flux::async_element_t<G>, int const&>);
+        static_assert(std::same_as<flux::async_value_t<G>, int>);
+
+        using R = async_generator<std::string&>;
+        static_assert(std::same_as<flux::async_element_t<R>, std::string&>);
+
+        static_assert(!flux::async_sequence<std::vector<int>>);
+    }
+
+    SUBCASE("basic iteration")
+    {
+        CHECK(flux::sync_wait(collect(ints(0, 5))) == std::vector{0, 1, 2, 3, 4});
+        CHECK(flux::sync_wait(collect(ints(0, 0))).empty());
+        CHECK(flux::sync_wait(collect(sums(4))) == std::vector{0, 2, 4, 6});
+    }
+
+    SUBCASE("adaptors")
+    {
+        auto gen = ints(0, 20)
+                       .filter(flux::pred::even)
+                       .map([](int i) { return i * 10; })
+                       .take(4);
+
+        CHECK(flux::sync_wait(std::move(gen).fold(std::plus<>{}, 0)) == 0 + 20 + 40 + 60);
+
+        auto chunks = flux::sync_wait(
+            ints(0, 7).chunk(3).fold([](std::vector<std::vector<int>> acc, auto const& c) {
+                acc.push_back(c);
+                return acc;
+            }, std::vector<std::vector<int>>{}));
+
+        CHECK(chunks == std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}});
+
+        std::vector<std::string> out;
+        (void) flux::sync_wait(strings().for_each([&out](std::string const& s) {
+            out.push_back(s + s);
+        }));
+        CHECK(out == std::vector<std::string>{"aa", "bb", "cc"});
+    }
+
+    SUBCASE("take does not pull extra elements")
+    {
+        int n_produced = 0;
+        auto counted = [&n_produced]() -> async_generator<int> {
+            for (int i = 0; ; i++) {
+                ++n_produced;
+                co_yield i;
+            }
+        };
+
+        CHECK(flux::sync_wait(flux::async_fold(flux::async_take(counted(), 3),
+                                               std::plus<>{})) == 3);
+        CHECK(n_produced == 3);
+    }
+
+    SUBCASE("exceptions propagate to the consumer")
+    {
+        auto t = flux::async_for_each(throws_after(3), [](int) {});
+        CHECK_THROWS_AS(flux::sync_wait(std::move(t)), std::runtime_error);
+
+        CHECK_THROWS_AS(flux::sync_wait(ints(0, 3).take(-1).fold(std::plus<>{})),
+                        flux::unrecoverable_error);
+    }
+
+#if __has_include(<fcntl.h>)
+    SUBCASE("event loop: reading from a pipe")
+    {
+        flux::event_loop loop;
+        pipe_fds pipe;
+
+        std::string const data = "one\ntwo\nthree\nfour\nfive\n";
+        loop.spawn(write_then_close(loop, pipe, data, 5));
+
+        CHECK(loop.run(count_lines(loop, pipe.fds[0])) == 5);
+    }
+
+    SUBCASE("event loop: large writes interleave with reads")
+    {
+        flux::event_loop loop;
+        pipe_fds pipe;
+
+        // Larger than the pipe buffer, so the writer must wait for the reader
+        auto const data = make_contents(1'000'000);
+        loop.spawn(write_then_close(loop, pipe, data, 100'000));
+
+        auto read_all = [&]() -> task<std::string> {
+            std::string out;
+            co_await loop.read_blocks(pipe.fds[0], 4096)
+                .for_each([&out](flux::array_ptr<char const> const& block) {
+                    out.append(block.data(), block.usize());
+                });
+            co_return out;
+        };
+
+        CHECK(loop.run(read_all()) == data);
+    }
+
+    SUBCASE("event loop: reading a local file")
+    {
+        auto const contents = make_contents(10'000);
+        auto path = (std::filesystem::temp_directory_path() / "flux_async_generator_test").string();
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << contents;
+        }
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        REQUIRE(fd >= 0);
+
+        flux::event_loop loop;
+        auto n_bytes = loop.run(loop.read_blocks(fd, 1000)
+            .map([](flux::array_ptr<char const> const& block) { return block.size(); })
+            .fold(std::plus<>{}, flux::distance_t{0}));
+
+        CHECK(n_bytes == 10'000);
+
+        ::close(fd);
+        std::remove(path.c_str());
+    }
+
+    SUBCASE("event loop: spawned task exceptions are rethrown from run()")
+    {
+        flux::event_loop loop;
+
+        auto failing = []() -> task<> {
+            throw std::runtime_error("failed");
+            co_return;
+        };
+
+        auto waiting = [&loop]() -> task<> {
+            for (int i = 0; i < 10; i++) {
+                co_await loop.schedule();
+            }
+        };
+
+        loop.spawn(failing());
+        CHECK_THROWS_AS(loop.run(waiting()), std::runtime_error);
+    }
+#endif
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+using flux::batch_generator;
+
+auto ints(int from, int const to) -> batch_generator<int, 4>
+{
+    while (from < to) {
+        co_yield from++;
+    }
+}
+
+auto ints_in_chunks(int from, int const to) -> batch_generator<int>
+{
+    std::array<int, 3> arr{};
+    while (from + 3 <= to) {
+        arr = {from, from + 1, from + 2};
+        co_yield arr;
+        from += 3;
+    }
+    while (from < to) {
+        co_yield from++;
+    }
+}
+
+auto mixed() -> batch_generator<int, 2>
+{
+    std::vector<int> const vec{2, 3, 4};
+    std::array<int, 2> const arr{8, 9};
+
+    co_yield 1;
+    co_yield vec;
+    co_yield 5;
+    co_yield 6;
+    co_yield 7;
+    co_yield std::vector<int>();
+    co_yield arr;
+}
+
+auto strings() -> batch_generator<std::string, 3>
+{
+    co_yield "a";
+    co_yield std::string("b");
+    std::string c = "c";
+    co_yield c;
+    co_yield std::string("d");
+}
+
+auto empty() -> batch_generator<int>
+{
+    co_return;
+}
+
+auto single(int i) -> batch_generator<int>
+{
+    co_yield i;
+}
+
+}
+
+TEST_CASE("batch_generator")
+{
+    SUBCASE("basic batch_generator tests")
+    {
+        auto gen = ints(0, 10);
+
+        using G = decltype(gen);
+
+        static_assert(flux::sequence<G>);
+        static_assert(not flux::multipass_sequence<G>);
+        static_assert(not flux::sized_sequence<G>);
+        static_assert(not flux::bounded_sequence<G>);
+
+        static_assert(std::same_as<flux::element_t<G>, int const&>);
+        static_assert(std::same_as<flux::value_t<G>, int>);
+
+        // Iteration via cursors
+        int i = 0;
+        for (auto cur = gen.first(); !gen.is_last(cur); gen.inc(cur)) {
+            CHECK(gen[cur] == i++);
+        }
+        CHECK(i == 10);
+    }
+
+    SUBCASE("internal iteration")
+    {
+        CHECK(flux::sum(ints(0, 10)) == 45);
+        CHECK(flux::sum(ints(0, 4)) == 6);
+        CHECK(flux::sum(ints(0, 1)) == 0);
+        CHECK(flux::sum(ints_in_chunks(0, 100)) == 4950);
+    }
+
+    SUBCASE("early termination")
+    {
+        CHECK(check_equal(ints(0, 100).take(6), {0, 1, 2, 3, 4, 5}));
+
+        auto gen = ints(0, 100);
+        auto cur = flux::find(gen, 7);
+        REQUIRE(!gen.is_last(cur));
+        CHECK(gen[cur] == 7);
+    }
+
+    SUBCASE("yielding sequences and single elements")
+    {
+        CHECK(check_equal(mixed(), {1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        CHECK(mixed().to<std::vector>() == std::vector{1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+        auto gen = ints_in_chunks(0, 10);
+        CHECK(check_equal(gen, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    SUBCASE("non-trivial element type")
+    {
+        CHECK(strings().to<std::vector>() == std::vector<std::string>{"a", "b", "c", "d"});
+    }
+
+    SUBCASE("empty batch_generator")
+    {
+        auto gen = empty();
+        CHECK(gen.is_last(gen.first()));
+        CHECK(flux::count(empty()) == 0);
+    }
+
+    SUBCASE("default-capacity frames are recycled")
+    {
+        if constexpr (flux::config::enable_generator_frame_pool) {
+            // The first element is in the buffer, so its address identifies
+            // the frame
+            int const* frame = nullptr;
+            {
+                auto gen = single(1);
+                frame = &gen[gen.first()];
+            }
+
+            // If the frame went back to the global allocator, one of these
+            // would be likely to reuse it
+            std::vector<std::unique_ptr<char[]>> blocks;
+            for (std::size_t sz = 16; sz <= 8192; sz += 16) {
+                blocks.push_back(std::make_unique<char[]>(sz));
+            }
+
+            auto gen = single(2);
+            auto cur = gen.first();
+            CHECK(&gen[cur] == frame);
+            CHECK(gen[cur] == 2);
+        }
+    }
+
+    SUBCASE("adaptors")
+    {
+        auto seq = ints(0, 20).filter(flux::pred::even).map([](int i) { return i * 10; });
+
+        CHECK(check_equal(seq, {0, 20, 40, 60, 80, 100, 120, 140, 160, 180}));
+    }
+}
@@ -0,0 +1,144 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+constexpr auto identity_hash = [](int i) { return static_cast<std::size_t>(i); };
+
+constexpr bool test_distinct()
+{
+    // Basic distinct
+    {
+        int arr[] = {3, 1, 3, 2, 1, 4, 3, 5, 2};
+
+        auto seq = flux::distinct(flux::ref(arr), identity_hash);
+
+        using S = decltype(seq);
+        static_assert(flux::sequence<S>);
+        static_assert(!flux::multipass_sequence<S>);
+        static_assert(!flux::sized_sequence<S>);
+        static_assert(flux::bounded_sequence<S>);
+        static_assert(std::same_as<flux::element_t<S>, int const&>);
+        static_assert(std::same_as<flux::value_t<S>, int>);
+
+        STATIC_CHECK(check_equal(std::move(seq), {3, 1, 2, 4, 5}));
+    }
+
+    // Empty sequence
+    {
+        auto seq = flux::distinct(flux::empty<int>, identity_hash);
+        STATIC_CHECK(std::move(seq).count() == 0);
+    }
+
+    // All duplicates
+    {
+        auto seq = flux::repeat(7, 100).distinct(identity_hash);
+        STATIC_CHECK(check_equal(std::move(seq), {7}));
+    }
+
+    // Internal iteration
+    {
+        auto seq = flux::ints(0, 1000)
+                       .map([](auto i) { return int(i % 37); })
+                       .distinct(identity_hash);
+
+        STATIC_CHECK(std::move(seq).sum() == 36 * 37 / 2);
+    }
+
+    // Works on single-pass sequences
+    {
+        int arr[] = {1, 1, 2, 1, 3};
+        auto seq = flux::distinct(single_pass_only(flux::ref(arr)), identity_hash);
+        STATIC_CHECK(check_equal(std::move(seq), {1, 2, 3}));
+    }
+
+    // Custom equality
+    {
+        int arr[] = {1, 11, 2, 22, 12, 3};
+        auto last_digit_hash = [](int i) { return static_cast<std::size_t>(i % 10); };
+        auto last_digit_eq = [](int i, int j) { return i % 10 == j % 10; };
+
+        auto seq = flux::distinct(flux::ref(arr), last_digit_hash, last_digit_eq);
+        STATIC_CHECK(check_equal(std::move(seq), {1, 2, 3}));
+    }
+
+    return true;
+}
+static_assert(test_distinct());
+
+}
+
+TEST_CASE("distinct")
+{
+    bool res = test_distinct();
+    REQUIRE(res);
+
+    SUBCASE("strings with std::hash")
+    {
+        std::vector<std::string> words{"the", "cat", "sat", "on", "the", "mat", "cat"};
+
+        auto out = flux::ref(words).distinct().to<std::vector<std::string>>();
+        CHECK(out == std::vector<std::string>{"the", "cat", "sat", "on", "mat"});
+    }
+
+    SUBCASE("elements can be moved from, because only copies are remembered")
+    {
+        std::vector<std::string> words{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "b", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+
+        std::vector<std::string> out;
+        FLUX_FOR(auto&& s, flux::distinct(flux::mut_ref(words))) {
+            out.push_back(std::move(s));
+        }
+        CHECK(out == std::vector<std::string>{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "b"});
+    }
+
+    SUBCASE("istream")
+    {
+        std::istringstream iss("5 3 5 1 3 3 9");
+        auto out = flux::from_istream<int>(iss).distinct().to<std::vector<int>>();
+        CHECK(out == std::vector{5, 3, 1, 9});
+    }
+
+    SUBCASE("capacity hint and allocator")
+    {
+        std::pmr::monotonic_buffer_resource res;
+        std::pmr::polymorphic_allocator<int> alloc(&res);
+
+        auto seq = flux::distinct(flux::ints(0, 10'000).map([](auto i) { return int(i % 100); }),
+                                  100, std::hash<int>{}, std::equal_to<>{}, alloc);
+        CHECK(std::move(seq).count() == 100);
+    }
+
+    SUBCASE("approx_distinct never yields duplicates")
+    {
+        std::vector<int> ints;
+        for (int i = 0; i < 100'000; i++) {
+            ints.push_back((i * 7919) % 20'011);
+        }
+
+        auto out = flux::approx_distinct(flux::ref(ints), 20'011, 0.01).to<std::vector<int>>();
+
+        auto exact = flux::distinct(flux::ref(out)).count();
+        CHECK(exact == flux::count(out));
+
+        // Allow for some elements being wrongly discarded as false positives
+        CHECK(out.size() <= 20'011);
+        CHECK(out.size() >= 19'000);
+    }
+
+    SUBCASE("approx_distinct is memory-bounded")
+    {
+        auto seq = flux::approx_distinct(flux::ints(0, 1'000'000), 1000, 0.05);
+        // With far more distinct elements than expected, the filter saturates
+        // and starts dropping elements, but doesn't grow
+        CHECK(std::move(seq).count() < 1'000'000);
+    }
+}
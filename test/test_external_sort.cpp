@@ -0,0 +1,163 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <compare>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <flux/external_sort.hpp>
+
+#include "test_utils.hpp"
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// A fresh directory for the temporary files of one test, removed afterwards
+struct temp_dir {
+    fs::path path = fs::temp_directory_path() / "flux-test-external-sort";
+
+    temp_dir()
+    {
+        fs::remove_all(path);
+        fs::create_directory(path);
+    }
+
+    ~temp_dir() { fs::remove_all(path); }
+
+    auto num_files() const -> std::ptrdiff_t
+    {
+        return std::distance(fs::directory_iterator(path), fs::directory_iterator{});
+    }
+};
+
+auto collect(auto&& seq)
+{
+    std::vector<flux::value_t<decltype(seq)>> out;
+    FLUX_FOR(auto&& elem, FLUX_FWD(seq)) {
+        out.push_back(FLUX_FWD(elem));
+    }
+    return out;
+}
+
+auto random_ints(std::size_t n)
+{
+    std::mt19937 gen{4321};
+    std::uniform_int_distribution<int> dist{-1000, 1000};
+    std::vector<int> vec(n);
+    std::ranges::generate(vec, [&] { return dist(gen); });
+    return vec;
+}
+
+struct record {
+    int key;
+    float payload;
+};
+
+}
+
+TEST_CASE("external_sort")
+{
+    temp_dir dir;
+
+    SUBCASE("input which fits in the budget is sorted in memory")
+    {
+        auto const input = random_ints(1000);
+
+        auto sorted = flux::external_sort(flux::ref(input), std::compare_three_way{},
+                                          1000 * sizeof(int), dir.path);
+
+        static_assert(flux::sequence<decltype(sorted)>);
+        static_assert(!flux::multipass_sequence<decltype(sorted)>);
+        CHECK(dir.num_files() == 0);
+
+        auto expected = input;
+        std::ranges::sort(expected);
+        CHECK(collect(std::move(sorted)) == expected);
+    }
+
+    SUBCASE("larger input is spilled in runs and merged")
+    {
+        auto const input = random_ints(10'000);
+        auto expected = input;
+        std::ranges::sort(expected);
+
+        {
+            // 100 runs of 100 elements, read back 1 element at a time
+            auto sorted = flux::external_sort(flux::ref(input), std::compare_three_way{},
+                                              100 * sizeof(int), dir.path);
+            CHECK(dir.num_files() == 1);
+            CHECK(collect(std::move(sorted)) == expected);
+        }
+
+        {
+            // Input which doesn't divide evenly into runs
+            auto sorted = flux::external_sort(flux::ref(input), std::compare_three_way{},
+                                              3000 * sizeof(int), dir.path);
+            CHECK(collect(std::move(sorted)) == expected);
+        }
+
+        // The temporary file is removed along with the sorted sequence
+        CHECK(dir.num_files() == 0);
+    }
+
+    SUBCASE("iteration can be restarted")
+    {
+        auto const input = random_ints(500);
+
+        auto sorted = flux::external_sort(flux::ref(input), std::compare_three_way{},
+                                          64 * sizeof(int), dir.path);
+
+        CHECK(sorted.count() == 500);
+        CHECK(sorted.count() == 500);
+    }
+
+    SUBCASE("single-pass input with a custom comparator")
+    {
+        std::istringstream iss("5 3 9 1 7 3 8 2 6 4 0");
+
+        auto sorted = flux::external_sort(flux::from_istream<int>(iss),
+                                          flux::cmp::reverse_compare,
+                                          2 * sizeof(int), dir.path);
+
+        CHECK(collect(std::move(sorted)) == std::vector{9, 8, 7, 6, 5, 4, 3, 3, 2, 1, 0});
+    }
+
+    SUBCASE("trivially copyable records")
+    {
+        std::vector<record> input;
+        for (int i = 0; i < 1000; i++) {
+            input.push_back({i % 10, static_cast<float>(i)});
+        }
+
+        auto sorted = flux::external_sort(flux::ref(input),
+                                          flux::proj(std::compare_three_way{}, &record::key),
+                                          100 * sizeof(record), dir.path);
+
+        auto out = collect(std::move(sorted));
+        REQUIRE(out.size() == input.size());
+        CHECK(std::ranges::is_sorted(out, {}, &record::key));
+        // Runs are sorted with pdqsort, which is not stable, but every
+        // element must appear exactly once
+        std::vector<float> payloads;
+        for (auto const& r : out) {
+            payloads.push_back(r.payload);
+        }
+        std::ranges::sort(payloads);
+        for (int i = 0; i < 1000; i++) {
+            CHECK(payloads[static_cast<std::size_t>(i)] == static_cast<float>(i));
+        }
+    }
+
+    SUBCASE("empty input")
+    {
+        auto sorted = flux::external_sort(flux::empty<int>, std::compare_three_way{},
+                                          1024, dir.path);
+        CHECK(sorted.count() == 0);
+        CHECK(dir.num_files() == 0);
+    }
+}
@@ -90,6 +90,18 @@ constexpr bool test_flatten_single_pass()
         STATIC_CHECK(check_equal(seq, {1, 2, 3}));
     }
 
+    // The inner cursor is stored in the niche of flux::single()'s cursor,
+    // without a separate engaged flag
+    {
+        auto seq = flux::single(1).map(flux::single).flatten();
+
+        using S = decltype(seq);
+        static_assert(not flux::multipass_sequence<S>);
+        static_assert(sizeof(flux::cursor_t<S>) == 2);
+
+        STATIC_CHECK(check_equal(seq, {1}));
+    }
+
     // Short-circuiting internal iteration
     {
         std::array<std::array<int, 3>, 3> const arr{
@@ -7,10 +7,19 @@
 #include <coroutine>
 #include <memory>
 #include <ranges>
+#include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "test_utils.hpp"
 
+// GCC < 14 gives a false positive when a coroutine uses a templated
+// promise_type::operator new (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=109224)
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ < 14)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
 namespace {
 
 using flux::generator;
@@ -55,6 +64,127 @@ auto move_only() ->  generator<std::unique_ptr<int>&&>
     }
 }
 
+struct tree {
+    int value;
+    std::vector<tree> children;
+};
+
+auto preorder(tree const& t) -> generator<int>
+{
+    co_yield t.value;
+    for (tree const& child : t.children) {
+        co_yield flux::elements_of(preorder(child));
+    }
+}
+
+auto countdown(int n) -> generator<int>
+{
+    if (n > 0) {
+        co_yield n;
+        co_yield flux::elements_of(countdown(n - 1));
+    }
+}
+
+auto throws_after(int n) -> generator<int>
+{
+    for (int i = 0; i < n; i++) {
+        co_yield i;
+    }
+    throw std::runtime_error("oops");
+}
+
+auto nested_throw() -> generator<int>
+{
+    bool caught = false;
+    try {
+        co_yield flux::elements_of(throws_after(2));
+    } catch (std::runtime_error const&) {
+        caught = true;
+    }
+    if (caught) {
+        co_yield -1;
+    }
+    co_yield flux::elements_of(throws_after(1));
+}
+
+auto from_sequences() -> generator<int const&>
+{
+    std::vector<int> const vec{1, 2, 3};
+    co_yield flux::elements_of(vec);
+    co_yield flux::elements_of(flux::ints(4, 6).map([](auto i) { return int(i); }));
+    co_yield flux::elements_of(flux::empty<int>);
+    auto inner = ints(6, 8);
+    co_yield flux::elements_of(inner);
+}
+
+struct alloc_counter {
+    int allocs = 0;
+    int deallocs = 0;
+};
+
+template <typename T>
+struct counting_allocator {
+    using value_type = T;
+
+    alloc_counter* counter;
+
+    explicit counting_allocator(alloc_counter* c) : counter(c) {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const& other) : counter(other.counter) {}
+
+    auto allocate(std::size_t n) -> T*
+    {
+        ++counter->allocs;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n)
+    {
+        ++counter->deallocs;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    friend bool operator==(counting_allocator const& lhs, counting_allocator<U> const& rhs)
+    {
+        return lhs.counter == rhs.counter;
+    }
+};
+
+template <typename Alloc>
+auto ints_with_alloc(std::allocator_arg_t, Alloc, int from, int const to) -> generator<int>
+{
+    while (from < to) {
+        co_yield from++;
+    }
+}
+
+// Creates a generator from a thread_local destructor, which runs after the
+// thread's frame pool has been destroyed, and hands it to another thread
+struct late_generator_maker {
+    generator<int>* out = nullptr;
+
+    ~late_generator_maker()
+    {
+        if (out != nullptr) {
+            *out = ints(0, 3);
+        }
+    }
+};
+
+struct int_source {
+    int from;
+
+    template <typename Alloc>
+    auto ints(std::allocator_arg_t, Alloc, int const to) const -> generator<int>
+    {
+        for (int i = from; i < to; i++) {
+            co_yield i;
+        }
+    }
+};
+
 }
 
 TEST_CASE("generator")
@@ -118,6 +248,135 @@ TEST_CASE("generator")
         CHECK(check_equal(seq, {0, 1, 1, 2, 3, 5, 8, 13, 21, 34}));
     }
 
+    SUBCASE("internal iteration")
+    {
+        CHECK(flux::sum(ints(0, 10)) == 45);
+        CHECK(flux::count(ints(0, 0)) == 0);
+
+        auto gen = ints(0, 10);
+        auto cur = flux::find(gen, 5);
+        REQUIRE(!gen.is_last(cur));
+        CHECK(gen[cur] == 5);
+        gen.inc(cur);
+        CHECK(gen[cur] == 6);
+    }
+
+    SUBCASE("recursive generators")
+    {
+        tree const t{1, {{2, {{3, {}}, {4, {}}}},
+                         {5, {}},
+                         {6, {{7, {{8, {}}}}}}}};
+
+        CHECK(check_equal(preorder(t), {1, 2, 3, 4, 5, 6, 7, 8}));
+        CHECK(flux::sum(preorder(t)) == 36);
+
+        auto gen = preorder(t);
+        int i = 1;
+        for (auto cur = gen.first(); !gen.is_last(cur); gen.inc(cur)) {
+            CHECK(gen[cur] == i++);
+        }
+        CHECK(i == 9);
+    }
+
+    SUBCASE("deeply nested generators")
+    {
+        constexpr int depth = 10'000;
+
+        CHECK(flux::count(countdown(depth)) == depth);
+        CHECK(flux::sum(countdown(depth)) == depth * (depth + 1) / 2);
+
+        // Destroying a partially-consumed nested generator cleans up every level
+        CHECK(check_equal(countdown(depth).take(3), {depth, depth - 1, depth - 2}));
+    }
+
+    SUBCASE("exceptions propagate from nested generators")
+    {
+        auto gen = nested_throw();
+        auto cur = gen.first();
+        CHECK(gen[cur] == 0);
+        CHECK(gen[gen.inc(cur)] == 1);
+        CHECK(gen[gen.inc(cur)] == -1);
+        CHECK(gen[gen.inc(cur)] == 0);
+        CHECK_THROWS_AS(gen.inc(cur), std::runtime_error);
+    }
+
+    SUBCASE("elements_of with other sequences")
+    {
+        CHECK(check_equal(from_sequences(), {1, 2, 3, 4, 5, 6, 7}));
+    }
+
+    SUBCASE("generator with custom allocator")
+    {
+        alloc_counter counter;
+
+        {
+            auto gen = ints_with_alloc(std::allocator_arg,
+                                       counting_allocator<char>(&counter), 0, 5);
+            REQUIRE(counter.allocs == 1);
+            REQUIRE(counter.deallocs == 0);
+            CHECK(check_equal(gen, {0, 1, 2, 3, 4}));
+        }
+
+        CHECK(counter.allocs == 1);
+        CHECK(counter.deallocs == 1);
+    }
+
+    SUBCASE("member function generator with custom allocator")
+    {
+        alloc_counter counter;
+        int_source src{10};
+
+        {
+            auto gen = src.ints(std::allocator_arg, counting_allocator<int>(&counter), 13);
+            REQUIRE(counter.allocs == 1);
+            CHECK(check_equal(gen, {10, 11, 12}));
+        }
+
+        CHECK(counter.deallocs == 1);
+    }
+
+    SUBCASE("generators created in a loop")
+    {
+        // Frames are recycled through the thread-local pool; make sure that
+        // overlapping lifetimes of same-sized frames still work correctly
+        for (int i = 0; i < 100; i++) {
+            auto gen1 = ints(i, i + 3);
+            auto gen2 = ints(i + 3, i + 5);
+            CHECK(check_equal(gen1, {i, i + 1, i + 2}));
+            CHECK(check_equal(gen2, {i + 3, i + 4}));
+        }
+
+        std::vector<generator<int>> gens;
+        for (int i = 0; i < 100; i++) {
+            gens.push_back(ints(i, i + 1));
+        }
+        int sum = 0;
+        for (auto& g : gens) {
+            sum += flux::sum(g);
+        }
+        CHECK(sum == 4950);
+    }
+
+    SUBCASE("generators outliving their thread's frame pool")
+    {
+        generator<int> late = ints(0, 0);
+
+        std::thread([&] {
+            // Construct the maker before the pool, so it is destroyed after it
+            static thread_local late_generator_maker maker;
+            maker.out = &late;
+            CHECK(check_equal(ints(0, 2), {0, 1}));
+        }).join();
+
+        CHECK(check_equal(late, {0, 1, 2}));
+
+        // The frame goes into this thread's pool, and must be large enough
+        // for the next frame of the same size
+        late = ints(0, 0);
+        auto gen = ints(5, 8);
+        CHECK(check_equal(gen, {5, 6, 7}));
+    }
+
     SUBCASE("Pythagorean triples")
     {
         auto triples = pythagorean_triples().take(5);
@@ -0,0 +1,190 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+struct customer {
+    int id;
+    std::string_view name;
+};
+
+struct order {
+    int customer_id;
+    int amount;
+};
+
+constexpr auto identity_hash = [](int i) { return static_cast<std::size_t>(i); };
+
+constexpr bool test_hash_join()
+{
+    // Basic inner join, in probe order
+    {
+        std::pair<int, char> build[] = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
+        int probe[] = {3, 4, 1, 1, 5};
+
+        auto joined = flux::hash_join(build, flux::ref(probe),
+                                      [](auto const& p) { return p.first; },
+                                      std::identity{}, identity_hash);
+
+        using J = decltype(joined);
+        static_assert(flux::multipass_sequence<J>);
+        static_assert(flux::bounded_sequence<J>);
+        static_assert(!flux::sized_sequence<J>);
+        static_assert(std::same_as<flux::element_t<J>,
+                                   std::pair<std::pair<int, char> const&, int const&>>);
+
+        auto seconds = flux::ref(joined).map([](auto const& p) { return p.first.second; });
+        STATIC_CHECK(check_equal(seconds, {'c', 'a', 'a'}));
+
+        // Internal and external iteration agree
+        std::vector<char> ext;
+        for (auto [b, p] : joined) {
+            ext.push_back(b.second);
+        }
+        STATIC_CHECK(ext == std::vector{'c', 'a', 'a'});
+    }
+
+    // Duplicate build keys produce one output per match, in build order
+    {
+        std::pair<int, int> build[] = {{1, 10}, {2, 20}, {1, 11}, {1, 12}};
+        int probe[] = {1, 2, 1};
+
+        auto joined = flux::hash_join(build, flux::ref(probe),
+                                      [](auto const& p) { return p.first; },
+                                      std::identity{}, identity_hash);
+
+        auto vals = flux::ref(joined).map([](auto const& p) { return p.first.second; });
+        STATIC_CHECK(check_equal(vals, {10, 11, 12, 20, 10, 11, 12}));
+
+        // Stopping part way through the matches for one probe element
+        auto cur = flux::find_if(joined, [](auto const& p) { return p.first.second == 11; });
+        STATIC_CHECK(!joined.is_last(cur));
+        joined.inc(cur);
+        STATIC_CHECK(joined[cur].first.second == 12);
+        joined.inc(cur);
+        STATIC_CHECK(joined[cur].first.second == 20);
+    }
+
+    // Empty sides
+    {
+        int arr[] = {1, 2, 3};
+
+        auto j1 = flux::hash_join(flux::empty<int>, flux::ref(arr), std::identity{},
+                                  std::identity{}, identity_hash);
+        STATIC_CHECK(j1.is_empty());
+
+        auto j2 = flux::hash_join(arr, flux::empty<int>, std::identity{},
+                                  std::identity{}, identity_hash);
+        STATIC_CHECK(j2.is_empty());
+    }
+
+    // semi_join and anti_join
+    {
+        int build[] = {2, 4, 4, 6};
+        int probe[] = {1, 2, 3, 4, 5, 6, 4};
+
+        auto semi = flux::semi_join(build, flux::ref(probe), std::identity{},
+                                    std::identity{}, identity_hash);
+        STATIC_CHECK(check_equal(semi, {2, 4, 6, 4}));
+
+        auto anti = flux::anti_join(build, flux::ref(probe), std::identity{},
+                                    std::identity{}, identity_hash);
+        STATIC_CHECK(check_equal(anti, {1, 3, 5}));
+    }
+
+    return true;
+}
+static_assert(test_hash_join());
+
+}
+
+TEST_CASE("hash_join")
+{
+    bool res = test_hash_join();
+    REQUIRE(res);
+
+    SUBCASE("join structs on a key")
+    {
+        std::vector<customer> customers{{1, "alice"}, {2, "bob"}, {3, "carol"}};
+        std::vector<order> orders{{2, 10}, {1, 5}, {4, 100}, {2, 7}, {3, 1}};
+
+        std::vector<std::pair<std::string_view, int>> out;
+        flux::hash_join(customers, flux::ref(orders), &customer::id, &order::customer_id)
+            .for_each([&out](auto const& p) {
+                out.emplace_back(p.first.name, p.second.amount);
+            });
+
+        using P = std::pair<std::string_view, int>;
+        CHECK(out == std::vector<P>{{"bob", 10}, {"alice", 5}, {"bob", 7}, {"carol", 1}});
+    }
+
+    SUBCASE("single-pass probe sequence")
+    {
+        std::vector<int> build{1, 3, 5};
+        auto joined = flux::hash_join(build, single_pass_only(flux::ints(0, 7)),
+                                      std::identity{}, [](auto i) { return int(i); });
+
+        static_assert(!flux::multipass_sequence<decltype(joined)>);
+
+        std::vector<int> out;
+        FLUX_FOR(auto p, std::move(joined)) {
+            out.push_back(p.first);
+        }
+        CHECK(out == std::vector{1, 3, 5});
+    }
+
+    SUBCASE("large build side")
+    {
+        std::vector<std::pair<int, int>> build;
+        for (int i = 0; i < 100'000; i++) {
+            build.emplace_back(i, i * 2);
+        }
+        // Add some duplicate keys
+        for (int i = 0; i < 1000; i++) {
+            build.emplace_back(i * 3, -i);
+        }
+
+        auto joined = flux::hash_join(build, flux::ints(0, 200'000).map([](auto i) { return int(i); }),
+                                      [](auto const& p) { return p.first; }, std::identity{});
+
+        flux::distance_t count = 0;
+        bool all_match = true;
+        joined.for_each([&](auto const& p) {
+            ++count;
+            all_match = all_match && p.first.first == p.second;
+        });
+
+        CHECK(count == 101'000);
+        CHECK(all_match);
+
+        // Matches for a duplicated key are in build order
+        auto cur = flux::find_if(joined, [](auto const& p) { return p.second == 300; });
+        REQUIRE(!joined.is_last(cur));
+        CHECK(joined[cur].first.second == 600);
+        joined.inc(cur);
+        CHECK(joined[cur].first.second == -100);
+    }
+
+    SUBCASE("semi_join with strings")
+    {
+        std::vector<std::string> allowed{"red", "green"};
+        std::vector<std::string> colours{"red", "blue", "green", "red", "yellow"};
+
+        auto out = flux::semi_join(allowed, flux::ref(colours), std::identity{}, std::identity{})
+                       .to<std::vector<std::string>>();
+        CHECK(out == std::vector<std::string>{"red", "green", "red"});
+
+        auto out2 = flux::anti_join(allowed, flux::ref(colours), std::identity{}, std::identity{})
+                        .to<std::vector<std::string>>();
+        CHECK(out2 == std::vector<std::string>{"blue", "yellow"});
+    }
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+constexpr bool test_histogram()
+{
+    // Empty sequence
+    {
+        auto hist = flux::histogram(flux::empty<int>, flux::bins{0, 10, 5});
+        STATIC_CHECK(hist.num_bins() == 5);
+        STATIC_CHECK(hist.total() == 0);
+    }
+
+    // Values are counted into fixed-width bins, with under- and overflow
+    {
+        std::array arr{-3, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 9, 10, 11};
+
+        auto hist = flux::histogram(flux::ref(arr), flux::bins{0, 10, 5});
+
+        static_assert(std::same_as<decltype(hist), flux::histogram_counts<int>>);
+
+        STATIC_CHECK(hist.underflow() == 1);
+        STATIC_CHECK(check_equal(hist.counts(), {2u, 2u, 2u, 2u, 3u}));
+        STATIC_CHECK(hist.overflow() == 2);
+        STATIC_CHECK(hist.total() == arr.size());
+        STATIC_CHECK(hist.count(4) == 3);
+        STATIC_CHECK(hist.bin_min(0) == 0.0);
+        STATIC_CHECK(hist.bin_min(3) == 6.0);
+    }
+
+    // Non-contiguous and single-pass input
+    {
+        auto hist = flux::histogram(flux::ints(0, 100).filter(flux::pred::even),
+                                    flux::bins{0.0, 100.0, 4});
+
+        STATIC_CHECK(check_equal(hist.counts(), {13u, 12u, 13u, 12u}));
+        STATIC_CHECK(hist.underflow() == 0);
+        STATIC_CHECK(hist.overflow() == 0);
+    }
+
+    // Histograms over the same bins can be merged
+    {
+        std::array arr1{1.0, 2.5, 7.0};
+        std::array arr2{2.0, 9.5, 12.0};
+
+        auto hist = flux::histogram(flux::ref(arr1), flux::bins{0.0, 10.0, 2});
+        hist.merge(flux::histogram(flux::ref(arr2), flux::bins{0.0, 10.0, 2}));
+
+        STATIC_CHECK(check_equal(hist.counts(), {3u, 2u}));
+        STATIC_CHECK(hist.overflow() == 1);
+    }
+
+    return true;
+}
+static_assert(test_histogram());
+
+}
+
+TEST_CASE("histogram")
+{
+    bool res = test_histogram();
+    REQUIRE(res);
+
+    SUBCASE("NaNs are counted as underflow")
+    {
+        std::vector<float> vec{1.0f, std::numeric_limits<float>::quiet_NaN(), 2.0f,
+                               std::numeric_limits<float>::infinity(),
+                               -std::numeric_limits<float>::infinity()};
+
+        auto hist = flux::histogram(flux::ref(vec), flux::bins{0.0f, 4.0f, 4});
+        CHECK(hist.underflow() == 2);
+        CHECK(hist.overflow() == 1);
+        CHECK(hist.count(1) == 1);
+        CHECK(hist.count(2) == 1);
+    }
+
+    SUBCASE("values just outside the range are not rounded into the bins")
+    {
+        // Enough copies of each value to go through the blocked fast path
+        auto check_edges = [](auto b, auto below, auto last_in, auto denorm) {
+            using T = decltype(below);
+            std::vector<T> vec;
+            for (int i = 0; i < 1000; i++) {
+                vec.insert(vec.end(), {below, denorm, b.min, last_in, b.max});
+            }
+
+            auto hist = flux::histogram(flux::ref(vec), b);
+            CHECK(hist.underflow() == 2000);
+            CHECK(hist.count(0) == 1000);
+            CHECK(hist.count(b.count - 1) == 1000);
+            CHECK(hist.overflow() == 1000);
+
+            // And one at a time
+            flux::histogram_counts<T> single(b);
+            for (T v : vec) {
+                single.add(v);
+            }
+            CHECK(single.underflow() == 2000);
+            CHECK(single.count(0) == 1000);
+            CHECK(single.count(b.count - 1) == 1000);
+            CHECK(single.overflow() == 1000);
+        };
+
+        check_edges(flux::bins{0.0f, 1.0f, 10}, -1e-9f, std::nextafter(1.0f, 0.0f),
+                    -std::numeric_limits<float>::denorm_min());
+        check_edges(flux::bins{0.0, 1.0, 10}, -1e-18, std::nextafter(1.0, 0.0),
+                    -std::numeric_limits<double>::denorm_min());
+        check_edges(flux::bins{-3.0, 7.0, 1000}, std::nextafter(-3.0, -4.0),
+                    std::nextafter(7.0, 0.0), std::nextafter(-3.0, -4.0));
+    }
+
+    SUBCASE("contiguous fast path agrees with counting one at a time")
+    {
+        std::mt19937 gen{42};
+        std::normal_distribution<double> dist{50.0, 20.0};
+
+        for (std::size_t n_bins : {1u, 7u, 100u, 10'000u}) {
+            // Enough values to cover several blocks plus a partial one
+            std::vector<double> vec(5000);
+            for (double& d : vec) {
+                d = dist(gen);
+            }
+
+            auto hist = flux::histogram(flux::ref(vec), flux::bins{0.0, 100.0, n_bins});
+
+            flux::histogram_counts<double> expected(flux::bins{0.0, 100.0, n_bins});
+            for (double d : vec) {
+                expected.add(d);
+            }
+
+            CHECK(hist.underflow() == expected.underflow());
+            CHECK(hist.overflow() == expected.overflow());
+            CHECK(check_equal(hist.counts(), expected.counts()));
+            CHECK(hist.total() == vec.size());
+        }
+    }
+
+    SUBCASE("invalid bins")
+    {
+        CHECK_THROWS_AS(flux::histogram_counts<int>(flux::bins{0, 10, 0}),
+                        flux::unrecoverable_error);
+        CHECK_THROWS_AS(flux::histogram_counts<int>(flux::bins{10, 0, 5}),
+                        flux::unrecoverable_error);
+
+        flux::histogram_counts<int> h1(flux::bins{0, 10, 5});
+        flux::histogram_counts<int> h2(flux::bins{0, 10, 10});
+        CHECK_THROWS_AS(h1.merge(h2), flux::unrecoverable_error);
+    }
+}
@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "test_utils.hpp"
+
+// This file is built twice, with FLUX_ENABLE_INSTRUMENTATION set to 0 and
+// to 1. When it is 0, instrument() must leave its input and the counters
+// untouched.
+namespace {
+
+constexpr bool enabled = flux::config::enable_instrumentation;
+
+// All of the operation and element counts are still zero
+constexpr bool is_untouched(flux::instrument_counters const& c)
+{
+    return c.first == 0 && c.is_last == 0 && c.read_at == 0 && c.move_at == 0 &&
+           c.inc == 0 && c.inc_by == 0 && c.dec == 0 && c.distance == 0 && c.size == 0 &&
+           c.last == 0 && c.for_each_while == 0 && c.elements == 0 && c.elapsed_ns == 0;
+}
+
+constexpr bool test_instrument()
+{
+    // Instrumented sequences keep the properties of the underlying sequence
+    {
+        flux::instrument_counters counters;
+        auto seq = flux::instrument(std::array{1, 2, 3, 4, 5}, counters);
+
+        using S = decltype(seq);
+
+        static_assert(enabled || std::same_as<S, std::array<int, 5>>);
+        static_assert(flux::contiguous_sequence<S>);
+        static_assert(flux::bounded_sequence<S>);
+        static_assert(flux::sized_sequence<S>);
+        static_assert(std::same_as<flux::element_t<S>, int&>);
+        static_assert(std::same_as<flux::value_t<S>, int>);
+
+        STATIC_CHECK(check_equal(seq, {1, 2, 3, 4, 5}));
+    }
+
+    // Cursor operations are counted
+    {
+        flux::instrument_counters counters;
+        auto seq = flux::instrument(std::array{1, 2, 3, 4, 5}, counters);
+
+        int sum = 0;
+        for (auto cur = flux::first(seq); !flux::is_last(seq, cur); flux::inc(seq, cur)) {
+            sum += flux::read_at(seq, cur);
+        }
+
+        STATIC_CHECK(sum == 15);
+        if constexpr (enabled) {
+            STATIC_CHECK(counters.first == 1);
+            STATIC_CHECK(counters.is_last == 6);
+            STATIC_CHECK(counters.read_at == 5);
+            STATIC_CHECK(counters.inc == 5);
+            STATIC_CHECK(counters.elements == 5);
+            STATIC_CHECK(counters.for_each_while == 0);
+        }
+
+        auto cur = flux::first(seq);
+        flux::inc(seq, cur, 3);
+        STATIC_CHECK(flux::distance(seq, flux::first(seq), cur) == 3);
+        STATIC_CHECK(flux::move_at(seq, cur) == 4);
+        STATIC_CHECK(flux::size(seq) == 5);
+        if constexpr (enabled) {
+            STATIC_CHECK(counters.inc_by == 1);
+            STATIC_CHECK(counters.distance == 1);
+            STATIC_CHECK(counters.move_at == 1);
+            STATIC_CHECK(counters.size == 1);
+        } else {
+            STATIC_CHECK(is_untouched(counters));
+        }
+    }
+
+    // Internal iteration is counted once, with each element passed through
+    {
+        flux::instrument_counters counters;
+        auto seq = flux::instrument(std::array{1, 2, 3, 4, 5}, counters);
+
+        STATIC_CHECK(flux::sum(seq) == 15);
+        if constexpr (enabled) {
+            STATIC_CHECK(counters.for_each_while == 1);
+            STATIC_CHECK(counters.elements == 5);
+            STATIC_CHECK(counters.read_at == 0);
+        }
+
+        // Early exit stops counting
+        STATIC_CHECK(flux::find(seq, 3) == 2);
+        if constexpr (enabled) {
+            STATIC_CHECK(counters.for_each_while == 2);
+            STATIC_CHECK(counters.elements == 8);
+        } else {
+            STATIC_CHECK(is_untouched(counters));
+        }
+    }
+
+    // Stages of a pipeline can be instrumented separately
+    {
+        flux::instrument_counters source{.name = "source"};
+        flux::instrument_counters filtered{.name = "filtered"};
+
+        auto total = flux::ints(0, 100)
+                         .instrument(source)
+                         .filter([](int i) { return i % 10 == 0; })
+                         .instrument(filtered)
+                         .map([](int i) { return i * 2; })
+                         .sum();
+
+        STATIC_CHECK(total == 900);
+        if constexpr (enabled) {
+            STATIC_CHECK(source.elements == 100);
+            STATIC_CHECK(filtered.elements == 10);
+        } else {
+            STATIC_CHECK(is_untouched(source));
+            STATIC_CHECK(is_untouched(filtered));
+        }
+
+        source.reset();
+        STATIC_CHECK(source.elements == 0);
+        STATIC_CHECK(std::string_view(source.name) == "source");
+    }
+
+    // Bidirectional sequences can still be reversed
+    {
+        flux::instrument_counters counters;
+        auto seq = flux::reverse(flux::instrument(std::array{1, 2, 3}, counters));
+
+        STATIC_CHECK(check_equal(seq, {3, 2, 1}));
+        if constexpr (enabled) {
+            STATIC_CHECK(counters.dec > 0);
+            STATIC_CHECK(counters.last > 0);
+        } else {
+            STATIC_CHECK(is_untouched(counters));
+        }
+    }
+
+    return true;
+}
+static_assert(test_instrument());
+
+}
+
+TEST_CASE("instrument")
+{
+    bool res = test_instrument();
+    REQUIRE(res);
+
+    SUBCASE("timing and reports")
+    {
+        flux::instrument_counters source{.name = "source", .timed = true};
+        flux::instrument_counters filtered{.name = "filtered", .timed = true};
+
+        auto vec = flux::ints(0, 1000).to<std::vector<int>>();
+
+        auto total = flux::ref(vec)
+                         .instrument(source)
+                         .filter([](int i) { return i % 100 == 0; })
+                         .instrument(filtered)
+                         .sum();
+
+        CHECK(total == 4500);
+
+        std::string report = flux::instrument_report(source, filtered);
+        CHECK(report.find("source") != std::string::npos);
+        CHECK(report.find("filtered") != std::string::npos);
+
+        if constexpr (enabled) {
+            CHECK(source.elements == 1000);
+            CHECK(filtered.elements == 10);
+            CHECK(report.find("1000") != std::string::npos);
+            CHECK(report.find("1.0%") != std::string::npos);
+        } else {
+            CHECK(is_untouched(source));
+            CHECK(is_untouched(filtered));
+        }
+    }
+}
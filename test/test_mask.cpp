@@ -54,6 +54,18 @@ constexpr bool test_mask()
         STATIC_CHECK(check_equal(flux::reverse(masked), {5, 3, 1}));
     }
 
+    // Internal iteration stops at the end when the last element is masked out
+    {
+        std::array values{1, 2, 3, 4, 5};
+        std::array mask{true, false, true, false, false};
+
+        auto masked = flux::mask(values, mask);
+
+        STATIC_CHECK(masked.sum() == 4);
+        STATIC_CHECK(masked.count() == 2);
+        STATIC_CHECK(flux::next(masked, masked.first(), 2) == masked.last());
+    }
+
     // mask with single-pass base sequence is single-pass
     {
         auto values = flux::scan(std::array{1, 2, 3, 4, 5}, std::plus{});
@@ -0,0 +1,202 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+constexpr auto collect = [](auto&& seq) {
+    std::vector<flux::value_t<decltype(seq)>> out;
+    FLUX_FOR(auto&& elem, FLUX_FWD(seq)) {
+        out.push_back(FLUX_FWD(elem));
+    }
+    return out;
+};
+
+constexpr bool test_merge()
+{
+    // Basic merge of several sequences
+    {
+        std::array arr1{1, 4, 7, 10};
+        std::array arr2{2, 5, 8};
+        std::array arr3{0, 3, 6, 9, 11, 12};
+
+        auto merged = flux::merge(flux::ref(arr1), flux::ref(arr2), flux::ref(arr3));
+
+        using M = decltype(merged);
+        static_assert(flux::sequence<M>);
+        static_assert(!flux::multipass_sequence<M>);
+        static_assert(!flux::sized_sequence<M>);
+        static_assert(std::same_as<flux::element_t<M>, int const&>);
+        static_assert(std::same_as<flux::value_t<M>, int>);
+
+        STATIC_CHECK(collect(std::move(merged)) ==
+                     std::vector{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    }
+
+    // Sequences of different types
+    {
+        std::array arr{1, 5, 9};
+        std::vector<long> vec{2, 3, 10};
+
+        auto merged = flux::merge(flux::ref(arr), flux::ints(4, 7), flux::ref(vec));
+
+        static_assert(std::same_as<flux::value_t<decltype(merged)>, flux::distance_t>);
+
+        STATIC_CHECK(collect(std::move(merged)) ==
+                     std::vector<flux::distance_t>{1, 2, 3, 4, 5, 5, 6, 9, 10});
+    }
+
+    // Empty sequences are fine
+    {
+        std::array arr{1, 2, 3};
+
+        auto merged = flux::merge(flux::empty<int>, flux::ref(arr), flux::empty<int>);
+        STATIC_CHECK(collect(std::move(merged)) == std::vector{1, 2, 3});
+
+        auto merged2 = flux::merge(flux::empty<int>, flux::empty<int>);
+        STATIC_CHECK(collect(std::move(merged2)).empty());
+    }
+
+    // Merging a single sequence returns it unchanged
+    {
+        std::array arr{1, 2, 3};
+        auto merged = flux::merge(flux::ref(arr));
+        static_assert(std::same_as<decltype(merged), decltype(flux::ref(arr))>);
+    }
+
+    // Calling first() again restarts the merge
+    {
+        std::array arr1{1, 3};
+        std::array arr2{2, 4};
+
+        auto merged = flux::merge(flux::ref(arr1), flux::ref(arr2));
+        STATIC_CHECK(merged.count() == 4);
+        STATIC_CHECK(merged.count() == 4);
+    }
+
+    return true;
+}
+static_assert(test_merge());
+
+constexpr bool test_merge_all()
+{
+    // Merge a sequence of references to sequences
+    {
+        std::vector<std::vector<int>> shards{{3, 6, 9}, {1, 2}, {}, {4, 5, 7, 8, 10}};
+
+        auto merged = flux::merge_all(flux::ref(shards));
+
+        using M = decltype(merged);
+        static_assert(!flux::multipass_sequence<M>);
+        static_assert(std::same_as<flux::element_t<M>, int const&>);
+
+        STATIC_CHECK(collect(std::move(merged)) == std::vector{1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    }
+
+    // Elements can be moved out of mutable sources
+    {
+        std::vector<std::vector<std::vector<int>>> shards{{{1}, {3}}, {{2}, {4}}};
+
+        auto merged = flux::merge_all(flux::mut_ref(shards));
+        static_assert(std::same_as<flux::rvalue_element_t<decltype(merged)>,
+                                   std::vector<int>&&>);
+
+        std::vector<std::vector<int>> out;
+        for (auto cur = flux::first(merged); !flux::is_last(merged, cur); flux::inc(merged, cur)) {
+            out.push_back(flux::move_at(merged, cur));
+        }
+        STATIC_CHECK(out == std::vector<std::vector<int>>{{1}, {2}, {3}, {4}});
+        STATIC_CHECK(shards[0][0].empty());
+    }
+
+    // Sources which are prvalue sequences are owned by the adaptor
+    {
+        auto merged = flux::merge_all(flux::ints(0, 3).map([](auto i) {
+            return flux::iota(i, flux::distance_t{6}).stride(3);
+        }));
+
+        STATIC_CHECK(collect(std::move(merged)) ==
+                     std::vector<flux::distance_t>{0, 1, 2, 3, 4, 5});
+    }
+
+    // Merging with a custom comparator is stable
+    {
+        using P = std::pair<int, char>;
+        std::vector<std::vector<P>> shards{
+            {{3, 'a'}, {2, 'a'}, {2, 'b'}, {1, 'a'}},
+            {{3, 'b'}, {2, 'c'}},
+            {{2, 'd'}, {0, 'a'}}
+        };
+
+        auto merged = flux::merge_all(flux::ref(shards),
+                                      flux::proj(flux::cmp::reverse_compare, &P::first));
+
+        STATIC_CHECK(collect(std::move(merged)) ==
+                     std::vector<P>{{3, 'a'}, {3, 'b'}, {2, 'a'}, {2, 'b'}, {2, 'c'},
+                                    {2, 'd'}, {1, 'a'}, {0, 'a'}});
+    }
+
+    // No sources at all
+    {
+        std::vector<std::vector<int>> shards;
+        STATIC_CHECK(flux::merge_all(flux::ref(shards)).count() == 0);
+    }
+
+    return true;
+}
+static_assert(test_merge_all());
+
+}
+
+TEST_CASE("merge")
+{
+    bool res = test_merge();
+    REQUIRE(res);
+}
+
+TEST_CASE("merge_all")
+{
+    bool res = test_merge_all();
+    REQUIRE(res);
+
+    SUBCASE("many random shards")
+    {
+        std::mt19937 gen{1234};
+        std::uniform_int_distribution<int> dist{0, 1000};
+
+        for (int n_shards : {1, 2, 3, 7, 16, 33}) {
+            std::vector<std::vector<int>> shards(static_cast<std::size_t>(n_shards));
+            std::vector<int> all;
+            for (auto& shard : shards) {
+                shard.resize(static_cast<std::size_t>(dist(gen)));
+                std::ranges::generate(shard, [&] { return dist(gen); });
+                std::ranges::sort(shard);
+                all.insert(all.end(), shard.begin(), shard.end());
+            }
+            std::ranges::sort(all);
+
+            int n_comparisons = 0;
+            auto counting_cmp = [&n_comparisons](int a, int b) {
+                ++n_comparisons;
+                return a <=> b;
+            };
+
+            auto merged = flux::merge_all(flux::ref(shards), counting_cmp);
+            CHECK(collect(std::move(merged)) == all);
+
+            // Each element needs at most ceil(log2(k)) comparisons, plus
+            // building the tree
+            auto log2_k = static_cast<int>(std::ceil(std::log2(n_shards)));
+            CHECK(n_comparisons <= static_cast<int>(all.size()) * log2_k + n_shards);
+        }
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+constexpr auto get_first = [](auto const& p) { return p.first; };
+
+constexpr bool test_merge_join()
+{
+    // Basic join with unique keys
+    {
+        std::array<std::pair<int, char>, 4> arr1{{{1, 'a'}, {2, 'b'}, {4, 'c'}, {5, 'd'}}};
+        std::array<std::pair<int, char>, 3> arr2{{{2, 'x'}, {3, 'y'}, {5, 'z'}}};
+
+        auto joined = flux::merge_join(flux::ref(arr1), flux::ref(arr2), get_first, get_first);
+
+        using J = decltype(joined);
+        static_assert(flux::multipass_sequence<J>);
+        static_assert(!flux::bounded_sequence<J>);
+        static_assert(!flux::sized_sequence<J>);
+        static_assert(std::same_as<flux::element_t<J>,
+                                   std::pair<std::pair<int, char> const&,
+                                             std::pair<int, char> const&>>);
+        static_assert(std::same_as<flux::value_t<J>,
+                                   std::pair<std::pair<int, char>, std::pair<int, char>>>);
+
+        auto chars = flux::ref(joined).map([](auto p) {
+            return std::pair(p.first.second, p.second.second);
+        });
+        STATIC_CHECK(check_equal(chars, {std::pair('b', 'x'), std::pair('d', 'z')}));
+    }
+
+    // Duplicate keys on both sides produce the cross product of each run
+    {
+        std::array<std::pair<int, int>, 5> arr1{{{1, 10}, {1, 11}, {2, 20}, {3, 30}, {3, 31}}};
+        std::array<std::pair<int, int>, 5> arr2{{{1, 100}, {1, 101}, {3, 300}, {3, 301}, {3, 302}}};
+
+        auto joined = flux::merge_join(flux::ref(arr1), flux::ref(arr2), get_first, get_first);
+
+        auto vals = flux::ref(joined).map([](auto p) {
+            return std::pair(p.first.second, p.second.second);
+        });
+
+        STATIC_CHECK(check_equal(vals, {std::pair(10, 100), std::pair(10, 101),
+                                        std::pair(11, 100), std::pair(11, 101),
+                                        std::pair(30, 300), std::pair(30, 301), std::pair(30, 302),
+                                        std::pair(31, 300), std::pair(31, 301), std::pair(31, 302)}));
+
+        STATIC_CHECK(flux::count(joined) == 10);
+    }
+
+    // Different key types on each side
+    {
+        std::array arr1{1, 3, 5, 7};
+        std::array<std::pair<long, char>, 3> arr2{{{3, 'x'}, {4, 'y'}, {7, 'z'}}};
+
+        auto joined = flux::merge_join(flux::ref(arr1), flux::ref(arr2),
+                                       std::identity{}, get_first);
+
+        auto seconds = flux::ref(joined).map([](auto p) { return p.second.second; });
+        STATIC_CHECK(check_equal(seconds, {'x', 'z'}));
+    }
+
+    // Custom comparator, for inputs sorted in descending order
+    {
+        std::array arr1{5, 4, 3, 1};
+        std::array arr2{6, 4, 4, 1, 0};
+
+        auto joined = flux::merge_join(flux::ref(arr1), flux::ref(arr2), std::identity{},
+                                       std::identity{}, flux::cmp::reverse_compare);
+
+        auto firsts = flux::ref(joined).map([](auto p) { return p.first; });
+        STATIC_CHECK(check_equal(firsts, {4, 4, 1}));
+    }
+
+    // Empty and disjoint inputs
+    {
+        std::array arr1{1, 2, 3};
+        std::array arr2{4, 5, 6};
+
+        STATIC_CHECK(flux::merge_join(flux::ref(arr1), flux::ref(arr2),
+                                      std::identity{}, std::identity{}).is_empty());
+        STATIC_CHECK(flux::merge_join(flux::ref(arr1), flux::empty<int>,
+                                      std::identity{}, std::identity{}).is_empty());
+        STATIC_CHECK(flux::merge_join(flux::empty<int>, flux::ref(arr2),
+                                      std::identity{}, std::identity{}).is_empty());
+    }
+
+    // Single-pass first sequence
+    {
+        std::array arr1{1, 2, 2, 3};
+        std::array arr2{2, 2, 3};
+
+        auto joined = flux::merge_join(single_pass_only(flux::ref(arr1)), flux::ref(arr2),
+                                       std::identity{}, std::identity{});
+
+        static_assert(!flux::multipass_sequence<decltype(joined)>);
+
+        STATIC_CHECK(flux::count(std::move(joined)) == 5);
+    }
+
+    return true;
+}
+static_assert(test_merge_join());
+
+}
+
+TEST_CASE("merge_join")
+{
+    bool res = test_merge_join();
+    REQUIRE(res);
+
+    SUBCASE("skewed inputs")
+    {
+        // Keys 0, 0, 1, 1, 2, 2, ...
+        std::vector<int> big;
+        for (int i = 0; i < 100'000; i++) {
+            big.push_back(i / 2);
+        }
+        std::vector<int> small{7, 7, 20'000, 49'999};
+
+        int n_comparisons = 0;
+        auto counting_cmp = [&n_comparisons](int a, int b) {
+            ++n_comparisons;
+            return a <=> b;
+        };
+
+        auto joined = flux::merge_join(flux::ref(small), flux::ref(big), std::identity{},
+                                       std::identity{}, counting_cmp);
+
+        std::vector<std::pair<int, int>> out;
+        for (auto [a, b] : joined) {
+            out.emplace_back(a, b);
+        }
+
+        CHECK(out == std::vector<std::pair<int, int>>{{7, 7}, {7, 7}, {7, 7}, {7, 7},
+                                                      {20'000, 20'000}, {20'000, 20'000},
+                                                      {49'999, 49'999}, {49'999, 49'999}});
+        CHECK(n_comparisons < 1000);
+    }
+}
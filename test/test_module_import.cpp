@@ -1,10 +1,13 @@
-
 // Copyright (c) 2023 Tristan Brindle (tcbrindle at gmail dot com)
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <flux/macros.hpp>
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 import flux;
 
 int main()
@@ -12,4 +15,21 @@ int main()
     FLUX_ASSERT(1 != 2);
     constexpr int arr[] = {1, 2, 3, 4, 5};
     static_assert(flux::sum(arr) == 15);
+
+    // These use the module's explicit instantiations
+    std::vector<int> ints{3, 1, 2};
+    flux::sort(ints);
+    FLUX_ASSERT(ints == (std::vector<int>{1, 2, 3}));
+    FLUX_ASSERT(flux::sum(ints) == 6);
+
+    std::vector<double> doubles{3.0, 1.0, 2.0};
+    flux::sort(doubles, flux::cmp::compare_floating_point_unchecked);
+    FLUX_ASSERT(doubles.front() == 1.0);
+
+    std::vector<std::string> strings{"c", "a", "b"};
+    flux::sort(strings);
+    FLUX_ASSERT(strings.front() == "a");
+
+    std::string_view text = "abc\ndef";
+    FLUX_ASSERT(flux::find(text, '\n') == 3);
 }
@@ -3,6 +3,10 @@
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
 #include <optional> // std::nullopt
 #include <utility> // std::as_const
 
@@ -1184,6 +1188,115 @@ constexpr bool test_optional_map()
 }
 static_assert(test_optional_map());
 
+// A user-defined type which supplies its own niche
+struct handle {
+    int fd = -1;
+
+    friend constexpr bool operator==(handle, handle) = default;
+};
+
+}
+
+template <>
+struct flux::optional_niche<handle> {
+    static constexpr auto null_value() noexcept -> handle { return handle{-2}; }
+    static constexpr auto is_null(handle const& h) noexcept -> bool { return h.fd == -2; }
+};
+
+namespace {
+
+static_assert(sizeof(flux::optional<handle>) == sizeof(handle));
+static_assert(sizeof(flux::optional<int*>) > sizeof(int*));
+static_assert(sizeof(flux::optional<int&>) == sizeof(int*));
+
+// The cursor of flux::single() has spare values, which flux uses as a niche
+using single_cursor = flux::cursor_t<decltype(flux::single(1))>;
+static_assert(sizeof(flux::optional<single_cursor>) == sizeof(single_cursor));
+
+// Every value of a fundamental type can be stored, so they have no niche
+static_assert(sizeof(flux::optional<flux::index_t>) > sizeof(flux::index_t));
+static_assert(sizeof(flux::optional<double>) > sizeof(double));
+static_assert(sizeof(flux::optional<float>) > sizeof(float));
+
+template <typename T>
+constexpr bool test_optional_niche_impl(T val, T other)
+{
+    {
+        flux::optional<T> o;
+        STATIC_CHECK(!o.has_value());
+        STATIC_CHECK(o == flux::nullopt);
+    }
+
+    {
+        flux::optional<T> o(val);
+        STATIC_CHECK(o.has_value());
+        STATIC_CHECK(*o == val);
+
+        auto copy = o;
+        STATIC_CHECK(copy.has_value());
+        STATIC_CHECK(*copy == val);
+
+        o.reset();
+        STATIC_CHECK(!o.has_value());
+
+        copy = o;
+        STATIC_CHECK(!copy.has_value());
+
+        o.emplace(other);
+        STATIC_CHECK(o.has_value());
+        STATIC_CHECK(*o == other);
+
+        flux::optional<T> moved(std::move(o));
+        STATIC_CHECK(moved.has_value());
+        STATIC_CHECK(*moved == other);
+
+        moved = flux::nullopt;
+        STATIC_CHECK(!moved.has_value());
+        STATIC_CHECK(moved.value_or(val) == val);
+    }
+
+    return true;
+}
+
+constexpr bool test_optional_niche()
+{
+    STATIC_CHECK(test_optional_niche_impl<handle>(handle{-1}, handle{3}));
+    {
+        auto single = flux::single(1);
+        STATIC_CHECK(test_optional_niche_impl<single_cursor>(flux::first(single),
+                                                             flux::last(single)));
+    }
+
+    // Extreme values and NaNs of fundamental types are ordinary values
+    {
+        constexpr auto min = std::numeric_limits<flux::index_t>::min();
+        STATIC_CHECK(test_optional_niche_impl<flux::index_t>(min, 0));
+
+        // A NaN with a payload that is never produced by arithmetic
+        constexpr auto nan_bits = std::uint64_t{0x7FF8'F1D0'F1D0'F1D0};
+        flux::optional<double> d(std::bit_cast<double>(nan_bits));
+        STATIC_CHECK(d.has_value());
+        STATIC_CHECK(std::bit_cast<std::uint64_t>(*d) == nan_bits);
+
+        constexpr auto nanf_bits = std::uint32_t{0x7FC0'F1D0};
+        flux::optional<float> f(std::bit_cast<float>(nanf_bits));
+        STATIC_CHECK(f.has_value());
+        STATIC_CHECK(std::bit_cast<std::uint32_t>(*f) == nanf_bits);
+
+        std::array<flux::index_t, 2> arr{min, 3};
+        STATIC_CHECK(flux::min(arr).value() == min);
+        STATIC_CHECK(flux::max(arr).value() == 3);
+        STATIC_CHECK(flux::fold_first(arr, [](auto a, auto) { return a; }).value() == min);
+        STATIC_CHECK(flux::read_at(arr, flux::find_min(arr)) == min);
+        STATIC_CHECK(check_equal(flux::filter_map(arr, [](flux::index_t i) {
+            return flux::optional<flux::index_t>(i);
+        }), {min, flux::index_t{3}}));
+    }
+
+    return true;
+}
+static_assert(test_optional_niche());
+
 }
 
 TEST_CASE("optional")
@@ -1223,4 +1336,12 @@ TEST_CASE("optional")
     REQUIRE(test_optional_reset());
 
     REQUIRE(test_optional_map());
+
+    REQUIRE(test_optional_niche());
+
+    SUBCASE("storing the niche value is an error")
+    {
+        flux::optional<handle> o;
+        REQUIRE_THROWS_AS(o.emplace(handle{-2}), flux::unrecoverable_error);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <flux/parallel_for_each.hpp>
+
+#include "test_utils.hpp"
+
+namespace {
+
+// Counts how many times each point of a product of ints() is visited
+template <typename Seq>
+auto visit_counts(Seq const& seq, std::size_t n_threads, auto flatten) -> std::vector<int>
+{
+    std::vector<std::atomic<int>> counts(static_cast<std::size_t>(flux::size(seq)));
+    flux::parallel_for_each(seq, [&](auto elem) {
+        ++counts[static_cast<std::size_t>(flatten(elem))];
+    }, n_threads);
+
+    std::vector<int> out;
+    for (auto& c : counts) {
+        out.push_back(c.load());
+    }
+    return out;
+}
+
+}
+
+TEST_CASE("parallel_for_each")
+{
+    SUBCASE("every point of a cartesian_product is visited once")
+    {
+        // With 7 x 5 x 3 points, most blocks start and end part way
+        // through a row
+        auto seq = flux::cartesian_product(flux::ints(0, 7), flux::ints(0, 5), flux::ints(0, 3));
+        auto flatten = flux::unpack([](auto i, auto j, auto k) { return (i * 5 + j) * 3 + k; });
+
+        for (std::size_t n : {1u, 2u, 3u, 4u, 8u, 13u, 105u, 500u}) {
+            CHECK(visit_counts(seq, n, flatten) == std::vector<int>(105, 1));
+        }
+    }
+
+    SUBCASE("every point of a cartesian_power is visited once")
+    {
+        auto seq = flux::cartesian_power<2>(flux::ints(0, 10));
+        auto flatten = flux::unpack([](auto i, auto j) { return i * 10 + j; });
+
+        for (std::size_t n : {1u, 3u, 7u, 64u}) {
+            CHECK(visit_counts(seq, n, flatten) == std::vector<int>(100, 1));
+        }
+    }
+
+    SUBCASE("cartesian_product_map")
+    {
+        std::vector<int> xs(37);
+        std::vector<int> ys(41);
+        std::iota(xs.begin(), xs.end(), 1);
+        std::iota(ys.begin(), ys.end(), -20);
+
+        auto seq = flux::cartesian_product_map(std::multiplies{}, flux::ref(xs), flux::ref(ys));
+        long const expected = flux::fold(seq, std::plus<long>{}, 0L);
+
+        for (std::size_t n : {1u, 2u, 5u, 16u}) {
+            std::atomic<long> sum{0};
+            flux::parallel_for_each(seq, [&](int x) { sum += x; }, n);
+            CHECK(sum.load() == expected);
+        }
+    }
+
+    SUBCASE("cartesian_power_map")
+    {
+        auto seq = flux::cartesian_power_map<3>(flux::ints(0, 6),
+                                                [](auto i, auto j, auto k) { return i * j + k; });
+        long const expected = flux::fold(seq, std::plus<long>{}, 0L);
+
+        std::atomic<long> sum{0};
+        flux::parallel_for_each(seq, [&](auto x) { sum += x; }, 4);
+        CHECK(sum.load() == expected);
+    }
+
+    SUBCASE("empty products make no calls")
+    {
+        std::atomic<int> calls{0};
+        flux::parallel_for_each(
+            flux::cartesian_product(flux::ints(0, 4), flux::ints(0, 0), flux::ints(0, 4)),
+            [&](auto) { ++calls; }, 4);
+        flux::parallel_for_each(std::vector<int>{}, [&](auto) { ++calls; }, 4);
+        CHECK(calls.load() == 0);
+    }
+
+    SUBCASE("other random-access sequences")
+    {
+        std::vector<int> vec(1000);
+        std::iota(vec.begin(), vec.end(), 0);
+
+        std::vector<std::atomic<int>> counts(vec.size());
+        flux::parallel_for_each(flux::ref(vec).reverse(), [&](int i) {
+            ++counts[static_cast<std::size_t>(i)];
+        }, 6);
+        CHECK(flux::all(counts, [](auto const& c) { return c.load() == 1; }));
+
+        std::atomic<long> sum{0};
+        flux::parallel_for_each(flux::ints(0, 1000).stride(3), [&](auto i) { sum += i; }, 3);
+        CHECK(sum.load() == flux::ints(0, 1000).stride(3).sum());
+    }
+
+    SUBCASE("blocks of cartesian products are walked row by row")
+    {
+        auto seq = flux::cartesian_product(flux::ints(0, 3), flux::ints(0, 4));
+        auto always = [](auto&&) { return true; };
+
+        // parallel_for_each() iterates a const sequence
+        static_assert(flux::detail::has_for_each_while_n<decltype(seq) const, decltype(always)>);
+
+        using traits = flux::detail::traits_t<decltype(seq)>;
+        auto const& cseq = seq;
+
+        std::vector<std::tuple<flux::distance_t, flux::distance_t>> visited;
+        traits::for_each_while_n(cseq, flux::next(cseq, flux::first(cseq), 3), 6,
+                                 [&](auto elem) { visited.push_back(elem); return true; });
+        CHECK(visited == std::vector<std::tuple<flux::distance_t, flux::distance_t>>{
+                             {0, 3}, {1, 0}, {1, 1}, {1, 2}, {1, 3}, {2, 0}});
+
+        if constexpr (flux::config::enable_debug_asserts) {
+            // Asking for more elements than remain is an error
+            CHECK_THROWS_AS(traits::for_each_while_n(cseq, flux::next(cseq, flux::first(cseq), 10),
+                                                     3, always),
+                            flux::unrecoverable_error);
+
+            auto single = flux::cartesian_product(flux::ints(0, 5));
+            using single_traits = flux::detail::traits_t<decltype(single)>;
+            CHECK_THROWS_AS(single_traits::for_each_while_n(single, flux::first(single), 6, always),
+                            flux::unrecoverable_error);
+        }
+    }
+
+    SUBCASE("exceptions are rethrown on the calling thread")
+    {
+        std::atomic<int> calls{0};
+        auto seq = flux::cartesian_product(flux::ints(0, 10), flux::ints(0, 10));
+
+        CHECK_THROWS_AS(flux::parallel_for_each(seq, flux::unpack([&](auto i, auto j) {
+            ++calls;
+            if (i == 2 && j == 3) {
+                throw std::runtime_error("oops");
+            }
+        }), 4), std::runtime_error);
+
+        // Blocks without the throwing element run to completion
+        CHECK(calls.load() >= 75);
+    }
+}
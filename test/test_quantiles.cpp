@@ -0,0 +1,138 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+constexpr bool test_quantiles()
+{
+    // While the sketch has room, it holds every value and is exact
+    {
+        auto sketch = flux::quantiles(flux::ints(1, 101), 0.01);
+
+        static_assert(std::same_as<decltype(sketch), flux::quantile_sketch<flux::distance_t>>);
+
+        STATIC_CHECK(sketch.count() == 100);
+        STATIC_CHECK(sketch.num_retained() == 100);
+        STATIC_CHECK(sketch.quantile(0.0) == 1);
+        STATIC_CHECK(sketch.quantile(0.5) == 50);
+        STATIC_CHECK(sketch.quantile(1.0) == 100);
+        STATIC_CHECK(sketch.rank(25) == 0.25);
+        STATIC_CHECK(sketch.rank(0) == 0.0);
+        STATIC_CHECK(sketch.rank(1000) == 1.0);
+        STATIC_CHECK(sketch.quantiles({0.1, 0.9}) == std::vector<flux::distance_t>{10, 90});
+    }
+
+    // Memory stays bounded as values are added
+    {
+        auto sketch = flux::quantiles(flux::ints(0, 2000).map([](auto i) {
+            return (i * 7919) % 2000;
+        }), 0.05);
+
+        STATIC_CHECK(sketch.count() == 2000);
+        STATIC_CHECK(sketch.num_retained() < 250);
+
+        auto median = sketch.quantile(0.5);
+        STATIC_CHECK(median > 900 && median < 1100);
+    }
+
+    // Empty sequence
+    {
+        auto sketch = flux::quantiles(flux::empty<int>, 0.01);
+        STATIC_CHECK(sketch.is_empty());
+        STATIC_CHECK(sketch.rank(0) == 0.0);
+    }
+
+    return true;
+}
+static_assert(test_quantiles());
+
+}
+
+TEST_CASE("quantiles")
+{
+    bool res = test_quantiles();
+    REQUIRE(res);
+
+    SUBCASE("rank error is within epsilon")
+    {
+        std::mt19937 gen{99};
+        std::exponential_distribution<double> dist{1.0};
+
+        std::vector<double> values(200'000);
+        for (double& d : values) {
+            d = dist(gen);
+        }
+
+        double const eps = 0.01;
+        auto sketch = flux::quantiles(flux::ref(values), eps);
+        CHECK(sketch.num_retained() < 2000);
+
+        std::ranges::sort(values);
+        for (double q : {0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999}) {
+            double const estimate = sketch.quantile(q);
+            auto const true_rank =
+                static_cast<double>(std::ranges::upper_bound(values, estimate) - values.begin()) /
+                static_cast<double>(values.size());
+            CHECK(std::abs(true_rank - q) <= eps);
+        }
+    }
+
+    SUBCASE("merged sketches are as accurate as a single sketch")
+    {
+        std::mt19937 gen{7};
+        std::uniform_int_distribution<int> dist{0, 1'000'000};
+
+        std::vector<int> all;
+        auto merged = flux::quantile_sketch<int>(flux::quantile_sketch<int>::k_for_epsilon(0.01));
+
+        // Eight "partitions" of different sizes, summarised separately
+        for (int p = 0; p < 8; p++) {
+            std::vector<int> part(static_cast<std::size_t>(10'000 * (p + 1)));
+            for (int& i : part) {
+                i = dist(gen);
+            }
+            merged.merge(flux::quantiles(flux::ref(part), 0.01));
+            all.insert(all.end(), part.begin(), part.end());
+        }
+
+        CHECK(merged.count() == all.size());
+        CHECK(merged.num_retained() < 2000);
+
+        std::ranges::sort(all);
+        auto const estimates = merged.quantiles({0.05, 0.25, 0.5, 0.75, 0.95});
+        for (std::size_t i = 0; i < estimates.size(); i++) {
+            double const q = std::array{0.05, 0.25, 0.5, 0.75, 0.95}[i];
+            auto const true_rank =
+                static_cast<double>(std::ranges::upper_bound(all, estimates[i]) - all.begin()) /
+                static_cast<double>(all.size());
+            CHECK(std::abs(true_rank - q) <= 0.01);
+        }
+    }
+
+    SUBCASE("single-pass input")
+    {
+        std::istringstream iss("5 3 9 1 7");
+        auto sketch = flux::quantiles(flux::from_istream<int>(iss), 0.1);
+        CHECK(sketch.quantile(0.5) == 5);
+    }
+
+    SUBCASE("invalid arguments")
+    {
+        CHECK_THROWS_AS((void) flux::quantiles(flux::empty<int>, 0.0), flux::unrecoverable_error);
+
+        auto sketch = flux::quantiles(flux::empty<int>, 0.1);
+        CHECK_THROWS_AS((void) sketch.quantile(0.5), flux::unrecoverable_error);
+
+        sketch.add(1);
+        CHECK_THROWS_AS((void) sketch.quantile(1.5), flux::unrecoverable_error);
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <flux/read_ahead.hpp>
+
+#include "test_utils.hpp"
+
+namespace {
+
+struct temp_file {
+    std::string path;
+
+    explicit temp_file(std::string const& contents)
+    {
+        // A random name, so that concurrent test runs don't share files
+        std::random_device rd;
+        std::mt19937_64 gen((std::uint64_t{rd()} << 32) | rd());
+        path = (std::filesystem::temp_directory_path() /
+                ("flux_read_ahead_test_" + std::to_string(gen()))).string();
+
+        std::ofstream out(path, std::ios::binary);
+        out << contents;
+    }
+
+    ~temp_file() { std::remove(path.c_str()); }
+};
+
+auto make_contents(std::size_t size) -> std::string
+{
+    std::string str(size, '\0');
+    for (std::size_t i = 0; i < size; i++) {
+        str[i] = static_cast<char>('a' + (i % 26));
+    }
+    return str;
+}
+
+}
+
+TEST_CASE("read_ahead")
+{
+    using seq_t = decltype(flux::read_ahead(""));
+
+    static_assert(flux::sequence<seq_t>);
+    static_assert(!flux::multipass_sequence<seq_t>);
+    static_assert(std::same_as<flux::element_t<seq_t>, flux::array_ptr<char const>>);
+
+    SUBCASE("blocks are handed out in order")
+    {
+        auto const contents = make_contents(10'000);
+        temp_file file(contents);
+
+        for (flux::distance_t block_size : {1, 7, 100, 4096, 10'000, 20'000}) {
+            for (flux::distance_t depth : {1, 2, 3, 5}) {
+                auto seq = flux::read_ahead(file.path, {.block_size = block_size,
+                                                        .queue_depth = depth});
+
+                std::string out;
+                flux::distance_t n_blocks = 0;
+                FLUX_FOR(auto block, seq) {
+                    REQUIRE(block.size() <= block_size);
+                    REQUIRE(block.size() > 0);
+                    out.append(block.data(), block.usize());
+                    ++n_blocks;
+                }
+
+                REQUIRE(out == contents);
+                REQUIRE(n_blocks == (10'000 + block_size - 1) / block_size);
+                REQUIRE_FALSE(seq.has_error());
+            }
+        }
+    }
+
+    SUBCASE("can be flattened into a sequence of chars")
+    {
+        auto const contents = make_contents(1234);
+        temp_file file(contents);
+
+        auto str = flux::read_ahead(file.path, {.block_size = 100})
+                       .flatten()
+                       .to<std::string>();
+
+        REQUIRE(str == contents);
+    }
+
+    SUBCASE("empty file")
+    {
+        temp_file file("");
+
+        auto seq = flux::read_ahead(file.path);
+
+        auto cur = seq.first();
+        REQUIRE(seq.is_last(cur));
+        REQUIRE_FALSE(seq.has_error());
+    }
+
+    SUBCASE("missing file yields empty sequence")
+    {
+        auto seq = flux::read_ahead("/this/path/does/not/exist/flux.txt");
+
+        auto cur = seq.first();
+        REQUIRE(seq.is_last(cur));
+        REQUIRE(seq.has_error());
+
+        // Make sure assertion fires
+        REQUIRE_THROWS_AS(seq.inc(cur), flux::unrecoverable_error);
+    }
+
+    SUBCASE("early exit stops the reader")
+    {
+        auto const contents = make_contents(100'000);
+        temp_file file(contents);
+
+        auto seq = flux::read_ahead(file.path, {.block_size = 16, .queue_depth = 2});
+        auto cur = seq.first();
+        REQUIRE(std::string(seq[cur].data(), seq[cur].usize()) == contents.substr(0, 16));
+        // Destructor must not deadlock while the reader is waiting for a slot
+    }
+}
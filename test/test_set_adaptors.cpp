@@ -3,7 +3,10 @@
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
 #include <array>
+#include <iterator>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -607,10 +610,80 @@ constexpr bool test_set_intersection()
     return true;
 }
 
+// Heavily skewed random-access inputs take the galloping path
+constexpr bool test_set_galloping()
+{
+    std::vector<int> big;
+    for (int i = 0; i < 2000; i++) {
+        big.push_back(i / 2);
+    }
+    std::vector<int> small{-5, 3, 3, 3, 250, 251, 600, 998, 999, 999, 1500};
+
+    auto iterate = [](auto&& seq) {
+        std::vector<int> out;
+        for (int i : seq) {
+            out.push_back(i);
+        }
+        return out;
+    };
+
+    auto collect = [](auto&& seq) {
+        std::vector<int> out;
+        flux::for_each(seq, [&out](int i) { out.push_back(i); });
+        return out;
+    };
+
+    // intersection, with either side the larger
+    {
+        std::vector<int> expected;
+        std::ranges::set_intersection(small, big, std::back_inserter(expected));
+
+        auto inter1 = flux::set_intersection(flux::ref(small), flux::ref(big));
+        STATIC_CHECK(iterate(inter1) == expected);
+        STATIC_CHECK(collect(inter1) == expected);
+
+        std::vector<int> expected2;
+        std::ranges::set_intersection(big, small, std::back_inserter(expected2));
+
+        auto inter2 = flux::set_intersection(flux::ref(big), flux::ref(small));
+        STATIC_CHECK(iterate(inter2) == expected2);
+        STATIC_CHECK(collect(inter2) == expected2);
+
+        // Stopping internal iteration part way through
+        auto cur = flux::find(inter2, 250);
+        STATIC_CHECK(inter2[cur] == 250);
+        inter2.inc(cur);
+        STATIC_CHECK(inter2[cur] == 251);
+    }
+
+    // difference, with a large second sequence
+    {
+        std::vector<int> expected;
+        std::ranges::set_difference(small, big, std::back_inserter(expected));
+
+        auto diff = flux::set_difference(flux::ref(small), flux::ref(big));
+        STATIC_CHECK(iterate(diff) == expected);
+        STATIC_CHECK(collect(diff) == expected);
+    }
+
+    // single-pass inputs still work, without galloping
+    {
+        std::vector<int> expected;
+        std::ranges::set_intersection(small, big, std::back_inserter(expected));
+
+        auto inter = flux::set_intersection(single_pass_only(flux::ref(small)),
+                                            single_pass_only(flux::ref(big)));
+        STATIC_CHECK(collect(inter) == expected);
+    }
+
+    return true;
+}
+
 static_assert(test_set_union());
 static_assert(test_set_difference());
 static_assert(test_set_symmetric_difference());
 static_assert(test_set_intersection());
+static_assert(test_set_galloping());
 
 // https://github.com/tcbrindle/flux/issues/228
 constexpr bool issue_228()
@@ -660,3 +733,31 @@ TEST_CASE("set_intersection")
     bool result = test_set_intersection();
     REQUIRE(result);
 }
+
+TEST_CASE("set adaptors with galloping")
+{
+    bool result = test_set_galloping();
+    REQUIRE(result);
+
+    SUBCASE("galloping needs far fewer comparisons than a linear merge")
+    {
+        std::vector<int> big(100'000);
+        std::iota(big.begin(), big.end(), 0);
+        std::vector<int> small{10, 20'000, 50'000, 99'999};
+
+        int n_comparisons = 0;
+        auto counting_cmp = [&n_comparisons](int a, int b) {
+            ++n_comparisons;
+            return a <=> b;
+        };
+
+        auto inter = flux::set_intersection(flux::ref(small), flux::ref(big), counting_cmp);
+        CHECK(check_equal(inter, small));
+        CHECK(n_comparisons < 1000);
+
+        n_comparisons = 0;
+        auto diff = flux::set_difference(flux::ref(small), flux::ref(big), counting_cmp);
+        CHECK(diff.is_empty());
+        CHECK(n_comparisons < 1000);
+    }
+}
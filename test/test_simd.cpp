@@ -0,0 +1,111 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This file is built once for each SIMD level, with FLUX_MAX_SIMD_LEVEL set
+// to force the kernels for that level to be used, so that every variant is
+// tested on any machine which supports it.
+
+#include "test_utils.hpp"
+
+#include <flux/algorithm/detail/simd.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+namespace simd = flux::detail::simd;
+
+template <typename T>
+void test_kernels(std::mt19937& gen)
+{
+    // Values from a small range, so that there are plenty of matches. For
+    // unsigned types the negative values wrap, giving large values too.
+    std::uniform_int_distribution<int> dist(-3, 3);
+    std::uniform_int_distribution<int> coin(0, 15);
+
+    for (std::size_t size = 0; size <= 300; ++size) {
+        // Start one element in, so that the loads are not aligned
+        std::vector<T> storage(size + 1);
+        T* const data = storage.data() + 1;
+        for (std::size_t i = 0; i < size; ++i) {
+            // Occasionally use the extreme values, to check that the
+            // comparisons use the right signedness
+            int const c = coin(gen);
+            data[i] = c == 0 ? std::numeric_limits<T>::min()
+                    : c == 1 ? std::numeric_limits<T>::max()
+                             : static_cast<T>(dist(gen));
+        }
+        auto const seq = std::span<T const>(data, size);
+
+        for (int n = -4; n <= 4; ++n) {
+            auto const needle = static_cast<T>(n);
+
+            auto const expected_pos = static_cast<std::size_t>(
+                std::find(seq.begin(), seq.end(), needle) - seq.begin());
+            CHECK(simd::find(data, size, needle) == expected_pos);
+            CHECK(flux::find(seq, needle) == static_cast<flux::index_t>(expected_pos));
+
+            auto const expected_count = std::count(seq.begin(), seq.end(), needle);
+            CHECK(simd::count(data, size, needle) == static_cast<std::size_t>(expected_count));
+            CHECK(flux::count_eq(seq, needle) == expected_count);
+        }
+
+        if (size == 0) {
+            CHECK(!flux::minmax(seq).has_value());
+            continue;
+        }
+
+        auto const [lo, hi] = std::minmax_element(seq.begin(), seq.end());
+        auto const mm = simd::minmax(data, size);
+        CHECK(mm.min == *lo);
+        CHECK(mm.max == *hi);
+        CHECK(flux::min(seq).value() == *lo);
+        CHECK(flux::max(seq).value() == *hi);
+        CHECK(flux::minmax(seq).value().min == *lo);
+        CHECK(flux::minmax(seq).value().max == *hi);
+    }
+}
+
+// Counting bytes must not overflow the per-lane counters
+void test_long_count()
+{
+    std::vector<unsigned char> bytes(100'000, 7);
+    bytes[12'345] = 8;
+    CHECK(simd::count(bytes.data(), bytes.size(), 7) == bytes.size() - 1);
+    CHECK(simd::find(bytes.data(), bytes.size(), 8) == 12'345);
+}
+
+}
+
+TEST_CASE("simd kernels")
+{
+    auto const forced = flux::config::max_simd_level;
+    auto const detected = simd::detect_level();
+
+    if (detected < forced) {
+        std::printf("SIMD level not supported by this CPU\n");
+        return;
+    }
+
+    REQUIRE(simd::active_level() == forced);
+
+    std::mt19937 gen(1234);
+    test_kernels<char>(gen);
+    test_kernels<signed char>(gen);
+    test_kernels<unsigned char>(gen);
+    test_kernels<char8_t>(gen);
+    test_kernels<short>(gen);
+    test_kernels<unsigned short>(gen);
+    test_kernels<int>(gen);
+    test_kernels<unsigned int>(gen);
+    test_kernels<wchar_t>(gen);
+    test_kernels<long long>(gen);
+    test_kernels<unsigned long long>(gen);
+    test_long_count();
+}
@@ -0,0 +1,174 @@
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+using flux::soa_vector;
+
+using records_t = soa_vector<int, double, std::string>;
+
+auto make_records() -> records_t
+{
+    return records_t{
+        {3, 0.5, "charlie"},
+        {1, 1.5, "alpha"},
+        {4, 2.5, "delta"},
+        {2, 3.5, "bravo"},
+    };
+}
+
+constexpr auto get_key = [](auto const& row) -> int { return std::get<0>(row); };
+
+}
+
+TEST_CASE("soa_vector")
+{
+    SUBCASE("sequence concepts")
+    {
+        using S = soa_vector<int, double>;
+
+        static_assert(flux::random_access_sequence<S>);
+        static_assert(flux::sized_sequence<S>);
+        static_assert(flux::bounded_sequence<S>);
+        static_assert(!flux::contiguous_sequence<S>);
+        static_assert(std::same_as<flux::element_t<S>, std::pair<int&, double&>>);
+        static_assert(std::same_as<flux::element_t<S const>, std::pair<int const&, double const&>>);
+        static_assert(std::same_as<flux::value_t<S>, std::pair<int, double>>);
+
+        using T = soa_vector<int, double, char>;
+        static_assert(std::same_as<flux::element_t<T>, std::tuple<int&, double&, char&>>);
+
+        static_assert(flux::contiguous_sequence<decltype(std::declval<S&>().column<0>())>);
+        static_assert(std::same_as<flux::element_t<decltype(std::declval<S const&>().column<1>())>,
+                                   double const&>);
+    }
+
+    SUBCASE("construction and modification")
+    {
+        records_t recs;
+        CHECK(recs.is_empty());
+        CHECK(recs.size() == 0);
+
+        recs.push_back({1, 1.0, "one"});
+        recs.emplace_back(2, 2.0, "two");
+        std::tuple<int, double, std::string> row{3, 3.0, "three"};
+        recs.push_back(row);
+
+        CHECK(recs.size() == 3);
+        CHECK(check_equal(recs.column<0>(), {1, 2, 3}));
+        CHECK(check_equal(recs.column<1>(), {1.0, 2.0, 3.0}));
+        CHECK(check_equal(recs.column<2>(), {"one", "two", "three"}));
+
+        auto [i, d, s] = recs.row(1);
+        CHECK(i == 2);
+        CHECK(d == 2.0);
+        CHECK(s == "two");
+
+        std::get<2>(recs.row(1)) = "deux";
+        CHECK(recs.column<2>()[1] == "deux");
+
+        recs.pop_back();
+        CHECK(recs.size() == 2);
+
+        recs.reserve(100);
+        CHECK(recs.capacity() >= 100);
+
+        recs.resize(5);
+        CHECK(recs.size() == 5);
+        CHECK(recs.column<0>()[4] == 0);
+
+        recs.clear();
+        CHECK(recs.is_empty());
+
+        soa_vector<int, int> sized(10);
+        CHECK(sized.size() == 10);
+    }
+
+    SUBCASE("bounds checking")
+    {
+        auto recs = make_records();
+        REQUIRE_THROWS_AS(recs.row(4), flux::unrecoverable_error);
+        REQUIRE_THROWS_AS(recs.row(-1), flux::unrecoverable_error);
+    }
+
+    SUBCASE("iteration yields proxy references")
+    {
+        auto recs = make_records();
+
+        int sum = 0;
+        for (auto [i, d, s] : recs) {
+            sum += i;
+            d *= 2;
+        }
+        CHECK(sum == 10);
+        CHECK(check_equal(recs.column<1>(), {1.0, 3.0, 5.0, 7.0}));
+
+        auto names = flux::ref(recs)
+                         .filter([](auto const& row) { return std::get<0>(row) % 2 == 0; })
+                         .map([](auto const& row) { return std::get<2>(row); })
+                         .to<std::vector<std::string>>();
+        CHECK(names == std::vector<std::string>{"delta", "bravo"});
+    }
+
+    SUBCASE("columns are contiguous sequences")
+    {
+        auto recs = make_records();
+
+        CHECK(flux::sum(recs.column<0>()) == 10);
+        CHECK(recs.column<0>().data() == recs.column<0>().data());
+        CHECK(flux::contains(recs.column<2>(), "delta"));
+
+        recs.column<0>().fill(7);
+        CHECK(check_equal(recs.column<0>(), {7, 7, 7, 7}));
+    }
+
+    SUBCASE("flux::sort permutes all columns")
+    {
+        auto recs = make_records();
+
+        flux::sort(recs, flux::proj(std::compare_three_way{}, get_key));
+
+        CHECK(check_equal(recs.column<0>(), {1, 2, 3, 4}));
+        CHECK(check_equal(recs.column<1>(), {1.5, 3.5, 0.5, 2.5}));
+        CHECK(check_equal(recs.column<2>(), {"alpha", "bravo", "charlie", "delta"}));
+    }
+
+    SUBCASE("sort_by_column")
+    {
+        auto recs = make_records();
+
+        recs.sort_by_column<2>(flux::cmp::reverse_compare);
+
+        CHECK(check_equal(recs.column<2>(), {"delta", "charlie", "bravo", "alpha"}));
+        CHECK(check_equal(recs.column<0>(), {4, 3, 2, 1}));
+        CHECK(check_equal(recs.column<1>(), {2.5, 0.5, 3.5, 1.5}));
+
+        auto expected = make_records();
+        flux::sort(expected, flux::proj(std::compare_three_way{}, get_key));
+
+        recs.sort_by_column<0>();
+        CHECK(recs == expected);
+    }
+
+    SUBCASE("conversion with to()")
+    {
+        std::vector<int> ints{1, 2, 3};
+        std::vector<std::string> strs{"a", "b", "c"};
+
+        auto soa = flux::zip(flux::ref(ints), flux::ref(strs)).to<soa_vector<int, std::string>>();
+        CHECK(soa.size() == 3);
+        CHECK(check_equal(soa.column<1>(), {"a", "b", "c"}));
+
+        auto copy = soa;
+        CHECK(copy == soa);
+        copy.pop_back();
+        CHECK(copy != soa);
+    }
+}
@@ -325,6 +325,21 @@ constexpr bool test_stride_bidir()
         STATIC_CHECK(&seq[cur] == arr.data() + 6);
     }
 
+    // Internal iteration ends at last(), whether or not the stride divides
+    // the size
+    {
+        std::array arr{0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+        for (flux::distance_t n = 1; n <= 10; ++n) {
+            auto seq = flux::ref(arr).stride(n);
+
+            auto cur = seq.for_each_while([](int) { return true; });
+            STATIC_CHECK(cur == seq.last());
+            seq.dec(cur);
+            STATIC_CHECK(seq[cur] == 8 - 8 % n);
+        }
+    }
+
 
     // Can we sort a strided array?
     {
@@ -0,0 +1,169 @@
+
+// Copyright (c) 2024 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "test_utils.hpp"
+
+namespace {
+
+// Collects the elements using external iteration, so that the cursor
+// operations are checked against for_each_while()
+template <typename Seq>
+constexpr auto collect_external(Seq& seq)
+{
+    std::vector<flux::value_t<Seq>> out;
+    for (auto cur = flux::first(seq); !flux::is_last(seq, cur); flux::inc(seq, cur)) {
+        out.push_back(flux::read_at(seq, cur));
+    }
+    return out;
+}
+
+constexpr bool test_tiled_product()
+{
+    // Basic tiled_product
+    {
+        auto seq = flux::tiled_product(std::array{2, 2}, flux::ints(0, 3), flux::ints(0, 4));
+
+        using S = decltype(seq);
+
+        static_assert(flux::multipass_sequence<S>);
+        static_assert(not flux::bidirectional_sequence<S>);
+        static_assert(flux::bounded_sequence<S>);
+        static_assert(flux::sized_sequence<S>);
+
+        static_assert(flux::multipass_sequence<S const>);
+        static_assert(flux::bounded_sequence<S const>);
+        static_assert(flux::sized_sequence<S const>);
+
+        static_assert(std::same_as<flux::value_t<S>,
+                                   std::tuple<flux::distance_t, flux::distance_t>>);
+
+        STATIC_CHECK(flux::size(seq) == 12);
+
+        auto to_int = flux::unpack([](auto i, auto j) { return int(10 * i + j); });
+
+        STATIC_CHECK(check_equal(flux::ref(seq).map(to_int),
+                                 {0, 1, 10, 11, 2, 3, 12, 13, 20, 21, 22, 23}));
+
+        auto const& cseq = seq;
+        STATIC_CHECK(check_equal(flux::ref(cseq).map(to_int),
+                                 {0, 1, 10, 11, 2, 3, 12, 13, 20, 21, 22, 23}));
+
+        std::vector<int> vec;
+        flux::for_each(seq, [&](auto elem) { vec.push_back(to_int(elem)); });
+        STATIC_CHECK(check_equal(vec, {0, 1, 10, 11, 2, 3, 12, 13, 20, 21, 22, 23}));
+    }
+
+    // Tiles which don't divide the sizes are cut short
+    {
+        auto seq = flux::tiled_product(std::array{2, 3}, flux::ints(0, 3), flux::ints(0, 4));
+
+        auto to_int = flux::unpack([](auto i, auto j) { return int(10 * i + j); });
+
+        STATIC_CHECK(check_equal(flux::ref(seq).map(to_int),
+                                 {0, 1, 2, 10, 11, 12, 3, 13, 20, 21, 22, 23}));
+        STATIC_CHECK(collect_external(seq) == flux::to<std::vector>(seq));
+    }
+
+    // Tiles at least as large as the sizes, or of size one, visit the
+    // elements in the same order as cartesian_product
+    {
+        std::array arr1{1, 2, 3};
+        std::array arr2{4, 5, 6, 7, 8};
+
+        auto big = flux::tiled_product(std::array{10u, 5u}, flux::ref(arr1), flux::ref(arr2));
+        auto one = flux::tiled_product(std::array{1, 1}, flux::ref(arr1), flux::ref(arr2));
+        auto cart = flux::cartesian_product(flux::ref(arr1), flux::ref(arr2));
+
+        STATIC_CHECK(flux::equal(big, cart));
+        STATIC_CHECK(flux::equal(one, cart));
+        STATIC_CHECK(flux::to<std::vector>(big) == flux::to<std::vector>(cart));
+        STATIC_CHECK(collect_external(one) == flux::to<std::vector>(cart));
+    }
+
+    // Elements are references to the elements of the bases
+    {
+        std::array<int, 6> arr{};
+        std::array<int, 4> counts{};
+
+        auto seq = flux::tiled_product(std::array{4, 2}, flux::mut_ref(arr), flux::mut_ref(counts));
+
+        flux::for_each(seq, flux::unpack([](int& a, int& c) { ++a; ++c; }));
+
+        STATIC_CHECK(check_equal(arr, {4, 4, 4, 4, 4, 4}));
+        STATIC_CHECK(check_equal(counts, {6, 6, 6, 6}));
+    }
+
+    // An empty dimension makes the product empty
+    {
+        auto seq = flux::tiled_product(std::array{2, 2, 2}, flux::ints(0, 3), flux::ints(0, 0),
+                                       flux::ints(0, 3));
+
+        STATIC_CHECK(flux::is_empty(seq));
+        STATIC_CHECK(flux::size(seq) == 0);
+        STATIC_CHECK(flux::is_last(seq, flux::first(seq)));
+        STATIC_CHECK(flux::count(seq) == 0);
+    }
+
+    // 3D, with both internal and external iteration
+    {
+        auto seq = flux::tiled_product(std::array{2, 3, 2}, flux::ints(0, 3), flux::ints(0, 4),
+                                       flux::ints(0, 5));
+
+        STATIC_CHECK(flux::size(seq) == 60);
+        STATIC_CHECK(flux::count(seq) == 60);
+
+        auto internal = flux::to<std::vector>(seq);
+        auto external = collect_external(seq);
+        STATIC_CHECK(internal == external);
+
+        // Every point is visited once
+        auto sorted = internal;
+        std::sort(sorted.begin(), sorted.end());
+        STATIC_CHECK(flux::equal(sorted, flux::cartesian_product(flux::ints(0, 3), flux::ints(0, 4),
+                                                                 flux::ints(0, 5))));
+
+        // The first tile is visited first
+        STATIC_CHECK(check_equal(flux::take(flux::ref(internal), 13),
+                                 std::array<std::tuple<flux::distance_t, flux::distance_t,
+                                                       flux::distance_t>, 13>{{
+                                     {0, 0, 0}, {0, 0, 1}, {0, 1, 0}, {0, 1, 1}, {0, 2, 0},
+                                     {0, 2, 1}, {1, 0, 0}, {1, 0, 1}, {1, 1, 0}, {1, 1, 1},
+                                     {1, 2, 0}, {1, 2, 1}, {0, 0, 2}}}));
+    }
+
+    // Internal iteration stops early, at the right cursor
+    {
+        auto seq = flux::tiled_product(std::array{2, 2}, flux::ints(0, 3), flux::ints(0, 4));
+
+        auto cur = flux::find(seq, std::tuple<flux::distance_t, flux::distance_t>{1, 2});
+        STATIC_CHECK(!flux::is_last(seq, cur));
+        STATIC_CHECK(flux::read_at(seq, cur) == std::tuple<flux::distance_t, flux::distance_t>{1, 2});
+
+        auto next = cur;
+        flux::inc(seq, next);
+        STATIC_CHECK(flux::read_at(seq, next) == std::tuple<flux::distance_t, flux::distance_t>{1, 3});
+
+        auto missing = flux::find(seq, std::tuple<flux::distance_t, flux::distance_t>{3, 0});
+        STATIC_CHECK(flux::is_last(seq, missing));
+        STATIC_CHECK(missing == flux::last(seq));
+    }
+
+    return true;
+}
+static_assert(test_tiled_product());
+
+}
+
+TEST_CASE("tiled_product")
+{
+    bool result = test_tiled_product();
+    REQUIRE(result);
+}
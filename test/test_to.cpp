@@ -7,10 +7,13 @@
 #include <array>
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <set>
 #include <sstream>
 #include <vector>
 
+#include <flux/arena.hpp>
+
 #include "test_utils.hpp"
 
 namespace {
@@ -209,6 +212,39 @@ TEST_CASE("to")
             CHECK(check_equal(vec, {"The", "quick", "brown", "fox"}));
         }
 
+        SUBCASE("recursive to() calls propagate memory resources")
+        {
+            flux::arena arena;
+
+            std::string const str = "The quick brown fox jumps over the lazy dog";
+            auto vec = flux::split(flux::ref(str), ' ')
+                           .to<std::pmr::vector<std::pmr::string>>(&arena);
+
+            CHECK(vec.get_allocator().resource() == &arena);
+            CHECK(check_equal(vec, {"The", "quick", "brown", "fox", "jumps",
+                                    "over", "the", "lazy", "dog"}));
+            for (auto const& s : vec) {
+                CHECK(s.get_allocator().resource() == &arena);
+            }
+
+            // Doubly-nested conversion
+            std::vector<std::vector<std::vector<int>>> nested{{{1, 2}, {3}}, {}, {{4, 5, 6}}};
+            using V3 = std::pmr::vector<std::pmr::vector<std::pmr::vector<int>>>;
+            auto v3 = flux::to<V3>(nested, std::pmr::polymorphic_allocator<>(&arena));
+
+            CHECK(v3.size() == 3);
+            CHECK(v3[0][0] == std::pmr::vector<int>{1, 2});
+            CHECK(v3[2][0] == std::pmr::vector<int>{4, 5, 6});
+            CHECK(v3[0].get_allocator().resource() == &arena);
+            CHECK(v3[0][1].get_allocator().resource() == &arena);
+
+            // Inner containers with a different allocator type are unaffected
+            auto mixed = flux::split(flux::ref(str), ' ')
+                             .to<std::pmr::vector<std::string>>(&arena);
+            CHECK(mixed.size() == 9);
+            CHECK(mixed[1] == "quick");
+        }
+
         SUBCASE("from set_union adaptor")
         {
             auto union_seq = flux::set_union(std::array{1,2,3}, std::array{4,5});
@@ -175,6 +175,24 @@ constexpr bool test_zip()
         STATIC_CHECK(check_equal(vals, {100, 100, 100, 3, 4}));
     }
 
+    // Internal iteration stops at the end of the shortest sequence
+    {
+        std::array a{1, 2, 3, 4, 5};
+        std::array b{10, 20, 30};
+
+        auto seq = flux::zip(flux::ref(a), flux::ref(b));
+
+        STATIC_CHECK(seq.fold([](int sum, auto p) { return sum + p.first * p.second; }, 0)
+                         == 140);
+
+        auto cur = seq.find_if([](auto p) { return p.second == 20; });
+        STATIC_CHECK(std::get<0>(cur) == 1);
+
+        cur = seq.find_if([](auto p) { return p.second == 40; });
+        STATIC_CHECK(cur == seq.last());
+        STATIC_CHECK(seq.is_last(cur));
+    }
+
     return true;
 }
 static_assert(test_zip());